@@ -10,7 +10,11 @@ const std::vector<std::string> g_settingNames
 {
     "emulatedController", "leftHand", "rightHand", "orientation", "skeleton", "trackingLevel",
     "desktopOffset", "leftHandOffset", "leftHandOffsetRotation", "rightHandOffset", "rightHandOffsetRotation",
-    "handsReset", "interpolation", "velocity"
+    "handsReset", "interpolation", "velocity", "pollingMode", "pollingTimeout",
+    "extrapolation", "extrapolationLimit", "interpolationMode",
+    "fusion", "deviceOffset", "deviceOffsetRotation",
+    "threadPriority", "threadRealtime", "threadAffinity",
+    "trackingSource", "syntheticRate", "syntheticHands", "syntheticDevices"
 };
 
 enum ConfigSetting : size_t
@@ -28,7 +32,22 @@ enum ConfigSetting : size_t
     CS_RightHandOffsetRotation,
     CS_HandsReset,
     CS_Interpolation,
-    CS_Velocity
+    CS_Velocity,
+    CS_PollingMode,
+    CS_PollingTimeout,
+    CS_Extrapolation,
+    CS_ExtrapolationLimit,
+    CS_InterpolationMode,
+    CS_Fusion,
+    CS_DeviceOffset,
+    CS_DeviceOffsetRotation,
+    CS_ThreadPriority,
+    CS_ThreadRealtime,
+    CS_ThreadAffinity,
+    CS_TrackingSource,
+    CS_SyntheticRate,
+    CS_SyntheticHands,
+    CS_SyntheticDevices
 };
 
 const std::vector<std::string> g_orientationModes
@@ -46,6 +65,31 @@ const std::vector<std::string> g_trackingLevels
     "partial", "full"
 };
 
+const std::vector<std::string> g_pollingModes
+{
+    "sleep", "event"
+};
+
+const std::vector<std::string> g_interpolationModes
+{
+    "frame", "split"
+};
+
+const std::vector<std::string> g_fusionModes
+{
+    "none", "select", "blend"
+};
+
+const std::vector<std::string> g_threadPriorities
+{
+    "normal", "high", "highest"
+};
+
+extern const std::vector<std::string> g_trackingSources
+{
+    "leap", "synthetic"
+};
+
 unsigned char CDriverConfig::ms_emulatedController = CDriverConfig::EC_Vive;
 bool CDriverConfig::ms_leftHand = true;
 bool CDriverConfig::ms_rightHand = true;
@@ -58,13 +102,28 @@ glm::vec3 CDriverConfig::ms_rightHandOffset(0.f);
 glm::quat CDriverConfig::ms_rightHandOffsetRotation(1.f, 0.f, 0.f, 0.f);
 bool CDriverConfig::ms_handsReset = false;
 bool CDriverConfig::ms_interpolation = false;
+unsigned char CDriverConfig::ms_interpolationMode = CDriverConfig::IM_Frame;
 bool CDriverConfig::ms_useVelocity = false;
+unsigned char CDriverConfig::ms_pollingMode = CDriverConfig::PM_Sleep;
+uint32_t CDriverConfig::ms_pollingTimeout = 100U;
+bool CDriverConfig::ms_extrapolation = false;
+uint32_t CDriverConfig::ms_extrapolationLimit = 30U;
+unsigned char CDriverConfig::ms_fusionMode = CDriverConfig::FM_None;
+glm::vec3 CDriverConfig::ms_deviceOffsets[CDriverConfig::DL_Count] = { glm::vec3(0.f), glm::vec3(0.f), glm::vec3(0.f), glm::vec3(0.f) };
+unsigned char CDriverConfig::ms_threadPriority = CDriverConfig::TP_Normal;
+bool CDriverConfig::ms_threadRealtime = false;
+uint64_t CDriverConfig::ms_threadAffinity = 0U;
+unsigned char CDriverConfig::ms_trackingSource = CDriverConfig::TS_Leap;
+float CDriverConfig::ms_syntheticRate = 120.f;
+uint32_t CDriverConfig::ms_syntheticHands = 2U;
+uint32_t CDriverConfig::ms_syntheticDevices = 1U;
+glm::quat CDriverConfig::ms_deviceOffsetRotations[CDriverConfig::DL_Count] = { glm::quat(1.f, 0.f, 0.f, 0.f), glm::quat(1.f, 0.f, 0.f, 0.f), glm::quat(1.f, 0.f, 0.f, 0.f), glm::quat(1.f, 0.f, 0.f, 0.f) };
 
 void CDriverConfig::Load()
 {
     std::string l_path(g_modulePath);
-    l_path.erase(l_path.begin() + l_path.rfind('\\'), l_path.end());
-    l_path.append("\\..\\..\\resources\\settings.xml");
+    l_path.erase(l_path.begin() + l_path.find_last_of("\\/"), l_path.end());
+    l_path.append("/../../resources/settings.xml");
 
     pugi::xml_document *l_document = new pugi::xml_document();
     if(l_document->load_file(l_path.c_str()))
@@ -136,6 +195,72 @@ void CDriverConfig::Load()
                         case ConfigSetting::CS_Velocity:
                             ms_useVelocity = l_attribValue.as_bool(false);
                             break;
+                        case ConfigSetting::CS_PollingMode:
+                        {
+                            const size_t l_tableIndex = ReadEnumVector(l_attribValue.as_string(), g_pollingModes);
+                            if(l_tableIndex != std::numeric_limits<size_t>::max()) ms_pollingMode = static_cast<unsigned char>(l_tableIndex);
+                        } break;
+                        case ConfigSetting::CS_PollingTimeout:
+                            ms_pollingTimeout = glm::clamp(l_attribValue.as_uint(100U), 1U, 1000U);
+                            break;
+                        case ConfigSetting::CS_Extrapolation:
+                            ms_extrapolation = l_attribValue.as_bool(false);
+                            break;
+                        case ConfigSetting::CS_ExtrapolationLimit:
+                            ms_extrapolationLimit = glm::clamp(l_attribValue.as_uint(30U), 0U, 100U);
+                            break;
+                        case ConfigSetting::CS_InterpolationMode:
+                        {
+                            const size_t l_tableIndex = ReadEnumVector(l_attribValue.as_string(), g_interpolationModes);
+                            if(l_tableIndex != std::numeric_limits<size_t>::max()) ms_interpolationMode = static_cast<unsigned char>(l_tableIndex);
+                        } break;
+                        case ConfigSetting::CS_Fusion:
+                        {
+                            const size_t l_tableIndex = ReadEnumVector(l_attribValue.as_string(), g_fusionModes);
+                            if(l_tableIndex != std::numeric_limits<size_t>::max()) ms_fusionMode = static_cast<unsigned char>(l_tableIndex);
+                        } break;
+                        case ConfigSetting::CS_DeviceOffset:
+                        {
+                            // Device index goes first, first device is reference
+                            std::stringstream l_deviceOffset(l_attribValue.as_string());
+                            size_t l_device = 0U;
+                            glm::vec3 l_offset(0.f);
+                            l_deviceOffset >> l_device >> l_offset.x >> l_offset.y >> l_offset.z;
+                            if(!l_deviceOffset.fail() && (l_device > 0U) && (l_device < DL_Count)) ms_deviceOffsets[l_device] = l_offset;
+                        } break;
+                        case ConfigSetting::CS_DeviceOffsetRotation:
+                        {
+                            std::stringstream l_deviceOffsetRotation(l_attribValue.as_string());
+                            size_t l_device = 0U;
+                            glm::quat l_rotation(1.f, 0.f, 0.f, 0.f);
+                            l_deviceOffsetRotation >> l_device >> l_rotation.x >> l_rotation.y >> l_rotation.z >> l_rotation.w;
+                            if(!l_deviceOffsetRotation.fail() && (l_device > 0U) && (l_device < DL_Count)) ms_deviceOffsetRotations[l_device] = l_rotation;
+                        } break;
+                        case ConfigSetting::CS_ThreadPriority:
+                        {
+                            const size_t l_tableIndex = ReadEnumVector(l_attribValue.as_string(), g_threadPriorities);
+                            if(l_tableIndex != std::numeric_limits<size_t>::max()) ms_threadPriority = static_cast<unsigned char>(l_tableIndex);
+                        } break;
+                        case ConfigSetting::CS_ThreadRealtime:
+                            ms_threadRealtime = l_attribValue.as_bool(false);
+                            break;
+                        case ConfigSetting::CS_ThreadAffinity:
+                            ms_threadAffinity = l_attribValue.as_ullong(0U);
+                            break;
+                        case ConfigSetting::CS_TrackingSource:
+                        {
+                            const size_t l_tableIndex = ReadEnumVector(l_attribValue.as_string(), g_trackingSources);
+                            if(l_tableIndex != std::numeric_limits<size_t>::max()) ms_trackingSource = static_cast<unsigned char>(l_tableIndex);
+                        } break;
+                        case ConfigSetting::CS_SyntheticRate:
+                            ms_syntheticRate = glm::clamp(l_attribValue.as_float(120.f), 1.f, 1000.f);
+                            break;
+                        case ConfigSetting::CS_SyntheticHands:
+                            ms_syntheticHands = glm::clamp(l_attribValue.as_uint(2U), 0U, 4U);
+                            break;
+                        case ConfigSetting::CS_SyntheticDevices:
+                            ms_syntheticDevices = glm::clamp(l_attribValue.as_uint(1U), 1U, static_cast<uint32_t>(DL_Count));
+                            break;
                     }
                 }
             }
@@ -164,6 +289,11 @@ unsigned char CDriverConfig::GetOrientationMode()
     return ms_orientation;
 }
 
+void CDriverConfig::SetOrientationMode(unsigned char f_mode)
+{
+    if(f_mode <= OM_Desktop) ms_orientation = f_mode;
+}
+
 unsigned char CDriverConfig::GetTrackingLevel()
 {
     return ms_trackingLevel;
@@ -204,7 +334,82 @@ bool CDriverConfig::IsInterpolationEnabled()
     return ms_interpolation;
 }
 
+unsigned char CDriverConfig::GetInterpolationMode()
+{
+    return ms_interpolationMode;
+}
+
 bool CDriverConfig::IsVelocityUsed()
 {
     return ms_useVelocity;
 }
+
+unsigned char CDriverConfig::GetPollingMode()
+{
+    return ms_pollingMode;
+}
+
+uint32_t CDriverConfig::GetPollingTimeout()
+{
+    return ms_pollingTimeout;
+}
+
+bool CDriverConfig::IsExtrapolationEnabled()
+{
+    return ms_extrapolation;
+}
+
+uint32_t CDriverConfig::GetExtrapolationLimit()
+{
+    return ms_extrapolationLimit;
+}
+
+unsigned char CDriverConfig::GetFusionMode()
+{
+    return ms_fusionMode;
+}
+
+const glm::vec3& CDriverConfig::GetDeviceOffset(size_t f_device)
+{
+    return ms_deviceOffsets[(f_device < DL_Count) ? f_device : 0U];
+}
+
+const glm::quat& CDriverConfig::GetDeviceOffsetRotation(size_t f_device)
+{
+    return ms_deviceOffsetRotations[(f_device < DL_Count) ? f_device : 0U];
+}
+
+unsigned char CDriverConfig::GetThreadPriority()
+{
+    return ms_threadPriority;
+}
+
+bool CDriverConfig::IsThreadRealtime()
+{
+    return ms_threadRealtime;
+}
+
+uint64_t CDriverConfig::GetThreadAffinity()
+{
+    return ms_threadAffinity;
+}
+
+unsigned char CDriverConfig::GetTrackingSource()
+{
+    return ms_trackingSource;
+}
+
+float CDriverConfig::GetSyntheticRate()
+{
+    return ms_syntheticRate;
+}
+
+uint32_t CDriverConfig::GetSyntheticHands()
+{
+    return ms_syntheticHands;
+}
+
+uint32_t CDriverConfig::GetSyntheticDevices()
+{
+    return ms_syntheticDevices;
+}
@@ -14,7 +14,22 @@ class CDriverConfig final
     static glm::quat ms_rightHandOffsetRotation;
     static bool ms_handsReset;
     static bool ms_interpolation;
+    static unsigned char ms_interpolationMode;
     static bool ms_useVelocity;
+    static unsigned char ms_pollingMode;
+    static uint32_t ms_pollingTimeout;
+    static bool ms_extrapolation;
+    static uint32_t ms_extrapolationLimit;
+    static unsigned char ms_fusionMode;
+    static glm::vec3 ms_deviceOffsets[];
+    static glm::quat ms_deviceOffsetRotations[];
+    static unsigned char ms_threadPriority;
+    static bool ms_threadRealtime;
+    static uint64_t ms_threadAffinity;
+    static unsigned char ms_trackingSource;
+    static float ms_syntheticRate;
+    static uint32_t ms_syntheticHands;
+    static uint32_t ms_syntheticDevices;
 
     CDriverConfig() = delete;
     ~CDriverConfig() = delete;
@@ -37,6 +52,37 @@ public:
         TL_Partial = 0U,
         TL_Full
     };
+    enum PollingMode : unsigned char
+    {
+        PM_Sleep = 0U,
+        PM_Event
+    };
+    enum InterpolationMode : unsigned char
+    {
+        IM_Frame = 0U,
+        IM_Split
+    };
+    enum FusionMode : unsigned char
+    {
+        FM_None = 0U,
+        FM_Select,
+        FM_Blend
+    };
+    enum DeviceLimit : size_t
+    {
+        DL_Count = 4U
+    };
+    enum ThreadPriority : unsigned char
+    {
+        TP_Normal = 0U,
+        TP_High,
+        TP_Highest
+    };
+    enum TrackingSource : unsigned char
+    {
+        TS_Leap = 0U,
+        TS_Synthetic
+    };
 
     static void Load();
 
@@ -44,6 +90,8 @@ public:
     static bool IsLeftHandEnabled();
     static bool IsRightHandEnabled();
     static unsigned char GetOrientationMode();
+    // Overrides loaded value until next load
+    static void SetOrientationMode(unsigned char f_mode);
     static unsigned char GetTrackingLevel();
 
     static const glm::vec3& GetDesktopOffset();
@@ -54,5 +102,25 @@ public:
 
     static bool IsHandsResetEnabled();
     static bool IsInterpolationEnabled();
+    static unsigned char GetInterpolationMode();
     static bool IsVelocityUsed();
+
+    static unsigned char GetPollingMode();
+    static uint32_t GetPollingTimeout();
+
+    static bool IsExtrapolationEnabled();
+    static uint32_t GetExtrapolationLimit();
+
+    static unsigned char GetFusionMode();
+    static const glm::vec3& GetDeviceOffset(size_t f_device);
+    static const glm::quat& GetDeviceOffsetRotation(size_t f_device);
+
+    static unsigned char GetThreadPriority();
+    static bool IsThreadRealtime();
+    static uint64_t GetThreadAffinity();
+
+    static unsigned char GetTrackingSource();
+    static float GetSyntheticRate();
+    static uint32_t GetSyntheticHands();
+    static uint32_t GetSyntheticDevices();
 };
@@ -0,0 +1,275 @@
+#include "stdafx.h"
+
+#include "Core/CFrameCodec.h"
+
+// Steps of 0.1 mm for positions and widths, 1 mm/s for velocity, 1/4096 for unit vectors and rotations, 1/1024 for strengths and angles
+const float g_positionScale = 10.f;
+const float g_velocityScale = 1.f;
+const float g_directionScale = 4096.f;
+const float g_scalarScale = 1024.f;
+
+void CFrameCodec::QuantizeHand(const LEAP_HAND &f_hand, int64_t *f_channels)
+{
+    size_t l_channel = 0U;
+    f_channels[l_channel++] = f_hand.flags;
+    f_channels[l_channel++] = f_hand.type;
+    f_channels[l_channel++] = static_cast<int64_t>(f_hand.visible_time);
+    f_channels[l_channel++] = Quantize(f_hand.confidence, g_scalarScale);
+    f_channels[l_channel++] = Quantize(f_hand.pinch_distance, g_positionScale);
+    f_channels[l_channel++] = Quantize(f_hand.grab_angle, g_scalarScale);
+    f_channels[l_channel++] = Quantize(f_hand.pinch_strength, g_scalarScale);
+    f_channels[l_channel++] = Quantize(f_hand.grab_strength, g_scalarScale);
+
+    QuantizeVector(f_hand.palm.position, g_positionScale, f_channels, l_channel);
+    QuantizeVector(f_hand.palm.stabilized_position, g_positionScale, f_channels, l_channel);
+    for(size_t i = 0U; i < 3U; i++) f_channels[CL_PalmStabilized + i] -= f_channels[CL_PalmPosition + i];
+    QuantizeVector(f_hand.palm.velocity, g_velocityScale, f_channels, l_channel);
+    QuantizeVector(f_hand.palm.normal, g_directionScale, f_channels, l_channel);
+    f_channels[l_channel++] = Quantize(f_hand.palm.width, g_positionScale);
+    QuantizeVector(f_hand.palm.direction, g_directionScale, f_channels, l_channel);
+    QuantizeQuaternion(f_hand.palm.orientation, f_channels, l_channel);
+
+    for(size_t i = 0U; i < 5U; i++)
+    {
+        const LEAP_DIGIT &l_digit = f_hand.digits[i];
+        f_channels[l_channel++] = l_digit.finger_id;
+        f_channels[l_channel++] = l_digit.is_extended;
+        for(size_t j = 0U; j < 4U; j++) QuantizeBone(l_digit.bones[j], (j > 0U) ? &l_digit.bones[j - 1U].next_joint : nullptr, f_channels, l_channel);
+    }
+    QuantizeBone(f_hand.arm, nullptr, f_channels, l_channel);
+}
+
+void CFrameCodec::DequantizeHand(const int64_t *f_channels, uint32_t f_id, LEAP_HAND &f_hand)
+{
+    std::memset(&f_hand, 0, sizeof(LEAP_HAND));
+    f_hand.id = f_id;
+
+    size_t l_channel = 0U;
+    f_hand.flags = static_cast<uint32_t>(f_channels[l_channel++]);
+    f_hand.type = static_cast<eLeapHandType>(f_channels[l_channel++]);
+    f_hand.visible_time = static_cast<uint64_t>(f_channels[l_channel++]);
+    f_hand.confidence = Dequantize(f_channels[l_channel++], g_scalarScale);
+    f_hand.pinch_distance = Dequantize(f_channels[l_channel++], g_positionScale);
+    f_hand.grab_angle = Dequantize(f_channels[l_channel++], g_scalarScale);
+    f_hand.pinch_strength = Dequantize(f_channels[l_channel++], g_scalarScale);
+    f_hand.grab_strength = Dequantize(f_channels[l_channel++], g_scalarScale);
+
+    DequantizeVector(f_channels, l_channel, g_positionScale, f_hand.palm.position);
+    for(size_t i = 0U; i < 3U; i++) f_hand.palm.stabilized_position.v[i] = Dequantize(f_channels[l_channel++] + f_channels[CL_PalmPosition + i], g_positionScale);
+    DequantizeVector(f_channels, l_channel, g_velocityScale, f_hand.palm.velocity);
+    DequantizeVector(f_channels, l_channel, g_directionScale, f_hand.palm.normal);
+    f_hand.palm.width = Dequantize(f_channels[l_channel++], g_positionScale);
+    DequantizeVector(f_channels, l_channel, g_directionScale, f_hand.palm.direction);
+    DequantizeQuaternion(f_channels, l_channel, f_hand.palm.orientation);
+
+    for(size_t i = 0U; i < 5U; i++)
+    {
+        LEAP_DIGIT &l_digit = f_hand.digits[i];
+        l_digit.finger_id = static_cast<int32_t>(f_channels[l_channel++]);
+        l_digit.is_extended = static_cast<uint32_t>(f_channels[l_channel++]);
+        for(size_t j = 0U; j < 4U; j++) DequantizeBone(f_channels, l_channel, (j > 0U) ? &l_digit.bones[j - 1U].next_joint : nullptr, l_digit.bones[j]);
+    }
+    DequantizeBone(f_channels, l_channel, nullptr, f_hand.arm);
+}
+
+int64_t CFrameCodec::Predict(int64_t f_previous, int64_t f_older, uint32_t f_depth)
+{
+    int64_t l_result = 0;
+    if(f_depth > 1U) l_result = f_previous * 2 - f_older;
+    else if(f_depth == 1U) l_result = f_previous;
+    return l_result;
+}
+
+const int64_t* CFrameCodec::FindHand(const uint32_t *f_ids, const int64_t *f_channels, uint32_t f_count, uint32_t f_id)
+{
+    const int64_t *l_result = nullptr;
+    for(uint32_t i = 0U; i < f_count; i++)
+    {
+        if(f_ids[i] == f_id)
+        {
+            l_result = f_channels + i * CL_ChannelsCount;
+            break;
+        }
+    }
+    return l_result;
+}
+
+void CFrameCodec::PredictHand(const int64_t *f_previous, const int64_t *f_older, int64_t *f_prediction)
+{
+    const uint32_t l_depth = (f_previous ? (f_older ? 2U : 1U) : 0U);
+    for(size_t i = 0U; i < CL_ChannelsCount; i++) f_prediction[i] = Predict(f_previous ? f_previous[i] : 0, f_older ? f_older[i] : 0, l_depth);
+
+    // Discrete values would overshoot on change
+    const uint32_t l_discreteDepth = std::min(l_depth, 1U);
+    for(size_t i = 0U; i < 2U; i++) f_prediction[i] = Predict(f_previous ? f_previous[i] : 0, 0, l_discreteDepth);
+    for(size_t i = 0U; i < 5U; i++)
+    {
+        const size_t l_channel = CL_Digits + i * CL_DigitChannels;
+        for(size_t j = l_channel; j < (l_channel + 2U); j++) f_prediction[j] = Predict(f_previous ? f_previous[j] : 0, 0, l_discreteDepth);
+    }
+}
+
+void CFrameCodec::PredictVelocity(const int64_t *f_channels, const int64_t *f_previous, int64_t f_interval, int64_t *f_prediction)
+{
+    if(f_previous && (f_interval > 0))
+    {
+        // Position steps per microsecond to velocity steps per second
+        const double l_factor = static_cast<double>(g_velocityScale) / static_cast<double>(g_positionScale) * 1000000.0 / static_cast<double>(f_interval);
+        for(size_t i = 0U; i < 3U; i++) f_prediction[CL_PalmVelocity + i] = static_cast<int64_t>(std::llround(static_cast<double>(f_channels[CL_PalmPosition + i] - f_previous[CL_PalmPosition + i]) * l_factor));
+    }
+}
+
+void CFrameCodec::WriteVarint(std::vector<uint8_t> &f_buffer, uint64_t f_value)
+{
+    while(f_value >= 0x80U)
+    {
+        f_buffer.push_back(static_cast<uint8_t>(f_value | 0x80U));
+        f_value >>= 7U;
+    }
+    f_buffer.push_back(static_cast<uint8_t>(f_value));
+}
+
+bool CFrameCodec::ReadVarint(const uint8_t *f_data, size_t f_size, size_t &f_offset, uint64_t &f_value)
+{
+    bool l_result = false;
+    f_value = 0U;
+    for(uint32_t l_shift = 0U; (l_shift < 64U) && (f_offset < f_size); l_shift += 7U)
+    {
+        const uint8_t l_byte = f_data[f_offset++];
+        f_value |= (static_cast<uint64_t>(l_byte & 0x7FU) << l_shift);
+        if(!(l_byte & 0x80U))
+        {
+            l_result = true;
+            break;
+        }
+    }
+    return l_result;
+}
+
+// Exp-Golomb code of zigzag residual, zero takes one bit and residuals of one step take three bits
+void CFrameCodec::WriteResiduals(std::vector<uint8_t> &f_buffer, const int64_t *f_residuals, size_t f_count)
+{
+    const size_t l_start = f_buffer.size();
+    size_t l_bit = 0U;
+    for(size_t i = 0U; i < f_count; i++)
+    {
+        const uint64_t l_value = EncodeZigzag(f_residuals[i]) + 1U;
+        uint32_t l_length = 0U;
+        while((l_value >> l_length) > 1U) l_length++;
+
+        // Prefix of zeros is skipped, buffer is extended with zero bytes
+        l_bit += l_length;
+        for(uint32_t j = l_length + 1U; j > 0U; j--)
+        {
+            while((l_bit >> 3U) >= (f_buffer.size() - l_start)) f_buffer.push_back(0U);
+            if((l_value >> (j - 1U)) & 1U) f_buffer[l_start + (l_bit >> 3U)] |= static_cast<uint8_t>(0x80U >> (l_bit & 7U));
+            l_bit++;
+        }
+    }
+}
+
+bool CFrameCodec::ReadResiduals(const uint8_t *f_data, size_t f_size, size_t &f_offset, int64_t *f_residuals, size_t f_count)
+{
+    bool l_result = (f_offset <= f_size);
+    const size_t l_bitsCount = (l_result ? ((f_size - f_offset) * 8U) : 0U);
+    size_t l_bit = 0U;
+    for(size_t i = 0U; l_result && (i < f_count); i++)
+    {
+        uint32_t l_length = 0U;
+        while((l_bit < l_bitsCount) && (l_length < 64U) && !ReadBit(f_data + f_offset, l_bit))
+        {
+            l_length++;
+            l_bit++;
+        }
+        l_result = ((l_length < 64U) && ((l_bit + l_length) < l_bitsCount));
+        if(l_result)
+        {
+            uint64_t l_value = 0U;
+            for(uint32_t j = 0U; j <= l_length; j++) l_value = ((l_value << 1U) | ReadBit(f_data + f_offset, l_bit++));
+            f_residuals[i] = DecodeZigzag(l_value - 1U);
+        }
+    }
+    if(l_result) f_offset += ((l_bit + 7U) >> 3U);
+    return l_result;
+}
+
+uint64_t CFrameCodec::EncodeZigzag(int64_t f_value)
+{
+    return ((static_cast<uint64_t>(f_value) << 1U) ^ static_cast<uint64_t>(f_value >> 63U));
+}
+
+int64_t CFrameCodec::DecodeZigzag(uint64_t f_value)
+{
+    return static_cast<int64_t>(f_value >> 1U) ^ -static_cast<int64_t>(f_value & 1U);
+}
+
+void CFrameCodec::QuantizeBone(const LEAP_BONE &f_bone, const LEAP_VECTOR *f_prediction, int64_t *f_channels, size_t &f_channel)
+{
+    QuantizeVector(f_bone.prev_joint, g_positionScale, f_channels, f_channel);
+    if(f_prediction)
+    {
+        for(size_t i = 0U; i < 3U; i++) f_channels[f_channel - 3U + i] -= Quantize(f_prediction->v[i], g_positionScale);
+    }
+    QuantizeVector(f_bone.next_joint, g_positionScale, f_channels, f_channel);
+    f_channels[f_channel++] = Quantize(f_bone.width, g_positionScale);
+    QuantizeQuaternion(f_bone.rotation, f_channels, f_channel);
+}
+
+void CFrameCodec::DequantizeBone(const int64_t *f_channels, size_t &f_channel, const LEAP_VECTOR *f_prediction, LEAP_BONE &f_bone)
+{
+    for(size_t i = 0U; i < 3U; i++)
+    {
+        int64_t l_value = f_channels[f_channel++];
+        if(f_prediction) l_value += Quantize(f_prediction->v[i], g_positionScale);
+        f_bone.prev_joint.v[i] = Dequantize(l_value, g_positionScale);
+    }
+    DequantizeVector(f_channels, f_channel, g_positionScale, f_bone.next_joint);
+    f_bone.width = Dequantize(f_channels[f_channel++], g_positionScale);
+    DequantizeQuaternion(f_channels, f_channel, f_bone.rotation);
+}
+
+void CFrameCodec::QuantizeVector(const LEAP_VECTOR &f_vector, float f_scale, int64_t *f_channels, size_t &f_channel)
+{
+    for(size_t i = 0U; i < 3U; i++) f_channels[f_channel++] = Quantize(f_vector.v[i], f_scale);
+}
+
+void CFrameCodec::DequantizeVector(const int64_t *f_channels, size_t &f_channel, float f_scale, LEAP_VECTOR &f_vector)
+{
+    for(size_t i = 0U; i < 3U; i++) f_vector.v[i] = Dequantize(f_channels[f_channel++], f_scale);
+}
+
+void CFrameCodec::QuantizeQuaternion(const LEAP_QUATERNION &f_quat, int64_t *f_channels, size_t &f_channel)
+{
+    // Sign is kept, hemisphere flip would break delta of neighbour frames
+    for(size_t i = 0U; i < 4U; i++) f_channels[f_channel++] = Quantize(f_quat.v[i], g_directionScale);
+}
+
+void CFrameCodec::DequantizeQuaternion(const int64_t *f_channels, size_t &f_channel, LEAP_QUATERNION &f_quat)
+{
+    float l_length = 0.f;
+    for(size_t i = 0U; i < 4U; i++)
+    {
+        f_quat.v[i] = Dequantize(f_channels[f_channel++], g_directionScale);
+        l_length += f_quat.v[i] * f_quat.v[i];
+    }
+    if(l_length > 0.f)
+    {
+        l_length = std::sqrt(l_length);
+        for(size_t i = 0U; i < 4U; i++) f_quat.v[i] /= l_length;
+    }
+}
+
+uint64_t CFrameCodec::ReadBit(const uint8_t *f_data, size_t f_bit)
+{
+    return ((f_data[f_bit >> 3U] >> (7U - (f_bit & 7U))) & 1U);
+}
+
+int64_t CFrameCodec::Quantize(float f_value, float f_scale)
+{
+    return static_cast<int64_t>(std::llround(static_cast<double>(f_value) * f_scale));
+}
+
+float CFrameCodec::Dequantize(int64_t f_value, float f_scale)
+{
+    return static_cast<float>(static_cast<double>(f_value) / f_scale);
+}
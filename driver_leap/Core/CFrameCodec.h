@@ -0,0 +1,51 @@
+#pragma once
+
+// Quantized channel layout of LEAP_HAND and residual coding shared by CFrameEncoder and CFrameDecoder
+class CFrameCodec final
+{
+    static void QuantizeBone(const LEAP_BONE &f_bone, const LEAP_VECTOR *f_prediction, int64_t *f_channels, size_t &f_channel);
+    static void DequantizeBone(const int64_t *f_channels, size_t &f_channel, const LEAP_VECTOR *f_prediction, LEAP_BONE &f_bone);
+    static void QuantizeVector(const LEAP_VECTOR &f_vector, float f_scale, int64_t *f_channels, size_t &f_channel);
+    static void DequantizeVector(const int64_t *f_channels, size_t &f_channel, float f_scale, LEAP_VECTOR &f_vector);
+    static void QuantizeQuaternion(const LEAP_QUATERNION &f_quat, int64_t *f_channels, size_t &f_channel);
+    static void DequantizeQuaternion(const int64_t *f_channels, size_t &f_channel, LEAP_QUATERNION &f_quat);
+    static uint64_t ReadBit(const uint8_t *f_data, size_t f_bit);
+    static int64_t Quantize(float f_value, float f_scale);
+    static float Dequantize(int64_t f_value, float f_scale);
+public:
+    // Channels per hand: header, scalars, palm, five digits of finger id, extension and four bones, arm bone
+    enum CodecLayout : size_t
+    {
+        CL_PalmPosition = 8U,
+        CL_PalmStabilized = 11U,
+        CL_PalmVelocity = 14U,
+        CL_Digits = 28U,
+        CL_BoneChannels = 11U,
+        CL_DigitChannels = 2U + CL_BoneChannels * 4U,
+        CL_ChannelsCount = 8U + 20U + CL_DigitChannels * 5U + CL_BoneChannels
+    };
+    enum FrameFlag : uint8_t
+    {
+        FF_Keyframe = 0x01U
+    };
+
+    // Previous bone end predicts start of next bone within digit, palm position predicts stabilized position
+    static void QuantizeHand(const LEAP_HAND &f_hand, int64_t *f_channels);
+    static void DequantizeHand(const int64_t *f_channels, uint32_t f_id, LEAP_HAND &f_hand);
+
+    // Linear extrapolation from two previous frames, previous value with one frame and zero without any.
+    // Flags, hand type, finger ids and extension aren't extrapolated.
+    static int64_t Predict(int64_t f_previous, int64_t f_older, uint32_t f_depth);
+    static const int64_t* FindHand(const uint32_t *f_ids, const int64_t *f_channels, uint32_t f_count, uint32_t f_id);
+    static void PredictHand(const int64_t *f_previous, const int64_t *f_older, int64_t *f_prediction);
+    // Palm velocity is predicted from palm movement since previous frame, current palm position has to be known
+    static void PredictVelocity(const int64_t *f_channels, const int64_t *f_previous, int64_t f_interval, int64_t *f_prediction);
+
+    // Zigzag varints for frame header, residuals of hand are bit packed and padded to whole byte
+    static void WriteVarint(std::vector<uint8_t> &f_buffer, uint64_t f_value);
+    static bool ReadVarint(const uint8_t *f_data, size_t f_size, size_t &f_offset, uint64_t &f_value);
+    static void WriteResiduals(std::vector<uint8_t> &f_buffer, const int64_t *f_residuals, size_t f_count);
+    static bool ReadResiduals(const uint8_t *f_data, size_t f_size, size_t &f_offset, int64_t *f_residuals, size_t f_count);
+    static uint64_t EncodeZigzag(int64_t f_value);
+    static int64_t DecodeZigzag(uint64_t f_value);
+};
@@ -0,0 +1,128 @@
+#include "stdafx.h"
+
+#include "Core/CFrameContinuity.h"
+#include "Utils/CHistogram.h"
+
+CFrameContinuity::CFrameContinuity()
+{
+    m_intervalHistogram = new CHistogram(250, 400U); // Up to 100 ms
+    Reset();
+}
+
+CFrameContinuity::~CFrameContinuity()
+{
+    delete m_intervalHistogram;
+}
+
+void CFrameContinuity::Add(const LEAP_TRACKING_EVENT *f_event, int64_t f_now)
+{
+    // Cleared frames carry no timestamp
+    if(f_event->info.timestamp > 0)
+    {
+        const int64_t l_frameId = f_event->tracking_frame_id;
+        if(l_frameId == m_lastFrameId) m_duplicatesCount++;
+        else
+        {
+            if(m_lastFrameId >= 0)
+            {
+                if(l_frameId > m_lastFrameId)
+                {
+                    m_skippedCount += static_cast<uint64_t>(l_frameId - m_lastFrameId - 1);
+                    if(f_event->info.timestamp > m_lastTimestamp) m_intervalHistogram->Add(f_event->info.timestamp - m_lastTimestamp);
+                }
+                else m_restartsCount++; // Service restart or switch of streaming device
+            }
+
+            m_framesCount++;
+            m_framesWindow++;
+            m_framerateSum += f_event->framerate;
+            m_lastFrameId = l_frameId;
+            m_lastTimestamp = f_event->info.timestamp;
+        }
+    }
+    UpdateWindow(f_now);
+}
+
+void CFrameContinuity::Reset()
+{
+    m_lastFrameId = -1;
+    m_lastTimestamp = 0;
+
+    m_windowStart = 0;
+    m_framesWindow = 0U;
+    m_framerateSum = 0.f;
+    m_intervalHistogram->Reset();
+
+    m_framesCount = 0U;
+    m_duplicatesCount = 0U;
+    m_skippedCount = 0U;
+    m_restartsCount = 0U;
+    m_effectiveFramerate = 0.f;
+    m_reportedFramerate = 0.f;
+    m_intervalAverage = 0;
+    m_intervalP99 = 0;
+    m_intervalMax = 0;
+}
+
+uint64_t CFrameContinuity::GetFramesCount() const
+{
+    return m_framesCount;
+}
+
+uint64_t CFrameContinuity::GetDuplicatesCount() const
+{
+    return m_duplicatesCount;
+}
+
+uint64_t CFrameContinuity::GetSkippedCount() const
+{
+    return m_skippedCount;
+}
+
+uint64_t CFrameContinuity::GetRestartsCount() const
+{
+    return m_restartsCount;
+}
+
+float CFrameContinuity::GetEffectiveFramerate() const
+{
+    return m_effectiveFramerate;
+}
+
+float CFrameContinuity::GetReportedFramerate() const
+{
+    return m_reportedFramerate;
+}
+
+int64_t CFrameContinuity::GetIntervalAverage() const
+{
+    return m_intervalAverage;
+}
+
+int64_t CFrameContinuity::GetIntervalP99() const
+{
+    return m_intervalP99;
+}
+
+int64_t CFrameContinuity::GetIntervalMax() const
+{
+    return m_intervalMax;
+}
+
+void CFrameContinuity::UpdateWindow(int64_t f_now)
+{
+    if(m_windowStart == 0) m_windowStart = f_now;
+    else if((f_now - m_windowStart) >= 1000000)
+    {
+        m_effectiveFramerate = static_cast<float>(m_framesWindow) * 1000000.f / static_cast<float>(f_now - m_windowStart);
+        m_reportedFramerate = ((m_framesWindow > 0U) ? (m_framerateSum / static_cast<float>(m_framesWindow)) : 0.f);
+        m_intervalAverage = m_intervalHistogram->GetAverage();
+        m_intervalP99 = m_intervalHistogram->GetPercentile(99.f);
+        m_intervalMax = m_intervalHistogram->GetMax();
+        m_intervalHistogram->Reset();
+
+        m_framesWindow = 0U;
+        m_framerateSum = 0.f;
+        m_windowStart = f_now;
+    }
+}
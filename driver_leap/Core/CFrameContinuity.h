@@ -0,0 +1,50 @@
+#pragma once
+
+class CHistogram;
+
+// Counts duplicated, skipped and restarted tracking frame identifiers of consecutive events
+class CFrameContinuity final
+{
+    int64_t m_lastFrameId;
+    int64_t m_lastTimestamp;
+
+    int64_t m_windowStart;
+    uint32_t m_framesWindow;
+    float m_framerateSum;
+    CHistogram *m_intervalHistogram;
+
+    std::atomic<uint64_t> m_framesCount;
+    std::atomic<uint64_t> m_duplicatesCount;
+    std::atomic<uint64_t> m_skippedCount;
+    std::atomic<uint64_t> m_restartsCount;
+    std::atomic<float> m_effectiveFramerate;
+    std::atomic<float> m_reportedFramerate;
+    std::atomic<int64_t> m_intervalAverage;
+    std::atomic<int64_t> m_intervalP99;
+    std::atomic<int64_t> m_intervalMax;
+
+    CFrameContinuity(const CFrameContinuity &that) = delete;
+    CFrameContinuity& operator=(const CFrameContinuity &that) = delete;
+
+    void UpdateWindow(int64_t f_now);
+public:
+    CFrameContinuity();
+    ~CFrameContinuity();
+
+    // Call from single thread for each received or submitted event, time is Leap clock in microseconds
+    void Add(const LEAP_TRACKING_EVENT *f_event, int64_t f_now);
+    void Reset();
+
+    // Totals since reset
+    uint64_t GetFramesCount() const;
+    uint64_t GetDuplicatesCount() const;
+    uint64_t GetSkippedCount() const;
+    uint64_t GetRestartsCount() const;
+
+    // Measured over last second, intervals between timestamps of new frames in microseconds
+    float GetEffectiveFramerate() const;
+    float GetReportedFramerate() const;
+    int64_t GetIntervalAverage() const;
+    int64_t GetIntervalP99() const;
+    int64_t GetIntervalMax() const;
+};
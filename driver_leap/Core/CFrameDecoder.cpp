@@ -0,0 +1,144 @@
+#include "stdafx.h"
+
+#include "Core/CFrameDecoder.h"
+#include "Core/CFrameCodec.h"
+#include "Core/CLeapFrame.h"
+
+const float g_framerateScale = 100.f;
+
+CFrameDecoder::CFrameDecoder()
+{
+    m_handIds = new uint32_t[CLeapFrame::GetHandsLimit()];
+    m_handChannels = new int64_t[CLeapFrame::GetHandsLimit() * CFrameCodec::CL_ChannelsCount];
+    m_olderIds = new uint32_t[CLeapFrame::GetHandsLimit()];
+    m_olderChannels = new int64_t[CLeapFrame::GetHandsLimit() * CFrameCodec::CL_ChannelsCount];
+    m_channels = new int64_t[CLeapFrame::GetHandsLimit() * CFrameCodec::CL_ChannelsCount];
+    m_prediction = new int64_t[CFrameCodec::CL_ChannelsCount];
+    m_hands = new LEAP_HAND[CLeapFrame::GetHandsLimit()];
+    Reset();
+}
+
+CFrameDecoder::~CFrameDecoder()
+{
+    delete[]m_handIds;
+    delete[]m_handChannels;
+    delete[]m_olderIds;
+    delete[]m_olderChannels;
+    delete[]m_channels;
+    delete[]m_prediction;
+    delete[]m_hands;
+}
+
+void CFrameDecoder::Reset()
+{
+    m_synchronized = false;
+    m_depth = 0U;
+    for(size_t i = 0U; i < 5U; i++) m_previousHeader[i] = m_olderHeader[i] = 0;
+    m_handsCount = 0U;
+    m_olderCount = 0U;
+}
+
+bool CFrameDecoder::Decode(const uint8_t *f_data, size_t f_size, CLeapFrame &f_frame, int64_t &f_hostTime)
+{
+    bool l_result = false;
+    if(f_size > 0U)
+    {
+        if(f_data[0U] & CFrameCodec::FF_Keyframe)
+        {
+            m_depth = 0U;
+            m_handsCount = 0U;
+            m_olderCount = 0U;
+            m_synchronized = true;
+        }
+        l_result = m_synchronized;
+    }
+
+    size_t l_offset = 1U;
+    int64_t l_header[5U] = { 0 };
+    for(size_t i = 0U; l_result && (i < 5U); i++)
+    {
+        uint64_t l_value = 0U;
+        l_result = CFrameCodec::ReadVarint(f_data, f_size, l_offset, l_value);
+        l_header[i] = CFrameCodec::Predict(m_previousHeader[i], m_olderHeader[i], m_depth) + CFrameCodec::DecodeZigzag(l_value);
+    }
+    const int64_t l_interval = ((m_depth > 0U) ? (l_header[2U] - m_previousHeader[2U]) : 0);
+
+    uint64_t l_handsCount = 0U;
+    if(l_result) l_result = (CFrameCodec::ReadVarint(f_data, f_size, l_offset, l_handsCount) && (l_handsCount <= CLeapFrame::GetHandsLimit()));
+    for(uint32_t i = 0U; l_result && (i < l_handsCount); i++)
+    {
+        uint64_t l_id = 0U;
+        int64_t *l_channels = m_channels + i * CFrameCodec::CL_ChannelsCount;
+        l_result = (CFrameCodec::ReadVarint(f_data, f_size, l_offset, l_id) && CFrameCodec::ReadResiduals(f_data, f_size, l_offset, l_channels, CFrameCodec::CL_ChannelsCount));
+        if(l_result)
+        {
+            const int64_t *l_previous = CFrameCodec::FindHand(m_handIds, m_handChannels, m_handsCount, static_cast<uint32_t>(l_id));
+            const int64_t *l_older = (l_previous ? CFrameCodec::FindHand(m_olderIds, m_olderChannels, m_olderCount, static_cast<uint32_t>(l_id)) : nullptr);
+            CFrameCodec::PredictHand(l_previous, l_older, m_prediction);
+
+            // Palm position is decoded before velocity is predicted from it
+            for(size_t k = 0U; k < CFrameCodec::CL_PalmVelocity; k++) l_channels[k] += m_prediction[k];
+            CFrameCodec::PredictVelocity(l_channels, l_previous, l_interval, m_prediction);
+            for(size_t k = CFrameCodec::CL_PalmVelocity; k < CFrameCodec::CL_ChannelsCount; k++) l_channels[k] += m_prediction[k];
+            CFrameCodec::DequantizeHand(l_channels, static_cast<uint32_t>(l_id), m_hands[i]);
+        }
+    }
+
+    if(l_result && (l_offset == f_size))
+    {
+        std::swap(m_olderChannels, m_handChannels);
+        std::swap(m_handChannels, m_channels);
+        std::swap(m_olderIds, m_handIds);
+        for(uint32_t i = 0U; i < l_handsCount; i++) m_handIds[i] = m_hands[i].id;
+        m_olderCount = m_handsCount;
+        m_handsCount = static_cast<uint32_t>(l_handsCount);
+        for(size_t i = 0U; i < 5U; i++)
+        {
+            m_olderHeader[i] = m_previousHeader[i];
+            m_previousHeader[i] = l_header[i];
+        }
+        m_depth = std::min(m_depth + 1U, 2U);
+
+        LEAP_TRACKING_EVENT l_event = { 0 };
+        f_hostTime = l_header[0U];
+        l_event.info.frame_id = l_header[1U];
+        l_event.info.timestamp = l_header[2U];
+        l_event.tracking_frame_id = l_header[3U];
+        l_event.framerate = static_cast<float>(static_cast<double>(l_header[4U]) / g_framerateScale);
+        l_event.nHands = m_handsCount;
+        l_event.pHands = m_hands;
+        f_frame.CopyEvent(&l_event);
+    }
+    else
+    {
+        // Damaged stream can't be continued without keyframe
+        l_result = false;
+        m_synchronized = false;
+    }
+    return l_result;
+}
+
+bool CFrameDecoder::IsKeyframe(const uint8_t *f_data, size_t f_size)
+{
+    return ((f_size > 0U) && (f_data[0U] & CFrameCodec::FF_Keyframe));
+}
+
+bool CFrameDecoder::ReadKeyframeHeader(const uint8_t *f_data, size_t f_size, int64_t &f_hostTime, int64_t &f_timestamp, int64_t &f_trackingFrameId)
+{
+    bool l_result = IsKeyframe(f_data, f_size);
+    size_t l_offset = 1U;
+    int64_t l_header[4U] = { 0 };
+    for(size_t i = 0U; l_result && (i < 4U); i++)
+    {
+        uint64_t l_value = 0U;
+        l_result = CFrameCodec::ReadVarint(f_data, f_size, l_offset, l_value);
+        l_header[i] = CFrameCodec::DecodeZigzag(l_value);
+    }
+    if(l_result)
+    {
+        f_hostTime = l_header[0U];
+        f_timestamp = l_header[2U];
+        f_trackingFrameId = l_header[3U];
+    }
+    return l_result;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+class CLeapFrame;
+
+// Streaming decoder of CFrameEncoder payloads, frames have to be decoded in order starting from keyframe
+class CFrameDecoder final
+{
+    bool m_synchronized;
+    uint32_t m_depth;
+    int64_t m_previousHeader[5U];
+    int64_t m_olderHeader[5U];
+    uint32_t m_handsCount;
+    uint32_t *m_handIds;
+    int64_t *m_handChannels;
+    uint32_t m_olderCount;
+    uint32_t *m_olderIds;
+    int64_t *m_olderChannels;
+    int64_t *m_channels;
+    int64_t *m_prediction;
+    LEAP_HAND *m_hands;
+
+    CFrameDecoder(const CFrameDecoder &that) = delete;
+    CFrameDecoder& operator=(const CFrameDecoder &that) = delete;
+public:
+    CFrameDecoder();
+    ~CFrameDecoder();
+
+    // Following delta frames are rejected till next keyframe
+    void Reset();
+
+    bool Decode(const uint8_t *f_data, size_t f_size, CLeapFrame &f_frame, int64_t &f_hostTime);
+
+    static bool IsKeyframe(const uint8_t *f_data, size_t f_size);
+    // Keyframe header holds absolute values and is read without decoding hands
+    static bool ReadKeyframeHeader(const uint8_t *f_data, size_t f_size, int64_t &f_hostTime, int64_t &f_timestamp, int64_t &f_trackingFrameId);
+};
@@ -0,0 +1,96 @@
+#include "stdafx.h"
+
+#include "Core/CFrameEncoder.h"
+#include "Core/CFrameCodec.h"
+#include "Core/CLeapFrame.h"
+
+const float g_framerateScale = 100.f;
+
+CFrameEncoder::CFrameEncoder(uint32_t f_keyframeInterval)
+{
+    m_keyframeInterval = std::max(f_keyframeInterval, 1U);
+    m_handIds = new uint32_t[CLeapFrame::GetHandsLimit()];
+    m_handChannels = new int64_t[CLeapFrame::GetHandsLimit() * CFrameCodec::CL_ChannelsCount];
+    m_olderIds = new uint32_t[CLeapFrame::GetHandsLimit()];
+    m_olderChannels = new int64_t[CLeapFrame::GetHandsLimit() * CFrameCodec::CL_ChannelsCount];
+    m_channels = new int64_t[CLeapFrame::GetHandsLimit() * CFrameCodec::CL_ChannelsCount];
+    m_residuals = new int64_t[CFrameCodec::CL_ChannelsCount];
+    Reset();
+}
+
+CFrameEncoder::~CFrameEncoder()
+{
+    delete[]m_handIds;
+    delete[]m_handChannels;
+    delete[]m_olderIds;
+    delete[]m_olderChannels;
+    delete[]m_channels;
+    delete[]m_residuals;
+}
+
+void CFrameEncoder::Reset()
+{
+    m_framesSinceKeyframe = m_keyframeInterval;
+    m_depth = 0U;
+    for(size_t i = 0U; i < 5U; i++) m_previousHeader[i] = m_olderHeader[i] = 0;
+    m_handsCount = 0U;
+    m_olderCount = 0U;
+}
+
+// Flags, residuals of predicted host time, frame id, timestamp, tracking frame id and framerate, hands count, then id and channel residuals of each hand
+bool CFrameEncoder::Encode(const LEAP_TRACKING_EVENT *f_event, int64_t f_hostTime, std::vector<uint8_t> &f_buffer)
+{
+    const bool l_keyframe = (m_framesSinceKeyframe >= m_keyframeInterval);
+    if(l_keyframe)
+    {
+        m_depth = 0U;
+        m_handsCount = 0U;
+        m_olderCount = 0U;
+        m_framesSinceKeyframe = 0U;
+    }
+    m_framesSinceKeyframe++;
+
+    f_buffer.push_back(l_keyframe ? CFrameCodec::FF_Keyframe : 0U);
+
+    const int64_t l_header[5U] = {
+        f_hostTime, f_event->info.frame_id, f_event->info.timestamp, f_event->tracking_frame_id,
+        static_cast<int64_t>(std::llround(static_cast<double>(f_event->framerate) * g_framerateScale))
+    };
+    for(size_t i = 0U; i < 5U; i++) CFrameCodec::WriteVarint(f_buffer, CFrameCodec::EncodeZigzag(l_header[i] - CFrameCodec::Predict(m_previousHeader[i], m_olderHeader[i], m_depth)));
+    const int64_t l_interval = ((m_depth > 0U) ? (l_header[2U] - m_previousHeader[2U]) : 0);
+
+    const uint32_t l_handsCount = std::min(f_event->nHands, CLeapFrame::GetHandsLimit());
+    CFrameCodec::WriteVarint(f_buffer, l_handsCount);
+    for(uint32_t i = 0U; i < l_handsCount; i++)
+    {
+        const LEAP_HAND &l_hand = f_event->pHands[i];
+        int64_t *l_channels = m_channels + i * CFrameCodec::CL_ChannelsCount;
+        CFrameCodec::QuantizeHand(l_hand, l_channels);
+
+        // Older hand is used only when hand is present in previous frame too
+        const int64_t *l_previous = CFrameCodec::FindHand(m_handIds, m_handChannels, m_handsCount, l_hand.id);
+        const int64_t *l_older = (l_previous ? CFrameCodec::FindHand(m_olderIds, m_olderChannels, m_olderCount, l_hand.id) : nullptr);
+        CFrameCodec::PredictHand(l_previous, l_older, m_residuals);
+        CFrameCodec::PredictVelocity(l_channels, l_previous, l_interval, m_residuals);
+        for(size_t j = 0U; j < CFrameCodec::CL_ChannelsCount; j++) m_residuals[j] = l_channels[j] - m_residuals[j];
+
+        CFrameCodec::WriteVarint(f_buffer, l_hand.id);
+        CFrameCodec::WriteResiduals(f_buffer, m_residuals, CFrameCodec::CL_ChannelsCount);
+    }
+
+    // Frame becomes previous one, previous frame becomes older one
+    std::swap(m_olderChannels, m_handChannels);
+    std::swap(m_handChannels, m_channels);
+    std::swap(m_olderIds, m_handIds);
+    for(uint32_t i = 0U; i < l_handsCount; i++) m_handIds[i] = f_event->pHands[i].id;
+    m_olderCount = m_handsCount;
+    m_handsCount = l_handsCount;
+    for(size_t i = 0U; i < 5U; i++)
+    {
+        m_olderHeader[i] = m_previousHeader[i];
+        m_previousHeader[i] = l_header[i];
+    }
+    m_depth = std::min(m_depth + 1U, 2U);
+
+    return l_keyframe;
+}
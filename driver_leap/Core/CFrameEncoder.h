@@ -0,0 +1,31 @@
+#pragma once
+
+// Streaming encoder of tracking frames, hands are predicted from hands with same id in two previous frames
+class CFrameEncoder final
+{
+    uint32_t m_keyframeInterval;
+    uint32_t m_framesSinceKeyframe;
+    uint32_t m_depth;
+    int64_t m_previousHeader[5U];
+    int64_t m_olderHeader[5U];
+    uint32_t m_handsCount;
+    uint32_t *m_handIds;
+    int64_t *m_handChannels;
+    uint32_t m_olderCount;
+    uint32_t *m_olderIds;
+    int64_t *m_olderChannels;
+    int64_t *m_channels;
+    int64_t *m_residuals;
+
+    CFrameEncoder(const CFrameEncoder &that) = delete;
+    CFrameEncoder& operator=(const CFrameEncoder &that) = delete;
+public:
+    explicit CFrameEncoder(uint32_t f_keyframeInterval = 120U);
+    ~CFrameEncoder();
+
+    // Next frame is encoded as keyframe
+    void Reset();
+
+    // Appends payload of compressed frame record, returns true for keyframe. Hands above CLeapFrame limit are dropped.
+    bool Encode(const LEAP_TRACKING_EVENT *f_event, int64_t f_hostTime, std::vector<uint8_t> &f_buffer);
+};
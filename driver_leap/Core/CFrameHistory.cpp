@@ -0,0 +1,125 @@
+#include "stdafx.h"
+
+#include "Core/CFrameHistory.h"
+#include "Core/CLeapFrame.h"
+
+CFrameHistory::CFrameHistory()
+{
+    m_frames = new CLeapFrame[ms_historyLimit];
+    m_head = 0U;
+    m_count = 0U;
+}
+
+CFrameHistory::~CFrameHistory()
+{
+    delete[]m_frames;
+}
+
+bool CFrameHistory::Push(const LEAP_TRACKING_EVENT *f_event)
+{
+    bool l_result = false;
+    std::lock_guard<std::mutex> l_guard(m_lock);
+    if((m_count == 0U) || (f_event->info.timestamp > GetOrdered(m_count - 1U).GetEvent()->info.timestamp))
+    {
+        if(m_count < ms_historyLimit)
+        {
+            m_frames[(m_head + m_count) % ms_historyLimit].CopyEvent(f_event);
+            m_count++;
+        }
+        else
+        {
+            // Overwrite oldest
+            m_frames[m_head].CopyEvent(f_event);
+            m_head = (m_head + 1U) % ms_historyLimit;
+        }
+        l_result = true;
+    }
+    return l_result;
+}
+
+void CFrameHistory::Clear()
+{
+    std::lock_guard<std::mutex> l_guard(m_lock);
+    m_head = 0U;
+    m_count = 0U;
+}
+
+unsigned char CFrameHistory::GetBracket(int64_t f_time, CLeapFrame &f_before, CLeapFrame &f_after) const
+{
+    unsigned char l_result = BR_None;
+    std::lock_guard<std::mutex> l_guard(m_lock);
+    const size_t l_upper = FindUpperBound(f_time);
+    if(l_upper > 0U)
+    {
+        f_before = GetOrdered(l_upper - 1U);
+        l_result |= BR_Before;
+    }
+    if(l_upper < m_count)
+    {
+        f_after = GetOrdered(l_upper);
+        l_result |= BR_After;
+    }
+    return l_result;
+}
+
+bool CFrameHistory::GetFrameById(int64_t f_id, CLeapFrame &f_frame) const
+{
+    bool l_result = false;
+    std::lock_guard<std::mutex> l_guard(m_lock);
+
+    // Frame identifiers grow along with timestamps
+    size_t l_low = 0U;
+    size_t l_high = m_count;
+    while(l_low < l_high)
+    {
+        const size_t l_middle = l_low + (l_high - l_low) / 2U;
+        if(GetOrdered(l_middle).GetEvent()->tracking_frame_id < f_id) l_low = l_middle + 1U;
+        else l_high = l_middle;
+    }
+    if((l_low < m_count) && (GetOrdered(l_low).GetEvent()->tracking_frame_id == f_id))
+    {
+        f_frame = GetOrdered(l_low);
+        l_result = true;
+    }
+    return l_result;
+}
+
+size_t CFrameHistory::GetLatest(CLeapFrame *f_frames, size_t f_count, int64_t f_time) const
+{
+    std::lock_guard<std::mutex> l_guard(m_lock);
+    const size_t l_upper = FindUpperBound(f_time);
+    const size_t l_count = std::min(f_count, l_upper);
+    for(size_t i = 0U; i < l_count; i++) f_frames[i] = GetOrdered(l_upper - l_count + i);
+    return l_count;
+}
+
+size_t CFrameHistory::GetCount() const
+{
+    std::lock_guard<std::mutex> l_guard(m_lock);
+    return m_count;
+}
+
+size_t CFrameHistory::GetLimit()
+{
+    return ms_historyLimit;
+}
+
+// Called with lock held
+const CLeapFrame& CFrameHistory::GetOrdered(size_t f_index) const
+{
+    return m_frames[(m_head + f_index) % ms_historyLimit];
+}
+
+// Called with lock held, returns index of first frame newer than time
+size_t CFrameHistory::FindUpperBound(int64_t f_time) const
+{
+    size_t l_low = 0U;
+    size_t l_high = m_count;
+    while(l_low < l_high)
+    {
+        const size_t l_middle = l_low + (l_high - l_low) / 2U;
+        if(GetOrdered(l_middle).GetEvent()->info.timestamp <= f_time) l_low = l_middle + 1U;
+        else l_high = l_middle;
+    }
+    return l_low;
+}
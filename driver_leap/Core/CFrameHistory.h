@@ -0,0 +1,44 @@
+#pragma once
+
+class CLeapFrame;
+
+// Bounded ring of deep-copied frames ordered by timestamp, filled by poller thread and queried by others
+class CFrameHistory final
+{
+    static const size_t ms_historyLimit = 64U;
+
+    mutable std::mutex m_lock;
+    CLeapFrame *m_frames;
+    size_t m_head; // Index of oldest frame
+    size_t m_count;
+
+    CFrameHistory(const CFrameHistory &that) = delete;
+    CFrameHistory& operator=(const CFrameHistory &that) = delete;
+
+    const CLeapFrame& GetOrdered(size_t f_index) const;
+    size_t FindUpperBound(int64_t f_time) const;
+public:
+    enum BracketResult : unsigned char
+    {
+        BR_None = 0U,
+        BR_Before = 1U,
+        BR_After = 2U,
+        BR_Both = BR_Before | BR_After
+    };
+
+    CFrameHistory();
+    ~CFrameHistory();
+
+    // Frames with timestamp not newer than last stored one are dropped
+    bool Push(const LEAP_TRACKING_EVENT *f_event);
+    void Clear();
+
+    // Latest frame at or before time and earliest frame after it, in Leap clock
+    unsigned char GetBracket(int64_t f_time, CLeapFrame &f_before, CLeapFrame &f_after) const;
+    bool GetFrameById(int64_t f_id, CLeapFrame &f_frame) const;
+    // Copies up to count newest frames not newer than time, oldest first
+    size_t GetLatest(CLeapFrame *f_frames, size_t f_count, int64_t f_time = std::numeric_limits<int64_t>::max()) const;
+
+    size_t GetCount() const;
+    static size_t GetLimit();
+};
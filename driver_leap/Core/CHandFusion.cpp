@@ -0,0 +1,244 @@
+#include "stdafx.h"
+
+#include "Core/CHandFusion.h"
+#include "Core/CDriverConfig.h"
+#include "Core/CLeapFrame.h"
+#include "Utils/Utils.h"
+
+CHandFusion::CHandFusion()
+{
+    m_mode = CDriverConfig::FM_Select;
+    for(size_t i = 0U; i < ms_devicesLimit; i++)
+    {
+        m_offsets[i] = glm::vec3(0.f);
+        m_rotations[i] = glm::quat(1.f, 0.f, 0.f, 0.f);
+        m_present[i] = false;
+    }
+    m_frames = new CLeapFrame[ms_devicesLimit];
+}
+
+CHandFusion::~CHandFusion()
+{
+    delete[]m_frames;
+}
+
+void CHandFusion::SetMode(unsigned char f_mode)
+{
+    m_mode = f_mode;
+}
+
+void CHandFusion::SetExtrinsics(size_t f_device, const glm::vec3 &f_offset, const glm::quat &f_rotation)
+{
+    if(f_device < ms_devicesLimit)
+    {
+        m_offsets[f_device] = f_offset * 1000.f; // Leap Motion units are millimeters
+        m_rotations[f_device] = glm::normalize(f_rotation);
+    }
+}
+
+void CHandFusion::UpdateDevice(size_t f_device, const LEAP_TRACKING_EVENT *f_event)
+{
+    if(f_device < ms_devicesLimit)
+    {
+        m_frames[f_device].CopyEvent(f_event);
+        m_present[f_device] = true;
+    }
+}
+
+void CHandFusion::RemoveDevice(size_t f_device)
+{
+    if(f_device < ms_devicesLimit)
+    {
+        m_frames[f_device].Clear();
+        m_present[f_device] = false;
+    }
+}
+
+void CHandFusion::Fuse(int64_t f_time, CLeapFrame &f_result) const
+{
+    // Header comes from newest device frame
+    size_t l_newest = ms_devicesLimit;
+    for(size_t i = 0U; i < ms_devicesLimit; i++)
+    {
+        if(m_present[i] && ((l_newest == ms_devicesLimit) || (m_frames[i].GetEvent()->info.timestamp > m_frames[l_newest].GetEvent()->info.timestamp))) l_newest = i;
+    }
+
+    if(l_newest != ms_devicesLimit)
+    {
+        LEAP_TRACKING_EVENT l_event = *m_frames[l_newest].GetEvent();
+        LEAP_HAND l_hands[2U];
+        l_event.nHands = 0U;
+        l_event.pHands = l_hands;
+
+        for(int l_side = eLeapHandType_Left; l_side <= eLeapHandType_Right; l_side++)
+        {
+            // Candidates are bounded by devices and hands limits
+            LEAP_HAND l_candidates[ms_devicesLimit];
+            size_t l_count = 0U;
+            for(size_t i = 0U; i < ms_devicesLimit; i++)
+            {
+                if(!m_present[i]) continue;
+
+                const LEAP_TRACKING_EVENT *l_deviceEvent = m_frames[i].GetEvent();
+                if((f_time - l_deviceEvent->info.timestamp) > ms_frameLifetime) continue;
+
+                const LEAP_HAND *l_best = nullptr;
+                for(uint32_t j = 0U; j < l_deviceEvent->nHands; j++)
+                {
+                    const LEAP_HAND &l_hand = l_deviceEvent->pHands[j];
+                    if((l_hand.type == l_side) && (!l_best || (l_hand.confidence > l_best->confidence))) l_best = &l_hand;
+                }
+                if(l_best)
+                {
+                    l_candidates[l_count] = *l_best;
+                    TransformHand(i, l_candidates[l_count]);
+                    l_count++;
+                }
+            }
+
+            if(l_count > 0U)
+            {
+                // Most confident candidate goes first
+                for(size_t i = 1U; i < l_count; i++)
+                {
+                    if(l_candidates[i].confidence > l_candidates[0U].confidence) std::swap(l_candidates[i], l_candidates[0U]);
+                }
+
+                if((m_mode == CDriverConfig::FM_Blend) && (l_count > 1U)) BlendHands(l_candidates, l_count, l_hands[l_event.nHands]);
+                else l_hands[l_event.nHands] = l_candidates[0U];
+                l_event.nHands++;
+            }
+        }
+
+        f_result.CopyEvent(&l_event);
+    }
+    else f_result.Clear();
+}
+
+void CHandFusion::ToDeviceSpace(size_t f_device, LEAP_HAND &f_hand) const
+{
+    if((f_device > 0U) && (f_device < ms_devicesLimit))
+    {
+        const glm::quat l_rotation = glm::inverse(m_rotations[f_device]);
+        TransformHand(l_rotation, -(l_rotation * m_offsets[f_device]), f_hand);
+    }
+}
+
+size_t CHandFusion::GetDevicesLimit()
+{
+    return ms_devicesLimit;
+}
+
+void CHandFusion::TransformHand(size_t f_device, LEAP_HAND &f_hand) const
+{
+    if(f_device > 0U) TransformHand(m_rotations[f_device], m_offsets[f_device], f_hand);
+}
+
+void CHandFusion::TransformHand(const glm::quat &f_rotation, const glm::vec3 &f_offset, LEAP_HAND &f_hand)
+{
+    glm::vec3 l_vector;
+
+    ConvertVector3(f_hand.palm.position, l_vector);
+    ConvertVector3(f_rotation * l_vector + f_offset, f_hand.palm.position);
+    ConvertVector3(f_hand.palm.stabilized_position, l_vector);
+    ConvertVector3(f_rotation * l_vector + f_offset, f_hand.palm.stabilized_position);
+    ConvertVector3(f_hand.palm.velocity, l_vector);
+    ConvertVector3(f_rotation * l_vector, f_hand.palm.velocity);
+    ConvertVector3(f_hand.palm.normal, l_vector);
+    ConvertVector3(f_rotation * l_vector, f_hand.palm.normal);
+    ConvertVector3(f_hand.palm.direction, l_vector);
+    ConvertVector3(f_rotation * l_vector, f_hand.palm.direction);
+
+    glm::quat l_orientation;
+    ConvertQuaternion(f_hand.palm.orientation, l_orientation);
+    ConvertQuaternion(f_rotation * l_orientation, f_hand.palm.orientation);
+
+    for(size_t i = 0U; i < 5U; i++)
+    {
+        for(size_t j = 0U; j < 4U; j++) TransformBone(f_rotation, f_offset, f_hand.digits[i].bones[j]);
+    }
+    TransformBone(f_rotation, f_offset, f_hand.arm);
+}
+
+void CHandFusion::TransformBone(const glm::quat &f_rotation, const glm::vec3 &f_offset, LEAP_BONE &f_bone)
+{
+    glm::vec3 l_vector;
+    ConvertVector3(f_bone.prev_joint, l_vector);
+    ConvertVector3(f_rotation * l_vector + f_offset, f_bone.prev_joint);
+    ConvertVector3(f_bone.next_joint, l_vector);
+    ConvertVector3(f_rotation * l_vector + f_offset, f_bone.next_joint);
+
+    glm::quat l_orientation;
+    ConvertQuaternion(f_bone.rotation, l_orientation);
+    ConvertQuaternion(f_rotation * l_orientation, f_bone.rotation);
+}
+
+// First hand is reference for non-blended values and quaternion signs
+void CHandFusion::BlendHands(const LEAP_HAND *f_hands, size_t f_count, LEAP_HAND &f_result)
+{
+    f_result = f_hands[0U];
+
+    float l_weights[ms_devicesLimit];
+    float l_totalWeight = 0.f;
+    for(size_t i = 0U; i < f_count; i++)
+    {
+        l_weights[i] = std::max(f_hands[i].confidence, std::numeric_limits<float>::epsilon());
+        l_totalWeight += l_weights[i];
+    }
+    for(size_t i = 0U; i < f_count; i++) l_weights[i] /= l_totalWeight;
+
+    glm::vec3 l_position(0.f);
+    glm::quat l_orientation(0.f, 0.f, 0.f, 0.f);
+    glm::quat l_reference;
+    ConvertQuaternion(f_hands[0U].palm.orientation, l_reference);
+    float l_pinch = 0.f;
+    float l_grab = 0.f;
+    for(size_t i = 0U; i < f_count; i++)
+    {
+        glm::vec3 l_vector;
+        ConvertVector3(f_hands[i].palm.position, l_vector);
+        l_position += l_vector * l_weights[i];
+
+        glm::quat l_rotation;
+        ConvertQuaternion(f_hands[i].palm.orientation, l_rotation);
+        if(glm::dot(l_rotation, l_reference) < 0.f) l_rotation = -l_rotation;
+        l_orientation = l_orientation + l_rotation * l_weights[i];
+
+        l_pinch += f_hands[i].pinch_strength * l_weights[i];
+        l_grab += f_hands[i].grab_strength * l_weights[i];
+    }
+    ConvertVector3(l_position, f_result.palm.position);
+    ConvertQuaternion(glm::normalize(l_orientation), f_result.palm.orientation);
+    f_result.pinch_strength = l_pinch;
+    f_result.grab_strength = l_grab;
+
+    for(size_t i = 0U; i < 5U; i++)
+    {
+        for(size_t j = 0U; j < 4U; j++)
+        {
+            glm::vec3 l_prevJoint(0.f);
+            glm::vec3 l_nextJoint(0.f);
+            glm::quat l_boneRotation(0.f, 0.f, 0.f, 0.f);
+            glm::quat l_boneReference;
+            ConvertQuaternion(f_hands[0U].digits[i].bones[j].rotation, l_boneReference);
+            for(size_t k = 0U; k < f_count; k++)
+            {
+                const LEAP_BONE &l_bone = f_hands[k].digits[i].bones[j];
+                glm::vec3 l_vector;
+                ConvertVector3(l_bone.prev_joint, l_vector);
+                l_prevJoint += l_vector * l_weights[k];
+                ConvertVector3(l_bone.next_joint, l_vector);
+                l_nextJoint += l_vector * l_weights[k];
+
+                glm::quat l_rotation;
+                ConvertQuaternion(l_bone.rotation, l_rotation);
+                if(glm::dot(l_rotation, l_boneReference) < 0.f) l_rotation = -l_rotation;
+                l_boneRotation = l_boneRotation + l_rotation * l_weights[k];
+            }
+            LEAP_BONE &l_result = f_result.digits[i].bones[j];
+            ConvertVector3(l_prevJoint, l_result.prev_joint);
+            ConvertVector3(l_nextJoint, l_result.next_joint);
+            ConvertQuaternion(glm::normalize(l_boneRotation), l_result.rotation);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+class CLeapFrame;
+
+// Merges latest frames of several devices into single frame in coordinates of first device
+class CHandFusion final
+{
+    static const size_t ms_devicesLimit = 4U;
+    static const int64_t ms_frameLifetime = 100000; // Microseconds
+
+    unsigned char m_mode;
+    glm::vec3 m_offsets[ms_devicesLimit];
+    glm::quat m_rotations[ms_devicesLimit];
+    CLeapFrame *m_frames;
+    bool m_present[ms_devicesLimit];
+
+    CHandFusion(const CHandFusion &that) = delete;
+    CHandFusion& operator=(const CHandFusion &that) = delete;
+
+    void TransformHand(size_t f_device, LEAP_HAND &f_hand) const;
+    static void TransformHand(const glm::quat &f_rotation, const glm::vec3 &f_offset, LEAP_HAND &f_hand);
+    static void TransformBone(const glm::quat &f_rotation, const glm::vec3 &f_offset, LEAP_BONE &f_bone);
+    static void BlendHands(const LEAP_HAND *f_hands, size_t f_count, LEAP_HAND &f_result);
+public:
+    CHandFusion();
+    ~CHandFusion();
+
+    void SetMode(unsigned char f_mode);
+    // Offset in meters and rotation from device to first device space
+    void SetExtrinsics(size_t f_device, const glm::vec3 &f_offset, const glm::quat &f_rotation);
+
+    void UpdateDevice(size_t f_device, const LEAP_TRACKING_EVENT *f_event);
+    void RemoveDevice(size_t f_device);
+
+    // At most one hand per side, frames older than lifetime relative to time are ignored
+    void Fuse(int64_t f_time, CLeapFrame &f_result) const;
+    // Inverse of device extrinsics, hand in first device space is moved to space of device
+    void ToDeviceSpace(size_t f_device, LEAP_HAND &f_hand) const;
+
+    static size_t GetDevicesLimit();
+};
@@ -0,0 +1,243 @@
+#include "stdafx.h"
+
+#include "Core/CHandPredictor.h"
+#include "Core/CFrameHistory.h"
+#include "Core/CLeapFrame.h"
+#include "Utils/Utils.h"
+
+CHandPredictor::CHandPredictor()
+{
+    m_samples = new CLeapFrame[ms_samplesLimit];
+    m_evaluation = new CLeapFrame[ms_samplesLimit + 1U];
+    m_evaluatedFrame = -1;
+
+    m_windowStart = 0;
+    m_costCount = 0U;
+    m_costSum = 0;
+    m_costMaxWindow = 0;
+    m_errorCount = 0U;
+    m_errorSum = 0.f;
+    m_errorMaxWindow = 0.f;
+
+    m_costAverage = 0;
+    m_costMax = 0;
+    m_errorAverage = 0.f;
+    m_errorMax = 0.f;
+}
+
+CHandPredictor::~CHandPredictor()
+{
+    delete[]m_samples;
+    delete[]m_evaluation;
+}
+
+bool CHandPredictor::Predict(const CFrameHistory *f_history, int64_t f_targetTime, int64_t f_horizonLimit, CLeapFrame &f_result)
+{
+    const auto l_start = std::chrono::steady_clock::now();
+
+    const size_t l_count = f_history->GetLatest(m_samples, ms_samplesLimit);
+    if(l_count > 0U) Extrapolate(m_samples, l_count, f_targetTime, f_horizonLimit, f_result);
+
+    const int64_t l_cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start).count();
+    m_costSum += l_cost;
+    m_costMaxWindow = std::max(m_costMaxWindow, l_cost);
+    m_costCount++;
+
+    if(l_count > 0U) Evaluate(f_history, f_targetTime - m_samples[l_count - 1U].GetEvent()->info.timestamp, f_horizonLimit);
+    UpdateWindow(LeapGetNow());
+
+    return (l_count > 0U);
+}
+
+void CHandPredictor::Evaluate(const CFrameHistory *f_history, int64_t f_horizon, int64_t f_horizonLimit)
+{
+    // Once per new tracking frame
+    CLeapFrame &l_actual = m_evaluation[ms_samplesLimit];
+    if(f_history->GetLatest(&l_actual, 1U) > 0U)
+    {
+        const LEAP_TRACKING_EVENT *l_actualEvent = l_actual.GetEvent();
+        if(l_actualEvent->tracking_frame_id != m_evaluatedFrame)
+        {
+            m_evaluatedFrame = l_actualEvent->tracking_frame_id;
+
+            const int64_t l_horizon = std::min(std::max(f_horizon, static_cast<int64_t>(0)), f_horizonLimit);
+            const size_t l_count = f_history->GetLatest(m_evaluation, ms_samplesLimit, l_actualEvent->info.timestamp - std::max(l_horizon, static_cast<int64_t>(1)));
+            if(l_count > 0U)
+            {
+                CLeapFrame l_predicted;
+                Extrapolate(m_evaluation, l_count, l_actualEvent->info.timestamp, f_horizonLimit, l_predicted);
+
+                const LEAP_TRACKING_EVENT *l_predictedEvent = l_predicted.GetEvent();
+                for(uint32_t i = 0U; i < l_actualEvent->nHands; i++)
+                {
+                    const LEAP_HAND *l_hand = FindHand(l_predictedEvent, l_actualEvent->pHands[i].id);
+                    if(l_hand)
+                    {
+                        glm::vec3 l_predictedPosition, l_actualPosition;
+                        ConvertVector3(l_hand->palm.position, l_predictedPosition);
+                        ConvertVector3(l_actualEvent->pHands[i].palm.position, l_actualPosition);
+                        const float l_error = glm::distance(l_predictedPosition, l_actualPosition);
+                        m_errorSum += l_error;
+                        m_errorMaxWindow = std::max(m_errorMaxWindow, l_error);
+                        m_errorCount++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+int64_t CHandPredictor::GetCostAverage() const
+{
+    return m_costAverage;
+}
+
+int64_t CHandPredictor::GetCostMax() const
+{
+    return m_costMax;
+}
+
+float CHandPredictor::GetErrorAverage() const
+{
+    return m_errorAverage;
+}
+
+float CHandPredictor::GetErrorMax() const
+{
+    return m_errorMax;
+}
+
+void CHandPredictor::Extrapolate(const CLeapFrame *f_samples, size_t f_count, int64_t f_targetTime, int64_t f_horizonLimit, CLeapFrame &f_result)
+{
+    f_result = f_samples[f_count - 1U];
+
+    const LEAP_TRACKING_EVENT *l_newest = f_samples[f_count - 1U].GetEvent();
+    const int64_t l_horizon = std::min(std::max(f_targetTime - l_newest->info.timestamp, static_cast<int64_t>(0)), f_horizonLimit);
+    if((l_horizon > 0) && (f_count > 1U))
+    {
+        const float l_horizonSeconds = static_cast<float>(l_horizon) * 1e-6f;
+        LEAP_TRACKING_EVENT *l_result = const_cast<LEAP_TRACKING_EVENT*>(f_result.GetEvent());
+        for(uint32_t i = 0U; i < l_result->nHands; i++)
+        {
+            LEAP_HAND &l_hand = l_result->pHands[i];
+
+            // Gather samples of same hand, times are relative to newest frame
+            const LEAP_HAND *l_hands[ms_samplesLimit];
+            float l_times[ms_samplesLimit];
+            size_t l_samplesCount = 0U;
+            for(size_t j = 0U; j < f_count; j++)
+            {
+                const LEAP_HAND *l_sample = FindHand(f_samples[j].GetEvent(), l_hand.id);
+                if(l_sample && (l_samplesCount < ms_samplesLimit))
+                {
+                    l_hands[l_samplesCount] = l_sample;
+                    l_times[l_samplesCount] = static_cast<float>(f_samples[j].GetEvent()->info.timestamp - l_newest->info.timestamp) * 1e-6f;
+                    l_samplesCount++;
+                }
+            }
+            if(l_samplesCount < 2U) continue;
+
+            const float l_span = l_times[l_samplesCount - 1U] - l_times[0U];
+            glm::vec3 l_values[ms_samplesLimit];
+
+            for(size_t j = 0U; j < l_samplesCount; j++) ConvertVector3(l_hands[j]->palm.position, l_values[j]);
+            ExtrapolatePosition(l_times, l_values, l_samplesCount, l_horizonSeconds, l_hand.palm.position);
+            ExtrapolateRotation(l_hands[0U]->palm.orientation, l_span, l_horizonSeconds, l_hand.palm.orientation);
+
+            for(size_t j = 0U; j < 5U; j++)
+            {
+                for(size_t k = 0U; k < 4U; k++)
+                {
+                    LEAP_BONE &l_bone = l_hand.digits[j].bones[k];
+                    for(size_t l = 0U; l < l_samplesCount; l++) ConvertVector3(l_hands[l]->digits[j].bones[k].prev_joint, l_values[l]);
+                    ExtrapolatePosition(l_times, l_values, l_samplesCount, l_horizonSeconds, l_bone.prev_joint);
+                    for(size_t l = 0U; l < l_samplesCount; l++) ConvertVector3(l_hands[l]->digits[j].bones[k].next_joint, l_values[l]);
+                    ExtrapolatePosition(l_times, l_values, l_samplesCount, l_horizonSeconds, l_bone.next_joint);
+                    ExtrapolateRotation(l_hands[0U]->digits[j].bones[k].rotation, l_span, l_horizonSeconds, l_bone.rotation);
+                }
+            }
+        }
+    }
+}
+
+void CHandPredictor::UpdateWindow(int64_t f_now)
+{
+    if(m_windowStart == 0) m_windowStart = f_now;
+    else if((f_now - m_windowStart) >= 1000000)
+    {
+        m_costAverage = ((m_costCount > 0U) ? (m_costSum / m_costCount) : 0);
+        m_costMax = m_costMaxWindow;
+        m_errorAverage = ((m_errorCount > 0U) ? (m_errorSum / static_cast<float>(m_errorCount)) : 0.f);
+        m_errorMax = m_errorMaxWindow;
+
+        m_costCount = 0U;
+        m_costSum = 0;
+        m_costMaxWindow = 0;
+        m_errorCount = 0U;
+        m_errorSum = 0.f;
+        m_errorMaxWindow = 0.f;
+        m_windowStart = f_now;
+    }
+}
+
+// Least squares slope over samples with times relative to newest sample
+glm::vec3 CHandPredictor::GetLinearVelocity(const float *f_times, const glm::vec3 *f_values, size_t f_count)
+{
+    float l_timeMean = 0.f;
+    glm::vec3 l_valueMean(0.f);
+    for(size_t i = 0U; i < f_count; i++)
+    {
+        l_timeMean += f_times[i];
+        l_valueMean += f_values[i];
+    }
+    l_timeMean /= static_cast<float>(f_count);
+    l_valueMean = l_valueMean / static_cast<float>(f_count);
+
+    float l_timeVariance = 0.f;
+    glm::vec3 l_covariance(0.f);
+    for(size_t i = 0U; i < f_count; i++)
+    {
+        const float l_timeDelta = f_times[i] - l_timeMean;
+        l_timeVariance += l_timeDelta * l_timeDelta;
+        l_covariance += (f_values[i] - l_valueMean) * l_timeDelta;
+    }
+    return ((l_timeVariance > 0.f) ? (l_covariance / l_timeVariance) : glm::vec3(0.f));
+}
+
+void CHandPredictor::ExtrapolatePosition(const float *f_times, const glm::vec3 *f_values, size_t f_count, float f_horizon, LEAP_VECTOR &f_result)
+{
+    const glm::vec3 l_velocity = GetLinearVelocity(f_times, f_values, f_count);
+    ConvertVector3(f_values[f_count - 1U] + l_velocity * f_horizon, f_result);
+}
+
+// Continues rotation between oldest and newest samples at same angular rate
+void CHandPredictor::ExtrapolateRotation(const LEAP_QUATERNION &f_oldest, float f_span, float f_horizon, LEAP_QUATERNION &f_result)
+{
+    if(f_span > 0.f)
+    {
+        const glm::quat l_newest(f_result.w, f_result.x, f_result.y, f_result.z);
+        glm::quat l_delta = l_newest * glm::inverse(glm::quat(f_oldest.w, f_oldest.x, f_oldest.y, f_oldest.z));
+        if(l_delta.w < 0.f) l_delta = -l_delta; // Shortest arc
+
+        const float l_angle = glm::angle(l_delta);
+        if(l_angle > std::numeric_limits<float>::epsilon())
+        {
+            const glm::quat l_result = glm::normalize(glm::angleAxis(l_angle * (f_horizon / f_span), glm::axis(l_delta)) * l_newest);
+            ConvertQuaternion(l_result, f_result);
+        }
+    }
+}
+
+const LEAP_HAND* CHandPredictor::FindHand(const LEAP_TRACKING_EVENT *f_event, uint32_t f_id)
+{
+    const LEAP_HAND *l_result = nullptr;
+    for(uint32_t i = 0U; i < f_event->nHands; i++)
+    {
+        if(f_event->pHands[i].id == f_id)
+        {
+            l_result = &f_event->pHands[i];
+            break;
+        }
+    }
+    return l_result;
+}
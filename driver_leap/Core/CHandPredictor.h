@@ -0,0 +1,53 @@
+#pragma once
+
+class CFrameHistory;
+class CLeapFrame;
+
+// Extrapolates hands of newest frames to given Leap time
+class CHandPredictor final
+{
+    static const size_t ms_samplesLimit = 4U;
+
+    CLeapFrame *m_samples;
+    CLeapFrame *m_evaluation;
+    int64_t m_evaluatedFrame;
+
+    int64_t m_windowStart;
+    uint32_t m_costCount;
+    int64_t m_costSum;
+    int64_t m_costMaxWindow;
+    uint32_t m_errorCount;
+    float m_errorSum;
+    float m_errorMaxWindow;
+
+    std::atomic<int64_t> m_costAverage;
+    std::atomic<int64_t> m_costMax;
+    std::atomic<float> m_errorAverage;
+    std::atomic<float> m_errorMax;
+
+    CHandPredictor(const CHandPredictor &that) = delete;
+    CHandPredictor& operator=(const CHandPredictor &that) = delete;
+
+    void UpdateWindow(int64_t f_now);
+
+    static glm::vec3 GetLinearVelocity(const float *f_times, const glm::vec3 *f_values, size_t f_count);
+    static void ExtrapolatePosition(const float *f_times, const glm::vec3 *f_values, size_t f_count, float f_horizon, LEAP_VECTOR &f_result);
+    static void ExtrapolateRotation(const LEAP_QUATERNION &f_oldest, float f_span, float f_horizon, LEAP_QUATERNION &f_result);
+    static const LEAP_HAND* FindHand(const LEAP_TRACKING_EVENT *f_event, uint32_t f_id);
+public:
+    CHandPredictor();
+    ~CHandPredictor();
+
+    // Horizon past newest frame is clamped to limit, all times in microseconds, measures cost and error
+    bool Predict(const CFrameHistory *f_history, int64_t f_targetTime, int64_t f_horizonLimit, CLeapFrame &f_result);
+    // Predicts newest frame from older ones over same horizon and measures palm position error
+    void Evaluate(const CFrameHistory *f_history, int64_t f_horizon, int64_t f_horizonLimit);
+
+    // Measured over last second, cost in nanoseconds and error in millimeters
+    int64_t GetCostAverage() const;
+    int64_t GetCostMax() const;
+    float GetErrorAverage() const;
+    float GetErrorMax() const;
+
+    static void Extrapolate(const CLeapFrame *f_samples, size_t f_count, int64_t f_targetTime, int64_t f_horizonLimit, CLeapFrame &f_result);
+};
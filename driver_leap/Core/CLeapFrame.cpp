@@ -0,0 +1,47 @@
+#include "stdafx.h"
+
+#include "Core/CLeapFrame.h"
+
+CLeapFrame::CLeapFrame()
+{
+    Clear();
+}
+
+CLeapFrame::CLeapFrame(const CLeapFrame &that)
+{
+    CopyEvent(&that.m_event);
+}
+
+CLeapFrame& CLeapFrame::operator=(const CLeapFrame &that)
+{
+    if(this != &that) CopyEvent(&that.m_event);
+    return *this;
+}
+
+CLeapFrame::~CLeapFrame()
+{
+}
+
+void CLeapFrame::CopyEvent(const LEAP_TRACKING_EVENT *f_event)
+{
+    std::memcpy(&m_event, f_event, sizeof(LEAP_TRACKING_EVENT));
+    if(m_event.nHands > ms_handsLimit) m_event.nHands = ms_handsLimit;
+    if(m_event.nHands > 0U) std::memcpy(m_hands, f_event->pHands, sizeof(LEAP_HAND) * m_event.nHands);
+    m_event.pHands = m_hands; // Never point to SDK memory
+}
+
+void CLeapFrame::Clear()
+{
+    std::memset(&m_event, 0, sizeof(LEAP_TRACKING_EVENT));
+    m_event.pHands = m_hands;
+}
+
+const LEAP_TRACKING_EVENT* CLeapFrame::GetEvent() const
+{
+    return &m_event;
+}
+
+uint32_t CLeapFrame::GetHandsLimit()
+{
+    return ms_handsLimit;
+}
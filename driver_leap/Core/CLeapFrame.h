@@ -0,0 +1,22 @@
+#pragma once
+
+class CLeapFrame final
+{
+    static const uint32_t ms_handsLimit = 4U;
+
+    LEAP_TRACKING_EVENT m_event;
+    LEAP_HAND m_hands[ms_handsLimit];
+public:
+    CLeapFrame();
+    CLeapFrame(const CLeapFrame &that);
+    CLeapFrame& operator=(const CLeapFrame &that);
+    ~CLeapFrame();
+
+    // Deep copy, hands above limit are dropped
+    void CopyEvent(const LEAP_TRACKING_EVENT *f_event);
+    void Clear();
+
+    const LEAP_TRACKING_EVENT* GetEvent() const;
+
+    static uint32_t GetHandsLimit();
+};
@@ -1,6 +1,26 @@
 #include "stdafx.h"
 
 #include "Core/CLeapPoller.h"
+#include "Core/CFrameContinuity.h"
+#include "Core/CFrameHistory.h"
+#include "Core/CHandFusion.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CSessionReader.h"
+#include "Core/CNativeSessionReader.h"
+#include "Core/CSessionRecorder.h"
+#include "Core/CDriverConfig.h"
+#include "Utils/CFrameProfiler.h"
+#include "Utils/CHistogram.h"
+#include "Utils/CJitterMeter.h"
+#include "Utils/CMemoryPool.h"
+#include "Utils/CStageTimer.h"
+#include "Utils/CTripleBuffer.h"
+#include "Utils/Utils.h"
+
+const int64_t g_interpolationLead = 2000; // Microseconds before expected RunFrame
+const int64_t g_framePeriodLimit = 100000;
+const int64_t g_reconnectDelayMin = 500000; // Microseconds, doubled on each failed attempt
+const int64_t g_reconnectDelayMax = 8000000;
 
 CLeapPoller::CLeapPoller()
 {
@@ -9,17 +29,124 @@ CLeapPoller::CLeapPoller()
     m_connection = nullptr;
     m_clockSynchronizer = nullptr;
     m_connected = false;
-    m_allocator.allocate = CLeapPoller::AllocateMemory;
-    m_allocator.deallocate = CLeapPoller::DeallocateMemory;
-    m_allocator.state = nullptr;
-    m_lastFrame = nullptr;
-    m_newFrame = nullptr;
-    m_device = nullptr;
+    m_serviceConnected = false;
+    m_reconnectTime = 0;
+    m_reconnectDelay = g_reconnectDelayMin;
+    m_reconnectsCount = 0U;
+    m_policySet = 0U;
+    m_policyClear = 0U;
+    m_policyDirty = false;
+    m_paused = false;
+    m_pauseDirty = false;
+    m_recorder = new CSessionRecorder();
+    m_recorders.push_back(m_recorder);
+    m_recordingDirty = false;
+    m_recordingRequest = false;
+    m_recordingFormat = CSessionRecorder::SF_Raw;
+
+    m_replay = false;
+    m_replayMode = RM_Realtime;
+    m_replayReader = new CSessionReader();
+    m_replayNativeReader = new CNativeSessionReader();
+    m_replayNative = false;
+    m_replayFrame = new CLeapFrame();
+    m_replayFrameTime = 0;
+    m_replayPending = false;
+    m_replayStart = 0;
+    m_replayOrigin = 0;
+    m_replayClockOffset = 0;
+    m_replaySpeed = 1.f;
+    m_replaySpeedRequest = 1.f;
+    m_replaySteps = 0U;
+    m_replayFinished = false;
+    m_memoryPool = new CMemoryPool(); // Outlives connection, SDK can release blocks till its destruction
+    m_allocator.allocate = CMemoryPool::AllocateMemory;
+    m_allocator.deallocate = CMemoryPool::DeallocateMemory;
+    m_allocator.state = m_memoryPool;
+    m_frameBuffer = nullptr;
+    m_interpolatedFrameBuffer = nullptr;
+    m_frameHistory = new CFrameHistory();
+    m_interpolationTime = 0;
+    m_latestFrameTime = 0;
+    m_jitterMeter = new CJitterMeter();
+    m_frameContinuity = new CFrameContinuity();
+    m_devices = new LEAP_DEVICE[CHandFusion::GetDevicesLimit()];
+    m_deviceIds = new uint32_t[CHandFusion::GetDevicesLimit()];
+    m_deviceOffsets = new glm::vec3[CHandFusion::GetDevicesLimit()];
+    m_deviceOffsetRotations = new glm::quat[CHandFusion::GetDevicesLimit()];
+    for(size_t i = 0U; i < CHandFusion::GetDevicesLimit(); i++)
+    {
+        m_devices[i] = nullptr;
+        m_deviceIds[i] = 0U;
+        m_deviceOffsets[i] = glm::vec3(0.f);
+        m_deviceOffsetRotations[i] = glm::quat(1.f, 0.f, 0.f, 0.f);
+    }
+    m_devicesCount = 0U;
+
+    m_handFusion = new CHandFusion();
+    m_fusionDirty = false;
+    m_fusionMode = CDriverConfig::FM_None;
+
+    m_pollingMode = CDriverConfig::PM_Sleep;
+    m_pollingTimeout = 100U;
+    m_wakeupRate = 0U;
+    m_publishLatencyAverage = 0;
+    m_publishLatencyMax = 0;
+
+    m_interpolation = false;
+    m_interpolationMode = CDriverConfig::IM_Frame;
+    m_displayOffset = 0;
+    m_jitterAverage = 0.f;
+    m_jitterMax = 0.f;
+    m_frameStart = 0;
+    m_framePeriod = 0;
+
+    m_frameAgeHistogram = new CHistogram(100, 1000U); // Up to 100 ms
+    m_clockWindowStart = 0;
+    m_clockWindowOffset = 0;
+    m_clockOffsetSum = 0;
+    m_clockOffsetMinWindow = 0;
+    m_clockOffsetMaxWindow = 0;
+    m_clockOffsetCount = 0U;
+    m_clockOffsetMin = 0;
+    m_clockOffsetAverage = 0;
+    m_clockOffsetMax = 0;
+    m_clockDrift = 0.f;
+    m_frameAgeMin = 0;
+    m_frameAgeAverage = 0;
+    m_frameAgeP99 = 0;
+
+    m_threadPriority = CDriverConfig::TP_Normal;
+    m_threadRealtime = false;
+    m_threadAffinity = 0U;
+    m_schedulingDirty = false;
+    m_schedulingState = 0U;
+    m_realtimeHandle = nullptr;
+    m_wakeupHistogram = new CHistogram(10, 1000U); // Up to 10 ms
+    m_wakeupLatencyAverage = 0;
+    m_wakeupLatencyP99 = 0;
+    m_wakeupLatencyMax = 0;
 }
 
 CLeapPoller::~CLeapPoller()
 {
-    delete m_lastFrame;
+    delete m_frameBuffer;
+    delete m_interpolatedFrameBuffer;
+    delete m_frameHistory;
+    delete m_jitterMeter;
+    delete m_frameContinuity;
+    for(auto l_recorder : m_recorders) delete l_recorder;
+    delete m_replayReader;
+    delete m_replayNativeReader;
+    delete m_replayFrame;
+    delete m_handFusion;
+    delete m_frameAgeHistogram;
+    delete m_wakeupHistogram;
+    delete[]m_devices;
+    delete[]m_deviceIds;
+    delete[]m_deviceOffsets;
+    delete[]m_deviceOffsetRotations;
+    delete m_memoryPool;
 }
 
 bool CLeapPoller::Initialize()
@@ -32,8 +159,11 @@ bool CLeapPoller::Initialize()
             {
                 LeapSetAllocator(m_connection, &m_allocator);
                 LeapCreateClockRebaser(&m_clockSynchronizer);
-                m_lastFrame = new LEAP_TRACKING_EVENT();
-                m_newFrame = new LEAP_TRACKING_EVENT();
+                CreateBuffers();
+                m_connected = false;
+                m_serviceConnected = false;
+                m_reconnectTime = 0;
+                m_reconnectDelay = g_reconnectDelayMin;
                 m_active = true;
                 m_thread = new std::thread(&CLeapPoller::ThreadUpdate, this);
             }
@@ -49,31 +179,96 @@ bool CLeapPoller::Initialize()
     return m_active;
 }
 
+bool CLeapPoller::InitializeReplay(const std::string &f_path, unsigned char f_mode)
+{
+    if(!m_active)
+    {
+        // Own format is recognized by header, anything else is given to LeapC
+        m_replayNative = !m_replayReader->Open(f_path);
+        if(!m_replayNative || m_replayNativeReader->Open(f_path))
+        {
+            m_replayPending = ReadReplayFrame();
+            if(m_replayPending)
+            {
+                CreateBuffers();
+                m_replay = true;
+                m_replayMode = f_mode;
+                m_replayStart = GetHostTime();
+                m_replayOrigin = m_replayFrameTime;
+                m_replayClockOffset = m_replayFrame->GetEvent()->info.timestamp - m_replayFrameTime;
+                m_replaySpeed = m_replaySpeedRequest;
+                m_replaySteps = 0U;
+                m_replayFinished = false;
+                m_connected = true;
+                m_active = true;
+            }
+            else
+            {
+                m_replayReader->Close();
+                m_replayNativeReader->Close();
+            }
+        }
+    }
+
+    return m_active;
+}
+
 void CLeapPoller::Terminate()
 {
     if(m_active)
     {
         m_active = false;
-        m_thread->join();
-        m_thread = nullptr;
+        if(m_replay)
+        {
+            m_replayReader->Close();
+            m_replayNativeReader->Close();
+            m_replayPending = false;
+            m_replay = false;
+        }
+        else
+        {
+            m_thread->join();
+            m_thread = nullptr;
+            m_recorder.load()->Stop();
 
-        if(m_device) LeapCloseDevice(m_device);
-        LeapDestroyClockRebaser(m_clockSynchronizer);
-        LeapCloseConnection(m_connection);
-        LeapDestroyConnection(m_connection);
+            CloseDevices();
+            LeapDestroyClockRebaser(m_clockSynchronizer);
+            LeapCloseConnection(m_connection);
+            LeapDestroyConnection(m_connection);
 
-        m_connection = nullptr;
-        m_clockSynchronizer = nullptr;
-        m_interpolatedFrameBuffer.clear();
-        m_device = nullptr;
-        
-        delete m_lastFrame;
-        m_lastFrame = nullptr;
-        delete m_newFrame;
-        m_newFrame = nullptr;
+            m_connection = nullptr;
+            m_clockSynchronizer = nullptr;
+        }
+        m_connected = false;
+        DestroyBuffers();
     }
 }
 
+bool CLeapPoller::IsReplaying() const
+{
+    return m_replay;
+}
+
+bool CLeapPoller::IsReplayFinished() const
+{
+    return m_replayFinished;
+}
+
+uint64_t CLeapPoller::GetReplayedFramesCount() const
+{
+    return (m_replay ? GetProducedFramesCount() : 0U);
+}
+
+void CLeapPoller::StepReplay(uint32_t f_count)
+{
+    m_replaySteps += f_count;
+}
+
+void CLeapPoller::SetReplaySpeed(float f_speed)
+{
+    m_replaySpeedRequest = f_speed;
+}
+
 bool CLeapPoller::IsConnected() const
 {
     return m_connected;
@@ -81,104 +276,845 @@ bool CLeapPoller::IsConnected() const
 
 const LEAP_TRACKING_EVENT* CLeapPoller::GetInterpolatedFrame()
 {
-    LEAP_TRACKING_EVENT *l_result = nullptr;
+    const LEAP_TRACKING_EVENT *l_result = nullptr;
+    if(m_active) l_result = (m_replay ? m_frameBuffer : m_interpolatedFrameBuffer)->GetReadSlot().GetEvent();
+    return l_result;
+}
+
+const LEAP_TRACKING_EVENT* CLeapPoller::GetFrame()
+{
+    const LEAP_TRACKING_EVENT *l_result = nullptr;
+    if(m_active) l_result = m_frameBuffer->GetReadSlot().GetEvent();
+    return l_result;
+}
+
+unsigned char CLeapPoller::GetFramesAtTime(int64_t f_hostTime, CLeapFrame &f_before, CLeapFrame &f_after)
+{
+    unsigned char l_result = CFrameHistory::BR_None;
     if(m_active)
     {
-        if(!m_interpolatedFrameBuffer.empty()) l_result = reinterpret_cast<LEAP_TRACKING_EVENT*>(m_interpolatedFrameBuffer.data());
+        int64_t l_leapTime = 0;
+        if(m_replay) l_result = m_frameHistory->GetBracket(GetReplayTime(f_hostTime), f_before, f_after);
+        else if(LeapRebaseClock(m_clockSynchronizer, f_hostTime, &l_leapTime) == eLeapRS_Success) l_result = m_frameHistory->GetBracket(l_leapTime, f_before, f_after);
     }
     return l_result;
 }
 
-const LEAP_TRACKING_EVENT* CLeapPoller::GetFrame()
+const CFrameHistory* CLeapPoller::GetFrameHistory() const
 {
-    LEAP_TRACKING_EVENT *l_result = nullptr;
-    if(m_active) l_result = m_lastFrame;
-    return l_result;
+    return m_frameHistory;
+}
+
+const CFrameContinuity* CLeapPoller::GetFrameContinuity() const
+{
+    return m_frameContinuity;
+}
+
+int64_t CLeapPoller::GetFrameStartTime() const
+{
+    return m_frameStart;
+}
+
+uint64_t CLeapPoller::GetProducedFramesCount() const
+{
+    return (m_frameBuffer ? m_frameBuffer->GetProducedCount() : 0U);
+}
+
+uint64_t CLeapPoller::GetConsumedFramesCount() const
+{
+    return (m_frameBuffer ? m_frameBuffer->GetConsumedCount() : 0U);
+}
+
+uint64_t CLeapPoller::GetOverwrittenFramesCount() const
+{
+    return (m_frameBuffer ? m_frameBuffer->GetOverwrittenCount() : 0U);
+}
+
+const CMemoryPool* CLeapPoller::GetMemoryPool() const
+{
+    return m_memoryPool;
 }
 
 void CLeapPoller::SetPolicy(uint64_t f_set, uint64_t f_clear)
 {
-    if(m_active) LeapSetPolicyFlags(m_connection, f_set, f_clear);
+    // Requests are accumulated, latest one wins for each flag
+    m_policySet.fetch_and(~f_clear);
+    m_policySet.fetch_or(f_set);
+    m_policyClear.fetch_and(~f_set);
+    m_policyClear.fetch_or(f_clear & ~f_set);
+    m_policyDirty = true;
 }
 
 void CLeapPoller::SetPaused(bool f_state)
 {
-    if(m_active) LeapSetPause(m_connection, f_state);
+    m_paused = f_state;
+    m_pauseDirty = true;
+}
+
+void CLeapPoller::SetPollingMode(unsigned char f_mode, uint32_t f_timeout)
+{
+    m_pollingMode = f_mode;
+    m_pollingTimeout = f_timeout;
+}
+
+void CLeapPoller::SetInterpolation(bool f_state, unsigned char f_mode)
+{
+    m_interpolation = f_state;
+    m_interpolationMode = f_mode;
+}
+
+void CLeapPoller::SetDisplayOffset(int64_t f_offset)
+{
+    m_displayOffset = f_offset;
+}
+
+void CLeapPoller::SetFusionMode(unsigned char f_mode)
+{
+    m_fusionMode = f_mode;
+    m_fusionDirty = true;
+}
+
+void CLeapPoller::SetDeviceExtrinsics(size_t f_device, const glm::vec3 &f_offset, const glm::quat &f_rotation)
+{
+    if(f_device < CHandFusion::GetDevicesLimit())
+    {
+        std::lock_guard<std::mutex> l_guard(m_fusionLock);
+        m_deviceOffsets[f_device] = f_offset;
+        m_deviceOffsetRotations[f_device] = f_rotation;
+        m_fusionDirty = true;
+    }
+}
+
+int64_t CLeapPoller::GetClockOffsetMin() const
+{
+    return m_clockOffsetMin;
+}
+
+int64_t CLeapPoller::GetClockOffsetAverage() const
+{
+    return m_clockOffsetAverage;
+}
+
+int64_t CLeapPoller::GetClockOffsetMax() const
+{
+    return m_clockOffsetMax;
+}
+
+float CLeapPoller::GetClockDrift() const
+{
+    return m_clockDrift;
+}
+
+int64_t CLeapPoller::GetFrameAgeMin() const
+{
+    return m_frameAgeMin;
+}
+
+int64_t CLeapPoller::GetFrameAgeAverage() const
+{
+    return m_frameAgeAverage;
+}
+
+int64_t CLeapPoller::GetFrameAgeP99() const
+{
+    return m_frameAgeP99;
+}
+
+int64_t CLeapPoller::GetHostTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint32_t CLeapPoller::GetDevicesCount() const
+{
+    return m_devicesCount;
+}
+
+uint32_t CLeapPoller::GetReconnectsCount() const
+{
+    return m_reconnectsCount;
+}
+
+void CLeapPoller::StartRecording(const std::string &f_path, unsigned char f_format)
+{
+    std::lock_guard<std::mutex> l_guard(m_recordingLock);
+    m_recordingPath.assign(f_path);
+    m_recordingFormat = f_format;
+    m_recordingRequest = true;
+    m_recordingDirty = true;
+}
+
+void CLeapPoller::StopRecording()
+{
+    m_recordingRequest = false;
+    m_recordingDirty = true;
+}
+
+const CSessionRecorder* CLeapPoller::GetRecorder() const
+{
+    return m_recorder.load();
+}
+
+void CLeapPoller::SetScheduling(unsigned char f_priority, bool f_realtime, uint64_t f_affinity)
+{
+    m_threadPriority = f_priority;
+    m_threadRealtime = f_realtime;
+    m_threadAffinity = f_affinity;
+    m_schedulingDirty = true;
+}
+
+unsigned char CLeapPoller::GetSchedulingState() const
+{
+    return m_schedulingState;
+}
+
+int64_t CLeapPoller::GetWakeupLatencyAverage() const
+{
+    return m_wakeupLatencyAverage;
+}
+
+int64_t CLeapPoller::GetWakeupLatencyP99() const
+{
+    return m_wakeupLatencyP99;
+}
+
+int64_t CLeapPoller::GetWakeupLatencyMax() const
+{
+    return m_wakeupLatencyMax;
+}
+
+uint32_t CLeapPoller::GetWakeupRate() const
+{
+    return m_wakeupRate;
+}
+
+int64_t CLeapPoller::GetPublishLatencyAverage() const
+{
+    return m_publishLatencyAverage;
+}
+
+int64_t CLeapPoller::GetPublishLatencyMax() const
+{
+    return m_publishLatencyMax;
+}
+
+float CLeapPoller::GetJitterAverage() const
+{
+    return m_jitterAverage;
+}
+
+float CLeapPoller::GetJitterMax() const
+{
+    return m_jitterMax;
 }
 
 void CLeapPoller::Update()
 {
-    if(m_active)
+    if(m_active && m_replay) UpdateReplay(GetHostTime());
+    else if(m_active)
     {
-        LeapUpdateRebase(m_clockSynchronizer, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count(), LeapGetNow());
+        // Monotonic clock, system clock can jump
+        const int64_t l_hostTime = GetHostTime();
+        const int64_t l_leapTime = LeapGetNow();
+        LeapUpdateRebase(m_clockSynchronizer, l_hostTime, l_leapTime);
 
-        if(m_frameLock.try_lock())
+        // Track RunFrame cadence in Leap clock for poller thread to interpolate ahead of it
+        int64_t l_frameStart = 0;
+        if(LeapRebaseClock(m_clockSynchronizer, l_hostTime, &l_frameStart) == eLeapRS_Success)
         {
-            std::memcpy(m_lastFrame, m_newFrame, sizeof(LEAP_TRACKING_EVENT));
-            m_frameLock.unlock();
+            const int64_t l_lastFrameStart = m_frameStart;
+            if(l_lastFrameStart > 0)
+            {
+                const int64_t l_period = l_frameStart - l_lastFrameStart;
+                const int64_t l_lastPeriod = m_framePeriod;
+                if((l_period > 0) && (l_period < g_framePeriodLimit)) m_framePeriod = ((l_lastPeriod > 0) ? ((l_lastPeriod * 7 + l_period) / 8) : l_period);
+            }
+            m_frameStart = l_frameStart;
         }
 
-        LEAP_CONNECTION_INFO l_info;
-        if(LeapGetConnectionInfo(m_connection, &l_info) == eLeapRS_Success) m_connected = (l_info.status == eLeapConnectionStatus_Connected);
-        else m_connected = false;
+        if(m_frameBuffer->Acquire() && (l_frameStart > 0)) m_frameAgeHistogram->Add(l_frameStart - m_frameBuffer->GetReadSlot().GetEvent()->info.timestamp);
+        if(m_interpolation) m_interpolatedFrameBuffer->Acquire();
+        UpdateClockStatistics(l_hostTime, l_leapTime);
     }
 }
 
+// Called from RunFrame thread only, fast mode publishes one frame per update
+void CLeapPoller::UpdateReplay(int64_t f_hostTime)
+{
+    // Speed change continues from current position
+    const float l_speed = m_replaySpeedRequest;
+    if(l_speed != m_replaySpeed)
+    {
+        m_replayOrigin = GetReplayTime(f_hostTime) - m_replayClockOffset;
+        m_replayStart = f_hostTime;
+        m_replaySpeed = l_speed;
+    }
+
+    bool l_published = false;
+    while(m_replayPending)
+    {
+        bool l_due = false;
+        switch(m_replayMode)
+        {
+            case RM_Realtime:
+                l_due = ((m_replayFrameTime + m_replayClockOffset) <= GetReplayTime(f_hostTime));
+                break;
+            case RM_Fast:
+                l_due = !l_published;
+                break;
+            case RM_Step:
+            {
+                uint32_t l_steps = m_replaySteps;
+                while((l_steps > 0U) && !m_replaySteps.compare_exchange_weak(l_steps, l_steps - 1U));
+                l_due = (l_steps > 0U);
+            } break;
+        }
+        if(!l_due) break;
+
+        const LEAP_TRACKING_EVENT *l_event = m_replayFrame->GetEvent();
+        m_frameContinuity->Add(l_event, l_event->info.timestamp);
+        PublishFrame(l_event);
+        m_latestFrameTime = l_event->info.timestamp;
+        l_published = true;
+
+        m_replayPending = ReadReplayFrame();
+    }
+    if(!m_replayPending) m_replayFinished = true;
+
+    // Frame start follows recorded clock in realtime mode and latest frame otherwise
+    if(m_replayMode == RM_Realtime) m_frameStart = GetReplayTime(f_hostTime);
+    else m_frameStart = m_latestFrameTime;
+    m_frameBuffer->Acquire();
+}
+
+int64_t CLeapPoller::GetReplayTime(int64_t f_hostTime) const
+{
+    return (static_cast<int64_t>(static_cast<double>(f_hostTime - m_replayStart) * m_replaySpeed) + m_replayOrigin + m_replayClockOffset);
+}
+
+bool CLeapPoller::ReadReplayFrame()
+{
+    return (m_replayNative ? m_replayNativeReader->Read(*m_replayFrame, m_replayFrameTime) : m_replayReader->Read(*m_replayFrame, m_replayFrameTime));
+}
+
+void CLeapPoller::CreateBuffers()
+{
+    m_frameBuffer = new CTripleBuffer<CLeapFrame>();
+    m_interpolatedFrameBuffer = new CTripleBuffer<CLeapFrame>();
+    m_interpolationBuffer.resize(sizeof(LEAP_TRACKING_EVENT) + sizeof(LEAP_HAND) * CLeapFrame::GetHandsLimit());
+    m_frameHistory->Clear();
+    m_interpolationTime = 0;
+    m_latestFrameTime = 0;
+    m_jitterMeter->Restart();
+    m_frameContinuity->Reset();
+    m_frameStart = 0;
+    m_framePeriod = 0;
+    m_frameAgeHistogram->Reset();
+    m_clockWindowStart = 0;
+}
+
+void CLeapPoller::DestroyBuffers()
+{
+    m_interpolationBuffer.clear();
+
+    delete m_frameBuffer;
+    m_frameBuffer = nullptr;
+    delete m_interpolatedFrameBuffer;
+    m_interpolatedFrameBuffer = nullptr;
+}
+
+// Called from poller thread only
 void CLeapPoller::UpdateInterpolation()
 {
-    if(m_active)
+    const int64_t l_framePeriod = m_framePeriod;
+    if(l_framePeriod > 0)
+    {
+        const int64_t l_now = LeapGetNow();
+        int64_t l_deadline = m_frameStart + l_framePeriod;
+        if((l_now - l_deadline) > l_framePeriod) l_deadline += ((l_now - l_deadline) / l_framePeriod) * l_framePeriod; // RunFrame stalled, skip missed ones
+
+        if((l_deadline != m_interpolationTime) && (l_now >= (l_deadline - g_interpolationLead)))
+        {
+            // Split mode takes pose at display time and hand shape from latest real frame
+            const bool l_split = ((m_interpolationMode == CDriverConfig::IM_Split) && (m_latestFrameTime > 0));
+            const int64_t l_poseTime = (l_split ? (l_deadline + m_displayOffset) : l_deadline);
+
+            uint64_t l_targetFrameSize = 0U;
+            if(LeapGetFrameSize(m_connection, l_poseTime, &l_targetFrameSize) == eLeapRS_Success)
+            {
+                // Buffer fits hands limit from start, grows only for unexpectedly large frames
+                if(l_targetFrameSize > m_interpolationBuffer.size()) m_interpolationBuffer.resize(static_cast<size_t>(l_targetFrameSize));
+
+                LEAP_TRACKING_EVENT *l_event = reinterpret_cast<LEAP_TRACKING_EVENT*>(m_interpolationBuffer.data());
+                const eLeapRS l_result = (l_split ? LeapInterpolateFrameFromTime(m_connection, l_poseTime, m_latestFrameTime, l_event, l_targetFrameSize) : LeapInterpolateFrame(m_connection, l_poseTime, l_event, l_targetFrameSize));
+                if(l_result == eLeapRS_Success)
+                {
+                    m_interpolatedFrameBuffer->GetWriteSlot().CopyEvent(l_event);
+                    m_interpolatedFrameBuffer->Publish();
+
+                    if(l_event->nHands > 0U)
+                    {
+                        glm::vec3 l_position;
+                        ConvertVector3(l_event->pHands[0U].palm.position, l_position);
+                        m_jitterMeter->Add(l_event->pHands[0U].id, l_position);
+                    }
+                    else m_jitterMeter->Restart();
+                }
+            }
+            m_interpolationTime = l_deadline;
+        }
+    }
+}
+
+// Called from RunFrame thread only, publishes each second
+void CLeapPoller::UpdateClockStatistics(int64_t f_hostTime, int64_t f_leapTime)
+{
+    const int64_t l_offset = f_hostTime - f_leapTime;
+    if(m_clockWindowStart == 0)
+    {
+        m_clockWindowStart = f_hostTime;
+        m_clockWindowOffset = l_offset;
+        m_clockOffsetMinWindow = l_offset;
+        m_clockOffsetMaxWindow = l_offset;
+    }
+    m_clockOffsetSum += l_offset;
+    m_clockOffsetMinWindow = std::min(m_clockOffsetMinWindow, l_offset);
+    m_clockOffsetMaxWindow = std::max(m_clockOffsetMaxWindow, l_offset);
+    m_clockOffsetCount++;
+
+    const int64_t l_windowLength = f_hostTime - m_clockWindowStart;
+    if(l_windowLength >= 1000000)
+    {
+        m_clockOffsetMin = m_clockOffsetMinWindow;
+        m_clockOffsetAverage = m_clockOffsetSum / m_clockOffsetCount;
+        m_clockOffsetMax = m_clockOffsetMaxWindow;
+        m_clockDrift = static_cast<float>(l_offset - m_clockWindowOffset) * 1000000.f / static_cast<float>(l_windowLength);
+
+        m_frameAgeMin = m_frameAgeHistogram->GetMin();
+        m_frameAgeAverage = m_frameAgeHistogram->GetAverage();
+        m_frameAgeP99 = m_frameAgeHistogram->GetPercentile(99.f);
+        m_frameAgeHistogram->Reset();
+
+        m_clockWindowStart = f_hostTime;
+        m_clockWindowOffset = l_offset;
+        m_clockOffsetSum = 0;
+        m_clockOffsetMinWindow = l_offset;
+        m_clockOffsetMaxWindow = l_offset;
+        m_clockOffsetCount = 0U;
+    }
+}
+
+// Called from poller thread only
+void CLeapPoller::UpdateScheduling()
+{
+    // Thread stays pinned if previous affinity can't be restored
+    const unsigned char l_previousState = m_schedulingState;
+    ResetScheduling();
+
+    unsigned char l_state = 0U;
+#ifdef _WIN32
+    const HANDLE l_thread = GetCurrentThread();
+    if(m_threadRealtime)
+    {
+        // MMCSS doesn't need administrator rights, time critical priority is used if service refuses
+        DWORD l_taskIndex = 0U;
+        m_realtimeHandle = AvSetMmThreadCharacteristicsA("Pro Audio", &l_taskIndex);
+        if(m_realtimeHandle)
+        {
+            if(AvSetMmThreadPriority(m_realtimeHandle, AVRT_PRIORITY_HIGH)) l_state |= SS_Realtime;
+            else
+            {
+                // Thread isn't left registered in task that doesn't apply
+                AvRevertMmThreadCharacteristics(m_realtimeHandle);
+                m_realtimeHandle = nullptr;
+            }
+        }
+        if(!m_realtimeHandle && SetThreadPriority(l_thread, THREAD_PRIORITY_TIME_CRITICAL)) l_state |= SS_Realtime;
+    }
+    if(!(l_state & SS_Realtime))
+    {
+        int l_priority = THREAD_PRIORITY_NORMAL;
+        switch(m_threadPriority)
+        {
+            case CDriverConfig::TP_High:
+                l_priority = THREAD_PRIORITY_ABOVE_NORMAL;
+                break;
+            case CDriverConfig::TP_Highest:
+                l_priority = THREAD_PRIORITY_HIGHEST;
+                break;
+        }
+        if(SetThreadPriority(l_thread, l_priority)) l_state |= SS_Priority;
+    }
+
+    const uint64_t l_affinity = m_threadAffinity;
+    if(l_affinity != 0U)
+    {
+        if(SetThreadAffinityMask(l_thread, static_cast<DWORD_PTR>(l_affinity)) != 0U) l_state |= SS_Affinity;
+    }
+    else
+    {
+        DWORD_PTR l_processMask = 0U;
+        DWORD_PTR l_systemMask = 0U;
+        if(!GetProcessAffinityMask(GetCurrentProcess(), &l_processMask, &l_systemMask) || (SetThreadAffinityMask(l_thread, l_processMask) == 0U)) l_state |= (l_previousState & SS_Affinity);
+    }
+#else
+    const pthread_t l_thread = pthread_self();
+    if(m_threadRealtime)
+    {
+        sched_param l_param = { 0 };
+        l_param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 1;
+        if(pthread_setschedparam(l_thread, SCHED_FIFO, &l_param) == 0) l_state |= SS_Realtime;
+    }
+    if(!(l_state & SS_Realtime))
+    {
+        // Nice value is per thread on Linux, raised priorities need CAP_SYS_NICE or RLIMIT_NICE
+        int l_nice = 0;
+        switch(m_threadPriority)
+        {
+            case CDriverConfig::TP_High:
+                l_nice = -5;
+                break;
+            case CDriverConfig::TP_Highest:
+                l_nice = -10;
+                break;
+        }
+        sched_param l_param = { 0 };
+        if((pthread_setschedparam(l_thread, SCHED_OTHER, &l_param) == 0) && (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), l_nice) == 0)) l_state |= SS_Priority;
+    }
+
+    const uint64_t l_affinity = m_threadAffinity;
+    if(l_affinity != 0U)
+    {
+        cpu_set_t l_cpuSet;
+        CPU_ZERO(&l_cpuSet);
+        for(size_t i = 0U; i < 64U; i++)
+        {
+            if(l_affinity & (static_cast<uint64_t>(1U) << i)) CPU_SET(i, &l_cpuSet);
+        }
+        if(pthread_setaffinity_np(l_thread, sizeof(cpu_set_t), &l_cpuSet) == 0) l_state |= SS_Affinity;
+    }
+    else
+    {
+        // Mask of main thread is mask of process
+        cpu_set_t l_processSet;
+        CPU_ZERO(&l_processSet);
+        if((sched_getaffinity(getpid(), sizeof(cpu_set_t), &l_processSet) != 0) || (pthread_setaffinity_np(l_thread, sizeof(cpu_set_t), &l_processSet) != 0)) l_state |= (l_previousState & SS_Affinity);
+    }
+#endif
+    m_schedulingState = l_state;
+}
+
+// Called from poller thread only
+void CLeapPoller::ResetScheduling()
+{
+#ifdef _WIN32
+    if(m_realtimeHandle)
+    {
+        AvRevertMmThreadCharacteristics(m_realtimeHandle);
+        m_realtimeHandle = nullptr;
+    }
+#endif
+    m_schedulingState = 0U;
+}
+
+// Called from poller thread only, keeps slots of still connected devices
+void CLeapPoller::UpdateDevices()
+{
+    uint32_t l_count = 0U;
+    std::vector<LEAP_DEVICE_REF> l_refs;
+    if(LeapGetDeviceList(m_connection, nullptr, &l_count) == eLeapRS_Success)
+    {
+        l_refs.resize(l_count);
+        if((l_count == 0U) || (LeapGetDeviceList(m_connection, l_refs.data(), &l_count) != eLeapRS_Success)) l_count = 0U;
+    }
+
+    for(size_t i = 0U; i < CHandFusion::GetDevicesLimit(); i++)
+    {
+        if(!m_devices[i]) continue;
+
+        bool l_found = false;
+        for(uint32_t j = 0U; j < l_count; j++) l_found = (l_found || (l_refs[j].id == m_deviceIds[i]));
+        if(!l_found)
+        {
+            LeapCloseDevice(m_devices[i]);
+            m_devices[i] = nullptr;
+            m_deviceIds[i] = 0U;
+            m_handFusion->RemoveDevice(i);
+        }
+    }
+
+    for(uint32_t i = 0U; i < l_count; i++)
+    {
+        bool l_opened = false;
+        for(size_t j = 0U; j < CHandFusion::GetDevicesLimit(); j++) l_opened = (l_opened || (m_devices[j] && (m_deviceIds[j] == l_refs[i].id)));
+        if(l_opened) continue;
+
+        for(size_t j = 0U; j < CHandFusion::GetDevicesLimit(); j++)
+        {
+            if(!m_devices[j])
+            {
+                if(LeapOpenDevice(l_refs[i], &m_devices[j]) == eLeapRS_Success) m_deviceIds[j] = l_refs[i].id;
+                else m_devices[j] = nullptr;
+                break;
+            }
+        }
+    }
+
+    uint32_t l_opened = 0U;
+    for(size_t i = 0U; i < CHandFusion::GetDevicesLimit(); i++)
+    {
+        if(m_devices[i]) l_opened++;
+    }
+    m_devicesCount = l_opened;
+}
+
+// Called from poller thread only, or after it has been joined
+void CLeapPoller::CloseDevices()
+{
+    for(size_t i = 0U; i < CHandFusion::GetDevicesLimit(); i++)
+    {
+        if(m_devices[i]) LeapCloseDevice(m_devices[i]);
+        m_devices[i] = nullptr;
+        m_deviceIds[i] = 0U;
+        m_handFusion->RemoveDevice(i);
+    }
+    m_devicesCount = 0U;
+}
+
+// Called from poller thread only
+void CLeapPoller::UpdateConnectionState()
+{
+    m_connected = (m_serviceConnected && (m_devicesCount > 0U));
+}
+
+// Called from poller thread only, keeps already scheduled attempt
+void CLeapPoller::ScheduleReconnect()
+{
+    if(m_reconnectTime == 0) m_reconnectTime = GetHostTime() + m_reconnectDelay;
+}
+
+// Called from poller thread only, service confirms with connection event
+void CLeapPoller::Reconnect()
+{
+    CloseDevices();
+    LeapCloseConnection(m_connection);
+    if(LeapOpenConnection(m_connection) == eLeapRS_Success) LeapSetAllocator(m_connection, &m_allocator);
+    m_reconnectsCount++;
+
+    m_reconnectDelay = std::min(m_reconnectDelay * 2, g_reconnectDelayMax);
+    m_reconnectTime = GetHostTime() + m_reconnectDelay;
+}
+
+// Called from poller thread only, forced after connection to restore state on service side
+void CLeapPoller::ApplyRequests(bool f_force)
+{
+    if(m_policyDirty.exchange(false) || f_force) LeapSetPolicyFlags(m_connection, m_policySet, m_policyClear);
+    if(m_pauseDirty.exchange(false) || f_force) LeapSetPause(m_connection, m_paused);
+}
+
+// Called from poller thread only, recorder that still drains previous session is left to its writer and idle one is started
+void CLeapPoller::UpdateRecording()
+{
+    m_recorder.load()->Stop();
+    if(m_recordingRequest)
     {
-        int64_t l_targetFrameTime = 0;
-        uint64_t l_targetFrameSize = 0U;
-        LeapRebaseClock(m_clockSynchronizer, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count(), &l_targetFrameTime);
+        std::lock_guard<std::mutex> l_guard(m_recordingLock);
+        CSessionRecorder *l_idle = nullptr;
+        bool l_pathBusy = false;
+        for(auto l_recorder : m_recorders)
+        {
+            if(l_recorder->IsWriting()) l_pathBusy = (l_pathBusy || (l_recorder->GetPath() == m_recordingPath));
+            else if(!l_idle) l_idle = l_recorder;
+        }
 
-        if(LeapGetFrameSize(m_connection, l_targetFrameTime, &l_targetFrameSize) == eLeapRS_Success)
+        // Previous session to same file has to be closed first, start is retried on next poller iteration
+        if(l_pathBusy) m_recordingDirty = true;
+        else
         {
-            // Weird SDK requires weird solutions
-            m_interpolatedFrameBuffer.resize(static_cast<size_t>(l_targetFrameSize));
-            LeapInterpolateFrame(m_connection, l_targetFrameTime, reinterpret_cast<LEAP_TRACKING_EVENT*>(m_interpolatedFrameBuffer.data()), l_targetFrameSize);
+            if(!l_idle)
+            {
+                l_idle = new CSessionRecorder();
+                m_recorders.push_back(l_idle);
+            }
+            l_idle->Start(m_recordingPath, m_recordingFormat);
+            m_recorder = l_idle;
         }
     }
 }
 
+// Called from poller thread only
+void CLeapPoller::PublishFrame(const LEAP_TRACKING_EVENT *f_event)
+{
+    STAGE_TIMER(CFrameProfiler::FS_PollerCopy);
+    if(m_fusionDirty.exchange(false))
+    {
+        std::lock_guard<std::mutex> l_guard(m_fusionLock);
+        m_handFusion->SetMode(m_fusionMode);
+        for(size_t i = 0U; i < CHandFusion::GetDevicesLimit(); i++) m_handFusion->SetExtrinsics(i, m_deviceOffsets[i], m_deviceOffsetRotations[i]);
+    }
+
+    // Hands are copied out, SDK memory is invalidated by next poll
+    CLeapFrame &l_frame = m_frameBuffer->GetWriteSlot();
+    if(m_fusionMode != CDriverConfig::FM_None)
+    {
+        // LeapC tracking events carry no device, they belong to service's streaming device in first occupied slot
+        size_t l_device = 0U;
+        for(size_t i = 0U; i < CHandFusion::GetDevicesLimit(); i++)
+        {
+            if(m_devices[i])
+            {
+                l_device = i;
+                break;
+            }
+        }
+        m_handFusion->UpdateDevice(l_device, f_event);
+        m_handFusion->Fuse(f_event->info.timestamp, l_frame);
+    }
+    else l_frame.CopyEvent(f_event);
+    m_frameHistory->Push(l_frame.GetEvent());
+    m_frameBuffer->Publish();
+}
+
+// Called from poller thread only, blocks not longer than next interpolation point
+uint32_t CLeapPoller::GetPollingTimeout() const
+{
+    uint32_t l_result = m_pollingTimeout;
+    const int64_t l_framePeriod = m_framePeriod;
+    if(m_interpolation && (l_framePeriod > 0))
+    {
+        int64_t l_wait = (m_frameStart + l_framePeriod - g_interpolationLead) - LeapGetNow();
+        if(l_wait <= 0) l_wait += l_framePeriod;
+        l_result = std::min(l_result, std::max(static_cast<uint32_t>(l_wait / 1000), 1U));
+    }
+    return l_result;
+}
+
 void CLeapPoller::ThreadUpdate()
 {
     const std::chrono::milliseconds l_threadDelay(1U);
+
+    uint32_t l_wakeups = 0U;
+    uint32_t l_published = 0U;
+    int64_t l_latencySum = 0;
+    int64_t l_latencyMax = 0;
+    int64_t l_windowStart = LeapGetNow();
+    m_wakeupHistogram->Reset();
+
+    m_schedulingDirty = false;
+    UpdateScheduling();
+
     while(m_active)
     {
+        if(m_schedulingDirty.exchange(false)) UpdateScheduling();
+        if(m_serviceConnected) ApplyRequests(false);
+        if(m_recordingDirty.exchange(false)) UpdateRecording();
+
+        // Event mode blocks in service call and wakes up only on new message or timeout
+        const bool l_eventMode = (m_pollingMode == CDriverConfig::PM_Event);
+        const uint32_t l_timeout = (l_eventMode ? GetPollingTimeout() : 0U);
+
         // Poll events
         LEAP_CONNECTION_MESSAGE l_message;
-        while(LeapPollConnection(m_connection, 0U, &l_message) == eLeapRS_Success)
+        eLeapRS l_pollResult = eLeapRS_Success;
+        const int64_t l_pollStart = GetHostTime();
+        while(m_active)
         {
+            {
+                STAGE_TIMER(CFrameProfiler::FS_PollerPoll);
+                l_pollResult = LeapPollConnection(m_connection, l_timeout, &l_message);
+            }
+            // Timeouts and failures wake thread too
+            if(l_eventMode) l_wakeups++;
+            if(l_pollResult != eLeapRS_Success) break;
+
             if(l_message.type == eLeapEventType_None) break;
             switch(l_message.type)
             {
-                case eLeapEventType_Device:
+                case eLeapEventType_Connection:
                 {
-                    if(!m_device)
-                    {
-                        if(LeapOpenDevice(l_message.device_event->device, &m_device) != eLeapRS_Success) m_device = nullptr;
-                    }
+                    m_serviceConnected = true;
+                    m_reconnectTime = 0;
+                    m_reconnectDelay = g_reconnectDelayMin;
+                    ApplyRequests(true);
+                    UpdateDevices();
+                    UpdateConnectionState();
+                } break;
+                case eLeapEventType_ConnectionLost:
+                {
+                    m_serviceConnected = false;
+                    UpdateConnectionState();
+                    ScheduleReconnect();
+                } break;
+                case eLeapEventType_Device: case eLeapEventType_DeviceLost:
+                {
+                    UpdateDevices();
+                    UpdateConnectionState();
                 } break;
                 case eLeapEventType_Tracking:
                 {
-                    m_frameLock.lock();
-                    std::memcpy(m_newFrame, l_message.tracking_event, sizeof(LEAP_TRACKING_EVENT));
-                    m_frameLock.unlock();
+                    m_frameContinuity->Add(l_message.tracking_event, LeapGetNow());
+                    CSessionRecorder *l_recorder = m_recorder;
+                    if(l_recorder->IsRecording()) l_recorder->Push(l_message.tracking_event, GetHostTime());
+                    PublishFrame(l_message.tracking_event);
+                    m_latestFrameTime = l_message.tracking_event->info.timestamp;
+
+                    const int64_t l_latency = LeapGetNow() - l_message.tracking_event->info.timestamp;
+                    l_latencySum += l_latency;
+                    l_latencyMax = std::max(l_latencyMax, l_latency);
+                    l_published++;
                 } break;
             }
+
+            if(l_eventMode) break; // Timeout is recalculated for next interpolation point
         }
+        if(l_eventMode && (l_pollResult == eLeapRS_Timeout)) m_wakeupHistogram->Add(GetHostTime() - l_pollStart - static_cast<int64_t>(l_timeout) * 1000);
 
-        std::this_thread::sleep_for(l_threadDelay);
-    }
-}
+        // Failing poll returns immediately, connection is considered lost and reopened with backoff
+        const bool l_pollFailed = ((l_pollResult != eLeapRS_Success) && (l_pollResult != eLeapRS_Timeout));
+        if(l_pollFailed && m_serviceConnected)
+        {
+            m_serviceConnected = false;
+            UpdateConnectionState();
+        }
+        if(!m_serviceConnected)
+        {
+            ScheduleReconnect();
+            if(GetHostTime() >= m_reconnectTime) Reconnect();
+        }
+        if(l_eventMode && l_pollFailed) std::this_thread::sleep_for(l_threadDelay);
 
-void* CLeapPoller::AllocateMemory(uint32_t size, eLeapAllocatorType typeHint, void *state)
-{
-    return new uint8_t[size];
-}
+        if(m_interpolation) UpdateInterpolation();
 
-void CLeapPoller::DeallocateMemory(void *ptr, void *state)
-{
-    delete[]reinterpret_cast<uint8_t*>(ptr);
+        if(!l_eventMode)
+        {
+            const int64_t l_sleepStart = GetHostTime();
+            std::this_thread::sleep_for(l_threadDelay);
+            m_wakeupHistogram->Add(GetHostTime() - l_sleepStart - std::chrono::duration_cast<std::chrono::microseconds>(l_threadDelay).count());
+            l_wakeups++;
+        }
+
+        const int64_t l_now = LeapGetNow();
+        const int64_t l_windowLength = l_now - l_windowStart;
+        if(l_windowLength >= 1000000)
+        {
+            m_wakeupRate = static_cast<uint32_t>((static_cast<int64_t>(l_wakeups) * 1000000) / l_windowLength);
+            m_publishLatencyAverage = ((l_published > 0U) ? (l_latencySum / l_published) : 0);
+            m_publishLatencyMax = l_latencyMax;
+            m_jitterAverage = m_jitterMeter->GetAverage();
+            m_jitterMax = m_jitterMeter->GetMax();
+            m_jitterMeter->ResetWindow();
+            m_wakeupLatencyAverage = m_wakeupHistogram->GetAverage();
+            m_wakeupLatencyP99 = m_wakeupHistogram->GetPercentile(99.f);
+            m_wakeupLatencyMax = m_wakeupHistogram->GetMax();
+            m_wakeupHistogram->Reset();
+
+            l_wakeups = 0U;
+            l_published = 0U;
+            l_latencySum = 0;
+            l_latencyMax = 0;
+            l_windowStart = l_now;
+        }
+    }
+
+    ResetScheduling();
 }
@@ -1,40 +1,241 @@
 #pragma once
 
-class CLeapPoller
+#include "Core/CTrackingSource.h"
+
+class CFrameContinuity;
+class CFrameHistory;
+class CHandFusion;
+class CHistogram;
+class CLeapFrame;
+class CJitterMeter;
+class CMemoryPool;
+class CNativeSessionReader;
+class CSessionReader;
+class CSessionRecorder;
+template<class T> class CTripleBuffer;
+
+class CLeapPoller final : public CTrackingSource
 {
+    enum SchedulingState : unsigned char
+    {
+        SS_Priority = 0x01U,
+        SS_Realtime = 0x02U,
+        SS_Affinity = 0x04U
+    };
+
     std::atomic<bool> m_active;
-    std::mutex m_frameLock;
     std::thread *m_thread;
 
     LEAP_CONNECTION m_connection;
     LEAP_CLOCK_REBASER m_clockSynchronizer;
     LEAP_ALLOCATOR m_allocator;
-    LEAP_TRACKING_EVENT *m_lastFrame;
-    LEAP_TRACKING_EVENT *m_newFrame;
-    std::vector<uint8_t> m_interpolatedFrameBuffer;
-    LEAP_DEVICE m_device;
-    bool m_connected;
+    CMemoryPool *m_memoryPool;
+    CTripleBuffer<CLeapFrame> *m_frameBuffer;
+    CTripleBuffer<CLeapFrame> *m_interpolatedFrameBuffer;
+    CFrameHistory *m_frameHistory;
+    std::vector<uint8_t> m_interpolationBuffer; // Owned by poller thread
+    int64_t m_interpolationTime; // Owned by poller thread
+    int64_t m_latestFrameTime; // Owned by poller thread
+    CJitterMeter *m_jitterMeter; // Owned by poller thread
+    CFrameContinuity *m_frameContinuity; // Updated by poller thread
+    LEAP_DEVICE *m_devices; // Owned by poller thread
+    uint32_t *m_deviceIds; // Owned by poller thread
+    std::atomic<uint32_t> m_devicesCount;
+    std::atomic<bool> m_connected;
 
-    void ThreadUpdate();
+    bool m_serviceConnected; // Owned by poller thread
+    int64_t m_reconnectTime; // Owned by poller thread
+    int64_t m_reconnectDelay; // Owned by poller thread
+    std::atomic<uint32_t> m_reconnectsCount;
+    std::atomic<uint64_t> m_policySet;
+    std::atomic<uint64_t> m_policyClear;
+    std::atomic<bool> m_policyDirty;
+    std::atomic<bool> m_paused;
+    std::atomic<bool> m_pauseDirty;
+
+    std::atomic<CSessionRecorder*> m_recorder; // Current one, controlled by poller thread
+    std::vector<CSessionRecorder*> m_recorders; // Stopped ones can still drain their queues, used by poller thread only
+    std::mutex m_recordingLock;
+    std::string m_recordingPath; // Guarded by recording lock
+    unsigned char m_recordingFormat; // Guarded by recording lock
+    std::atomic<bool> m_recordingDirty;
+    std::atomic<bool> m_recordingRequest;
+
+    bool m_replay;
+    unsigned char m_replayMode;
+    CSessionReader *m_replayReader; // Owned by RunFrame thread
+    CNativeSessionReader *m_replayNativeReader; // Owned by RunFrame thread
+    bool m_replayNative;
+    CLeapFrame *m_replayFrame; // Read ahead, owned by RunFrame thread
+    int64_t m_replayFrameTime; // Recorded host time of read ahead frame
+    bool m_replayPending; // Owned by RunFrame thread
+    int64_t m_replayStart; // Owned by RunFrame thread
+    int64_t m_replayOrigin; // Owned by RunFrame thread
+    int64_t m_replayClockOffset; // Owned by RunFrame thread
+    float m_replaySpeed; // Owned by RunFrame thread
+    std::atomic<float> m_replaySpeedRequest;
+    std::atomic<uint32_t> m_replaySteps;
+    std::atomic<bool> m_replayFinished;
 
-    static void* AllocateMemory(uint32_t size, eLeapAllocatorType typeHint, void *state);
-    static void DeallocateMemory(void *ptr, void *state);
+    CHandFusion *m_handFusion; // Owned by poller thread
+    std::mutex m_fusionLock;
+    std::atomic<bool> m_fusionDirty;
+    std::atomic<unsigned char> m_fusionMode;
+    glm::vec3 *m_deviceOffsets; // Guarded by fusion lock
+    glm::quat *m_deviceOffsetRotations; // Guarded by fusion lock
+
+    std::atomic<unsigned char> m_pollingMode;
+    std::atomic<uint32_t> m_pollingTimeout;
+    std::atomic<uint32_t> m_wakeupRate;
+    std::atomic<int64_t> m_publishLatencyAverage;
+    std::atomic<int64_t> m_publishLatencyMax;
+
+    std::atomic<bool> m_interpolation;
+    std::atomic<unsigned char> m_interpolationMode;
+    std::atomic<int64_t> m_displayOffset;
+    std::atomic<float> m_jitterAverage;
+    std::atomic<float> m_jitterMax;
+    std::atomic<int64_t> m_frameStart;
+    std::atomic<int64_t> m_framePeriod;
+
+    CHistogram *m_frameAgeHistogram; // Owned by RunFrame thread
+    int64_t m_clockWindowStart; // Owned by RunFrame thread
+    int64_t m_clockWindowOffset; // Owned by RunFrame thread
+    int64_t m_clockOffsetSum; // Owned by RunFrame thread
+    int64_t m_clockOffsetMinWindow; // Owned by RunFrame thread
+    int64_t m_clockOffsetMaxWindow; // Owned by RunFrame thread
+    uint32_t m_clockOffsetCount; // Owned by RunFrame thread
+    std::atomic<int64_t> m_clockOffsetMin;
+    std::atomic<int64_t> m_clockOffsetAverage;
+    std::atomic<int64_t> m_clockOffsetMax;
+    std::atomic<float> m_clockDrift;
+    std::atomic<int64_t> m_frameAgeMin;
+    std::atomic<int64_t> m_frameAgeAverage;
+    std::atomic<int64_t> m_frameAgeP99;
+
+    std::atomic<unsigned char> m_threadPriority;
+    std::atomic<bool> m_threadRealtime;
+    std::atomic<uint64_t> m_threadAffinity;
+    std::atomic<bool> m_schedulingDirty;
+    std::atomic<unsigned char> m_schedulingState;
+    void *m_realtimeHandle; // Owned by poller thread
+    CHistogram *m_wakeupHistogram; // Owned by poller thread
+    std::atomic<int64_t> m_wakeupLatencyAverage;
+    std::atomic<int64_t> m_wakeupLatencyP99;
+    std::atomic<int64_t> m_wakeupLatencyMax;
+
+    void ThreadUpdate();
+    void CreateBuffers();
+    void DestroyBuffers();
+    void UpdateInterpolation();
+    void UpdateDevices();
+    void CloseDevices();
+    void UpdateConnectionState();
+    void ScheduleReconnect();
+    void Reconnect();
+    void ApplyRequests(bool f_force);
+    void UpdateRecording();
+    void UpdateReplay(int64_t f_hostTime);
+    bool ReadReplayFrame();
+    int64_t GetReplayTime(int64_t f_hostTime) const;
+    void PublishFrame(const LEAP_TRACKING_EVENT *f_event);
+    void UpdateClockStatistics(int64_t f_hostTime, int64_t f_leapTime);
+    void UpdateScheduling();
+    void ResetScheduling();
+    uint32_t GetPollingTimeout() const;
 public:
+    enum ReplayMode : unsigned char
+    {
+        RM_Realtime = 0U,
+        RM_Fast,
+        RM_Step
+    };
+
     CLeapPoller();
     ~CLeapPoller();
 
-    bool Initialize();
-    void Terminate();
+    // Plays recorded session or LeapC recording from RunFrame thread instead of service, interpolation is unavailable
+    bool InitializeReplay(const std::string &f_path, unsigned char f_mode);
+
+    bool IsReplaying() const;
+    bool IsReplayFinished() const;
+    uint64_t GetReplayedFramesCount() const;
+    // Frames to publish in step mode on next updates
+    void StepReplay(uint32_t f_count);
+    // Playback rate of realtime mode, kept between replays
+    void SetReplaySpeed(float f_speed);
+
+    // CTrackingSource
+    bool Initialize() override;
+    void Terminate() override;
+    void Update() override;
+    // Service is connected and at least one device is opened, tracked from poller events
+    bool IsConnected() const override;
+    const LEAP_TRACKING_EVENT* GetFrame() override;
+    const LEAP_TRACKING_EVENT* GetInterpolatedFrame() override;
+    // Call from RunFrame thread only
+    unsigned char GetFramesAtTime(int64_t f_hostTime, CLeapFrame &f_before, CLeapFrame &f_after) override;
+    const CFrameHistory* GetFrameHistory() const override;
+    // Start of current RunFrame in Leap clock
+    int64_t GetFrameStartTime() const override;
+
+    // Continuity of events received from service
+    const CFrameContinuity* GetFrameContinuity() const;
+
+    uint64_t GetProducedFramesCount() const;
+    uint64_t GetConsumedFramesCount() const;
+    uint64_t GetOverwrittenFramesCount() const;
 
-    bool IsConnected() const;
-    const LEAP_TRACKING_EVENT* GetInterpolatedFrame();
-    const LEAP_TRACKING_EVENT* GetFrame();
+    const CMemoryPool* GetMemoryPool() const;
 
+    // Applied by poller thread and restored after reconnect
     void SetPolicy(uint64_t f_set, uint64_t f_clear = 0U);
     void SetPaused(bool f_state);
+    void SetPollingMode(unsigned char f_mode, uint32_t f_timeout);
+    void SetInterpolation(bool f_state, unsigned char f_mode);
+    // Time from RunFrame start to photons, used as pose time in split interpolation
+    void SetDisplayOffset(int64_t f_offset);
+    void SetFusionMode(unsigned char f_mode);
+    // Offset in meters and rotation from device space to first device space
+    void SetDeviceExtrinsics(size_t f_device, const glm::vec3 &f_offset, const glm::quat &f_rotation);
 
-    void Update();
-    void UpdateInterpolation();
+    uint32_t GetDevicesCount() const;
+    uint32_t GetReconnectsCount() const;
+
+    // Records every received frame, applied by poller thread
+    // Format is CSessionRecorder::SessionFormat value
+    void StartRecording(const std::string &f_path, unsigned char f_format);
+    void StopRecording();
+    // Recorder of latest session, it stays valid till poller destruction
+    const CSessionRecorder* GetRecorder() const;
+
+    // Realtime class falls back to priority if refused by OS, affinity of 0 means any core
+    void SetScheduling(unsigned char f_priority, bool f_realtime, uint64_t f_affinity);
+    // Flags of successfully applied scheduling options
+    unsigned char GetSchedulingState() const;
+    // Actual minus intended wake-up time on sleeps and poll timeouts, microseconds
+    int64_t GetWakeupLatencyAverage() const;
+    int64_t GetWakeupLatencyP99() const;
+    int64_t GetWakeupLatencyMax() const;
+
+    // Measured over last second
+    uint32_t GetWakeupRate() const;
+    int64_t GetPublishLatencyAverage() const;
+    int64_t GetPublishLatencyMax() const;
+    // Palm second difference of interpolated frames in millimeters
+    float GetJitterAverage() const;
+    float GetJitterMax() const;
+    // Steady clock minus Leap clock in microseconds, drift in microseconds per second
+    int64_t GetClockOffsetMin() const;
+    int64_t GetClockOffsetAverage() const;
+    int64_t GetClockOffsetMax() const;
+    float GetClockDrift() const;
+    // Time from frame capture to its pick up in RunFrame, microseconds
+    int64_t GetFrameAgeMin() const;
+    int64_t GetFrameAgeAverage() const;
+    int64_t GetFrameAgeP99() const;
+
+    static int64_t GetHostTime();
 };
 
 
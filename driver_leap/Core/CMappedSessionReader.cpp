@@ -0,0 +1,243 @@
+#include "stdafx.h"
+
+#include "Core/CMappedSessionReader.h"
+#include "Core/CFrameDecoder.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CSessionIndex.h"
+#include "Core/CSessionReader.h"
+#include "Core/CSessionRecorder.h"
+
+CMappedSessionReader::CMappedSessionReader()
+{
+#ifdef _WIN32
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = NULL;
+#else
+    m_file = -1;
+#endif
+    m_data = nullptr;
+    m_size = 0U;
+    m_offset = 0U;
+    m_end = 0U;
+    m_index = new CSessionIndex();
+    m_decoder = new CFrameDecoder();
+    m_pendingFrame = new CLeapFrame();
+    m_pendingTime = 0;
+    m_pending = false;
+}
+
+CMappedSessionReader::~CMappedSessionReader()
+{
+    Close();
+    delete m_index;
+    delete m_decoder;
+    delete m_pendingFrame;
+}
+
+bool CMappedSessionReader::Open(const std::string &f_path)
+{
+    Close();
+
+    bool l_result = false;
+    if(Map(f_path) && (m_size >= CSessionRecorder::RF_HeaderSize))
+    {
+        uint32_t l_header[CSessionRecorder::RF_HeaderSize / sizeof(uint32_t)] = { 0U };
+        std::memcpy(l_header, m_data, sizeof(l_header));
+        if((l_header[0U] == CSessionRecorder::RF_Magic) && (l_header[1U] == CSessionRecorder::RF_Version) && (l_header[2U] == sizeof(LEAP_HAND)))
+        {
+            if(m_index->Read(m_data, m_size))
+            {
+                uint64_t l_indexOffset = 0U;
+                std::memcpy(&l_indexOffset, m_data + m_size - CSessionIndex::IF_TrailerSize, sizeof(l_indexOffset));
+                m_end = static_cast<size_t>(l_indexOffset);
+            }
+            else BuildIndex();
+
+            m_offset = CSessionRecorder::RF_HeaderSize;
+            l_result = true;
+        }
+    }
+    if(!l_result) Close();
+    return l_result;
+}
+
+void CMappedSessionReader::Close()
+{
+    Unmap();
+    m_index->Clear();
+    m_decoder->Reset();
+    m_offset = 0U;
+    m_end = 0U;
+    m_pending = false;
+}
+
+bool CMappedSessionReader::IsOpen() const
+{
+    return (m_data != nullptr);
+}
+
+bool CMappedSessionReader::Read(CLeapFrame &f_frame, int64_t &f_hostTime)
+{
+    bool l_result = false;
+    if(m_pending)
+    {
+        f_frame = *m_pendingFrame;
+        f_hostTime = m_pendingTime;
+        m_pending = false;
+        l_result = true;
+    }
+    else l_result = ReadRecord(f_frame, f_hostTime);
+    return l_result;
+}
+
+bool CMappedSessionReader::Seek(int64_t f_value, unsigned char f_key)
+{
+    bool l_result = false;
+    if(m_data)
+    {
+        m_offset = CSessionRecorder::RF_HeaderSize;
+        if(m_index->GetEntriesCount() > 0U) m_offset = static_cast<size_t>(m_index->GetEntry(m_index->Find(f_value, f_key)).m_offset);
+        m_decoder->Reset();
+        m_pending = false;
+
+        // Frames between keyframe and target are decoded and dropped
+        while(ReadRecord(*m_pendingFrame, m_pendingTime))
+        {
+            const LEAP_TRACKING_EVENT *l_event = m_pendingFrame->GetEvent();
+            const CSessionIndex::Entry l_entry = { 0U, m_pendingTime, l_event->info.timestamp, l_event->tracking_frame_id };
+            if(CSessionIndex::GetKey(l_entry, f_key) >= f_value)
+            {
+                m_pending = true;
+                l_result = true;
+                break;
+            }
+        }
+    }
+    return l_result;
+}
+
+bool CMappedSessionReader::Rewind()
+{
+    m_offset = CSessionRecorder::RF_HeaderSize;
+    m_decoder->Reset();
+    m_pending = false;
+    return (m_data != nullptr);
+}
+
+const CSessionIndex* CMappedSessionReader::GetIndex() const
+{
+    return m_index;
+}
+
+bool CMappedSessionReader::Map(const std::string &f_path)
+{
+#ifdef _WIN32
+    m_file = CreateFileA(f_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(m_file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER l_size = { 0 };
+        if(GetFileSizeEx(m_file, &l_size) && (l_size.QuadPart > 0))
+        {
+            m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if(m_mapping)
+            {
+                m_data = reinterpret_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                if(m_data) m_size = static_cast<size_t>(l_size.QuadPart);
+            }
+        }
+    }
+#else
+    m_file = open(f_path.c_str(), O_RDONLY);
+    if(m_file != -1)
+    {
+        struct stat l_stat;
+        if((fstat(m_file, &l_stat) == 0) && (l_stat.st_size > 0))
+        {
+            void *l_data = mmap(nullptr, static_cast<size_t>(l_stat.st_size), PROT_READ, MAP_SHARED, m_file, 0);
+            if(l_data != MAP_FAILED)
+            {
+                m_data = reinterpret_cast<const uint8_t*>(l_data);
+                m_size = static_cast<size_t>(l_stat.st_size);
+            }
+        }
+    }
+#endif
+    return (m_data != nullptr);
+}
+
+void CMappedSessionReader::Unmap()
+{
+#ifdef _WIN32
+    if(m_data) UnmapViewOfFile(m_data);
+    if(m_mapping) CloseHandle(m_mapping);
+    if(m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+    m_mapping = NULL;
+    m_file = INVALID_HANDLE_VALUE;
+#else
+    if(m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+    if(m_file != -1) close(m_file);
+    m_file = -1;
+#endif
+    m_data = nullptr;
+    m_size = 0U;
+}
+
+// Fallback for recordings without footer, only record headers and keyframe headers are parsed
+void CMappedSessionReader::BuildIndex()
+{
+    m_index->Clear();
+    uint32_t l_rawFrames = 0U;
+    size_t l_offset = CSessionRecorder::RF_HeaderSize;
+    while((l_offset + CSessionRecorder::RF_RecordHeaderSize) <= m_size)
+    {
+        const uint8_t l_type = m_data[l_offset];
+        uint32_t l_size = 0U;
+        std::memcpy(&l_size, m_data + l_offset + sizeof(uint8_t), sizeof(l_size));
+        const size_t l_next = l_offset + CSessionRecorder::RF_RecordHeaderSize + l_size;
+        if(l_next > m_size) break;
+
+        const uint8_t *l_payload = m_data + l_offset + CSessionRecorder::RF_RecordHeaderSize;
+        int64_t l_hostTime = 0;
+        int64_t l_timestamp = 0;
+        int64_t l_trackingFrameId = 0;
+        if(l_type == CSessionRecorder::RT_Frame)
+        {
+            if(((l_rawFrames++ % CSessionRecorder::GetIndexInterval()) == 0U) && (l_size >= sizeof(int64_t) * 4U))
+            {
+                std::memcpy(&l_hostTime, l_payload, sizeof(int64_t));
+                std::memcpy(&l_timestamp, l_payload + sizeof(int64_t) * 2U, sizeof(int64_t));
+                std::memcpy(&l_trackingFrameId, l_payload + sizeof(int64_t) * 3U, sizeof(int64_t));
+                m_index->Add(l_offset, l_hostTime, l_timestamp, l_trackingFrameId);
+            }
+        }
+        else if((l_type == CSessionRecorder::RT_CompressedFrame) && CFrameDecoder::ReadKeyframeHeader(l_payload, l_size, l_hostTime, l_timestamp, l_trackingFrameId))
+        {
+            m_index->Add(l_offset, l_hostTime, l_timestamp, l_trackingFrameId);
+        }
+        l_offset = l_next;
+    }
+    m_end = l_offset;
+}
+
+bool CMappedSessionReader::ReadRecord(CLeapFrame &f_frame, int64_t &f_hostTime)
+{
+    bool l_result = false;
+    while(!l_result && ((m_offset + CSessionRecorder::RF_RecordHeaderSize) <= m_end))
+    {
+        const uint8_t l_type = m_data[m_offset];
+        uint32_t l_size = 0U;
+        std::memcpy(&l_size, m_data + m_offset + sizeof(uint8_t), sizeof(l_size));
+        const size_t l_next = m_offset + CSessionRecorder::RF_RecordHeaderSize + l_size;
+        if(l_next > m_end) break;
+
+        const uint8_t *l_payload = m_data + m_offset + CSessionRecorder::RF_RecordHeaderSize;
+        m_offset = l_next;
+        if(l_type == CSessionRecorder::RT_Frame)
+        {
+            l_result = CSessionReader::ParseFrame(l_payload, l_size, f_frame, f_hostTime);
+            if(!l_result) break;
+        }
+        else if(l_type == CSessionRecorder::RT_CompressedFrame) l_result = m_decoder->Decode(l_payload, l_size, f_frame, f_hostTime);
+    }
+    return l_result;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+class CFrameDecoder;
+class CLeapFrame;
+class CSessionIndex;
+
+// Seekable reader of memory-mapped recording, index is built by scanning if file has no footer.
+// Each instance keeps own cursor, several instances can process segments of same file in parallel.
+class CMappedSessionReader final
+{
+#ifdef _WIN32
+    HANDLE m_file;
+    HANDLE m_mapping;
+#else
+    int m_file;
+#endif
+    const uint8_t *m_data;
+    size_t m_size;
+    size_t m_offset;
+    size_t m_end; // End of frame records
+    CSessionIndex *m_index;
+    CFrameDecoder *m_decoder;
+    CLeapFrame *m_pendingFrame;
+    int64_t m_pendingTime;
+    bool m_pending;
+
+    CMappedSessionReader(const CMappedSessionReader &that) = delete;
+    CMappedSessionReader& operator=(const CMappedSessionReader &that) = delete;
+
+    bool Map(const std::string &f_path);
+    void Unmap();
+    void BuildIndex();
+    bool ReadRecord(CLeapFrame &f_frame, int64_t &f_hostTime);
+public:
+    CMappedSessionReader();
+    ~CMappedSessionReader();
+
+    bool Open(const std::string &f_path);
+    void Close();
+    bool IsOpen() const;
+
+    // Returns false at end of records or on damaged record
+    bool Read(CLeapFrame &f_frame, int64_t &f_hostTime);
+    // Next read returns first frame with key not below value, key is CSessionIndex::SeekKey
+    bool Seek(int64_t f_value, unsigned char f_key);
+    bool Rewind();
+
+    const CSessionIndex* GetIndex() const;
+};
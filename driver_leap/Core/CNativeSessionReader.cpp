@@ -0,0 +1,70 @@
+#include "stdafx.h"
+
+#include "Core/CNativeSessionReader.h"
+#include "Core/CLeapFrame.h"
+
+const uint64_t g_frameSizeLimit = 1048576U;
+
+CNativeSessionReader::CNativeSessionReader()
+{
+    m_recording = nullptr;
+    m_readFrames = 0U;
+}
+
+CNativeSessionReader::~CNativeSessionReader()
+{
+    Close();
+}
+
+bool CNativeSessionReader::Open(const std::string &f_path)
+{
+    Close();
+
+    LEAP_RECORDING_PARAMETERS l_params = { eLeapRecordingFlags_Reading };
+    if(LeapRecordingOpen(&m_recording, f_path.c_str(), l_params) == eLeapRS_Success) m_path.assign(f_path);
+    else m_recording = nullptr;
+    return (m_recording != nullptr);
+}
+
+void CNativeSessionReader::Close()
+{
+    if(m_recording) LeapRecordingClose(&m_recording);
+    m_recording = nullptr;
+    m_readFrames = 0U;
+}
+
+bool CNativeSessionReader::IsOpen() const
+{
+    return (m_recording != nullptr);
+}
+
+bool CNativeSessionReader::Read(CLeapFrame &f_frame, int64_t &f_hostTime)
+{
+    bool l_result = false;
+    uint64_t l_size = 0U;
+    if(m_recording && (LeapRecordingReadSize(m_recording, &l_size) == eLeapRS_Success) && (l_size >= sizeof(LEAP_TRACKING_EVENT)) && (l_size <= g_frameSizeLimit))
+    {
+        // Event is flat, hands follow it in same buffer
+        if(m_buffer.size() < l_size) m_buffer.resize(static_cast<size_t>(l_size));
+        LEAP_TRACKING_EVENT *l_event = reinterpret_cast<LEAP_TRACKING_EVENT*>(m_buffer.data());
+        if(LeapRecordingRead(m_recording, l_event, l_size) == eLeapRS_Success)
+        {
+            f_frame.CopyEvent(l_event);
+            f_hostTime = l_event->info.timestamp;
+            m_readFrames++;
+            l_result = true;
+        }
+    }
+    return l_result;
+}
+
+bool CNativeSessionReader::Rewind()
+{
+    const std::string l_path(m_path);
+    return (m_recording && Open(l_path));
+}
+
+uint64_t CNativeSessionReader::GetReadFrames() const
+{
+    return m_readFrames;
+}
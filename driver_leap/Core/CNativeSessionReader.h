@@ -0,0 +1,29 @@
+#pragma once
+
+class CLeapFrame;
+
+// Sequential reader of LeapC recordings (.lmt), host time of frames is their Leap timestamp
+class CNativeSessionReader final
+{
+    LEAP_RECORDING m_recording;
+    std::string m_path;
+    std::vector<uint8_t> m_buffer;
+    uint64_t m_readFrames;
+
+    CNativeSessionReader(const CNativeSessionReader &that) = delete;
+    CNativeSessionReader& operator=(const CNativeSessionReader &that) = delete;
+public:
+    CNativeSessionReader();
+    ~CNativeSessionReader();
+
+    bool Open(const std::string &f_path);
+    void Close();
+    bool IsOpen() const;
+
+    // Returns false at end of recording or on read error
+    bool Read(CLeapFrame &f_frame, int64_t &f_hostTime);
+    // Recording has no seeking, it's reopened
+    bool Rewind();
+
+    uint64_t GetReadFrames() const;
+};
@@ -2,34 +2,132 @@
 
 #include "Core/CServerDriver.h"
 #include "Core/CLeapPoller.h"
+#include "Core/CFrameContinuity.h"
+#include "Core/CHandFusion.h"
+#include "Core/CHandPredictor.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CSessionRecorder.h"
+#include "Core/CSyntheticSource.h"
+#include "Core/CTelemetryBlock.h"
+#include "Devices/CLeapController/CControllerButton.h"
 #include "Devices/CLeapController/CLeapControllerVive.h"
 #include "Devices/CLeapController/CLeapControllerIndex.h"
 #include "Devices/CLeapController/CLeapControllerOculus.h"
 #include "Devices/CLeapStation.h"
 
 #include "Core/CDriverConfig.h"
+#include "Utils/CFrameProfiler.h"
+#include "Utils/CFrameTrace.h"
+#include "Utils/CMemoryPool.h"
+#include "Utils/CSlidingHistogram.h"
+#include "Utils/CStageTimer.h"
 #include "Utils/Utils.h"
 
 extern char g_modulePath[];
+extern const std::vector<std::string> g_trackingSources;
+
+const int64_t g_latencyBucketWidth = 50; // Microseconds
+const size_t g_latencyBucketsCount = 2000U; // Up to 100 ms
+const int64_t g_latencyPeriod = 1000000; // Window slides by one second
+const size_t g_latencyPeriodsCount = 10U;
+const char g_recordingsDirectory[] = "recordings"; // Output directories next to resources of driver
+const char g_logsDirectory[] = "logs";
+const int64_t g_photonRetryPeriod = 1000000; // Microseconds between queries of unavailable display frequency
 
 const std::vector<std::string> g_debugRequests
 {
-    "setting"
+    "setting", "stats", "record", "replay", "trace", "latency"
 };
 enum DebugRequest : size_t
 {
-    DR_Setting = 0U
+    DR_Setting = 0U,
+    DR_Stats,
+    DR_Record,
+    DR_Replay,
+    DR_Trace,
+    DR_Latency
+};
+
+const std::vector<std::string> g_recordCommands
+{
+    "start", "compressed", "native", "stop"
+};
+enum RecordCommand : size_t
+{
+    RC_Start = 0U, // Start commands match CSessionRecorder::SessionFormat values
+    RC_Compressed,
+    RC_Native,
+    RC_Stop
+};
+
+const std::vector<std::string> g_replayCommands
+{
+    "start", "stop", "step", "speed"
+};
+enum ReplayCommand : size_t
+{
+    RPC_Start = 0U,
+    RPC_Stop,
+    RPC_Step,
+    RPC_Speed
+};
+
+const std::vector<std::string> g_traceCommands
+{
+    "start", "stop", "dump"
+};
+enum TraceCommand : size_t
+{
+    TC_Start = 0U,
+    TC_Stop,
+    TC_Dump
+};
+
+const std::vector<std::string> g_latencyCommands
+{
+    "left", "right", "dump"
+};
+enum LatencyCommand : size_t
+{
+    LC_Left = 0U, // Hand commands match LeapControllerHand values
+    LC_Right,
+    LC_Dump
+};
+
+const std::vector<std::string> g_replayModes
+{
+    "realtime", "fast", "step"
 };
 
 const std::vector<std::string> g_settingCommands
 {
-    "left_hand", "right_hand", "reload_config"
+    "left_hand", "right_hand", "reload_config", "tracking_source"
 };
 enum SettingCommand : size_t
 {
     SC_LeftHand = 0U,
     SC_RightHand,
-    SC_ReloadConfig
+    SC_ReloadConfig,
+    SC_TrackingSource
+};
+
+const std::vector<std::string> g_statsRequests
+{
+    "poller", "memory", "prediction", "interpolation", "devices", "clock", "scheduling", "frames", "submits", "recorder", "replay"
+};
+enum StatsRequest : size_t
+{
+    SR_Poller = 0U,
+    SR_Memory,
+    SR_Prediction,
+    SR_Interpolation,
+    SR_Devices,
+    SR_Clock,
+    SR_Scheduling,
+    SR_Frames,
+    SR_Submits,
+    SR_Recorder,
+    SR_Replay
 };
 
 const char* const CServerDriver::ms_interfaces[]
@@ -42,9 +140,28 @@ const char* const CServerDriver::ms_interfaces[]
 CServerDriver::CServerDriver()
 {
     m_leapPoller = nullptr;
+    m_liveSource = nullptr;
+    m_trackingSource = nullptr;
+    m_syntheticSource = nullptr;
+    m_sourceType = CDriverConfig::TS_Leap;
+    m_syntheticRate = 0.f;
+    m_syntheticHands = 0U;
+    m_syntheticDevices = 1U;
+    m_sourceDirty = false;
+    m_fusionDirty = false;
+    m_handPredictor = nullptr;
+    m_predictedFrame = nullptr;
+    m_photonOffset = 0;
+    m_photonRetryTime = 0;
+    m_submitContinuity = nullptr;
+    for(size_t i = 0U; i < LCH_Count; i++) m_submitLatencies[i] = nullptr;
+    m_replayMode = CLeapPoller::RM_Realtime;
+    m_replayDirty = false;
     m_connectionState = false;
     for(size_t i = 0U; i < LCH_Count; i++) m_controllers[i] = nullptr;
     m_leapStation = nullptr;
+    m_telemetryBlock = nullptr;
+    m_runFrames = 0U;
 }
 
 CServerDriver::~CServerDriver()
@@ -85,14 +202,31 @@ vr::EVRInitError CServerDriver::Init(vr::IVRDriverContext *pDriverContext)
         if(m_controllers[i]) vr::VRServerDriverHost()->TrackedDeviceAdded(m_controllers[i]->GetSerialNumber().c_str(), vr::TrackedDeviceClass_Controller, m_controllers[i]);
     }
 
+    m_handPredictor = new CHandPredictor();
+    m_predictedFrame = new CLeapFrame();
+    m_submitContinuity = new CFrameContinuity();
+    m_telemetryBlock = new CTelemetryBlock();
+    m_telemetryBlock->Create(); // Driver works without telemetry
+    for(size_t i = 0U; i < LCH_Count; i++) m_submitLatencies[i] = new CSlidingHistogram(g_latencyBucketWidth, g_latencyBucketsCount, g_latencyPeriod, g_latencyPeriodsCount);
+
     m_leapPoller = new CLeapPoller();
-    if(m_leapPoller->Initialize())
-    {
-        m_leapPoller->SetPolicy(eLeapPolicyFlag_AllowPauseResume);
-        if(CDriverConfig::GetOrientationMode() == CDriverConfig::OM_HMD) m_leapPoller->SetPolicy(eLeapPolicyFlag_OptimizeHMD);
-    }
+    m_leapPoller->SetPollingMode(CDriverConfig::GetPollingMode(), CDriverConfig::GetPollingTimeout());
+    m_leapPoller->SetInterpolation(CDriverConfig::IsInterpolationEnabled(), CDriverConfig::GetInterpolationMode());
+    UpdateFusion();
+    m_leapPoller->SetScheduling(CDriverConfig::GetThreadPriority(), CDriverConfig::IsThreadRealtime(), CDriverConfig::GetThreadAffinity());
+    m_leapPoller->SetPolicy(eLeapPolicyFlag_AllowPauseResume);
+    if(CDriverConfig::GetOrientationMode() == CDriverConfig::OM_HMD) m_leapPoller->SetPolicy(eLeapPolicyFlag_OptimizeHMD);
+
+    m_sourceType = CDriverConfig::GetTrackingSource();
+    m_syntheticRate = CDriverConfig::GetSyntheticRate();
+    m_syntheticHands = CDriverConfig::GetSyntheticHands();
+    m_syntheticDevices = CDriverConfig::GetSyntheticDevices();
+    m_liveSource = m_leapPoller;
+    m_trackingSource = m_leapPoller;
+    UpdateSource();
     //m_connectionState = true;
 
+#ifdef _WIN32
     // Start utility app that closes itself on SteamVR shutdown
     std::string l_path(g_modulePath);
     l_path.erase(l_path.begin() + l_path.rfind('\\'), l_path.end());
@@ -104,6 +238,7 @@ vr::EVRInitError CServerDriver::Init(vr::IVRDriverContext *pDriverContext)
     PROCESS_INFORMATION l_monitorInfo = { 0 };
     l_infoProcess.cb = sizeof(STARTUPINFOA);
     CreateProcessA(l_appPath.c_str(), NULL, NULL, NULL, FALSE, 0, NULL, l_path.c_str(), &l_infoProcess, &l_monitorInfo);
+#endif
 
     return vr::VRInitError_None;
 }
@@ -118,10 +253,33 @@ void CServerDriver::Cleanup()
     delete m_leapStation;
     m_leapStation = nullptr;
 
+    if(m_syntheticSource)
+    {
+        m_syntheticSource->Terminate();
+        delete m_syntheticSource;
+        m_syntheticSource = nullptr;
+    }
+    m_liveSource = nullptr;
+    m_trackingSource = nullptr;
+
     m_leapPoller->Terminate();
     delete m_leapPoller;
     m_leapPoller = nullptr;
 
+    delete m_handPredictor;
+    m_handPredictor = nullptr;
+    delete m_predictedFrame;
+    m_predictedFrame = nullptr;
+    delete m_submitContinuity;
+    m_submitContinuity = nullptr;
+    delete m_telemetryBlock;
+    m_telemetryBlock = nullptr;
+    for(size_t i = 0U; i < LCH_Count; i++)
+    {
+        delete m_submitLatencies[i];
+        m_submitLatencies[i] = nullptr;
+    }
+
     VR_CLEANUP_SERVER_DRIVER_CONTEXT();
 }
 
@@ -132,12 +290,24 @@ const char* const* CServerDriver::GetInterfaceVersions()
 
 void CServerDriver::RunFrame()
 {
-    CLeapController::UpdateHMDCoordinates();
-    m_leapPoller->Update();
+    {
+        STAGE_TIMER(CFrameProfiler::FS_HmdUpdate);
+        CLeapController::UpdateHMDCoordinates();
+    }
+    if(m_sourceDirty.exchange(false)) UpdateSource();
+    if(m_fusionDirty.exchange(false)) UpdateSyntheticFusion();
+    if(m_replayDirty.exchange(false)) UpdateReplay();
 
-    if(m_connectionState != m_leapPoller->IsConnected())
+    // Frame start of source is sampled during update
+    const int64_t l_updateTime = CLeapPoller::GetHostTime();
     {
-        m_connectionState = m_leapPoller->IsConnected();
+        STAGE_TIMER(CFrameProfiler::FS_PollerUpdate);
+        m_trackingSource->Update();
+    }
+
+    if(m_connectionState != m_trackingSource->IsConnected())
+    {
+        m_connectionState = m_trackingSource->IsConnected();
         m_leapStation->SetTrackingState(m_connectionState ? CLeapStation::TS_Connected : CLeapStation::TS_Search);
         for(size_t i = 0U; i < LCH_Count; i++)
         {
@@ -146,13 +316,25 @@ void CServerDriver::RunFrame()
     }
 
     LEAP_HAND *l_hands[LCH_Count] = { nullptr };
+    int64_t l_motionTime = 0; // Frame timestamp in host clock
     if(m_connectionState)
     {
-        if(CDriverConfig::IsInterpolationEnabled()) m_leapPoller->UpdateInterpolation();
+        if((m_photonOffset <= 0) && (l_updateTime >= m_photonRetryTime) && (CDriverConfig::IsExtrapolationEnabled() || CDriverConfig::IsInterpolationEnabled())) UpdatePhotonOffset(l_updateTime);
 
-        const LEAP_TRACKING_EVENT *l_frame = (CDriverConfig::IsInterpolationEnabled() ? m_leapPoller->GetInterpolatedFrame() : m_leapPoller->GetFrame());
+        const LEAP_TRACKING_EVENT *l_frame = nullptr;
+        {
+            STAGE_TIMER(CFrameProfiler::FS_Interpolation);
+            if(CDriverConfig::IsExtrapolationEnabled())
+            {
+                const int64_t l_targetTime = m_trackingSource->GetFrameStartTime() + m_photonOffset;
+                if(m_handPredictor->Predict(m_trackingSource->GetFrameHistory(), l_targetTime, static_cast<int64_t>(CDriverConfig::GetExtrapolationLimit()) * 1000, *m_predictedFrame)) l_frame = m_predictedFrame->GetEvent();
+            }
+            else l_frame = (CDriverConfig::IsInterpolationEnabled() ? m_trackingSource->GetInterpolatedFrame() : m_trackingSource->GetFrame());
+        }
         if(l_frame)
         {
+            m_submitContinuity->Add(l_frame, m_trackingSource->GetFrameStartTime());
+            l_motionTime = l_frame->info.timestamp + (l_updateTime - m_trackingSource->GetFrameStartTime());
             for(size_t i = 0U; i < l_frame->nHands; i++)
             {
                 if(!l_hands[l_frame->pHands[i].type]) l_hands[l_frame->pHands[i].type] = &l_frame->pHands[i];
@@ -164,8 +346,13 @@ void CServerDriver::RunFrame()
     for(size_t i = 0U; i < LCH_Count; i++)
     {
         if(m_controllers[i]) m_controllers[i]->RunFrame(l_hands[i],l_hands[(i+1)%LCH_Count]);
+
+        // Extrapolated frames keep timestamp of newest tracking frame, so latency is age of sensor data and not of predicted pose
+        if(l_hands[i] && m_controllers[i] && m_controllers[i]->IsEnabled()) m_submitLatencies[i]->Add(m_controllers[i]->GetSubmitTime() - l_motionTime, m_controllers[i]->GetSubmitTime());
+        else m_submitLatencies[i]->Update(l_updateTime);
     }
     m_leapStation->RunFrame();
+    UpdateTelemetry(l_hands);
 }
 
 bool CServerDriver::ShouldBlockStandbyMode()
@@ -195,7 +382,142 @@ void CServerDriver::TryToPause()
     }
 }
 
-void CServerDriver::ProcessExternalMessage(const char *f_message)
+void CServerDriver::UpdateFusion()
+{
+    m_leapPoller->SetFusionMode(CDriverConfig::GetFusionMode());
+    for(size_t i = 0U; i < CHandFusion::GetDevicesLimit(); i++) m_leapPoller->SetDeviceExtrinsics(i, CDriverConfig::GetDeviceOffset(i), CDriverConfig::GetDeviceOffsetRotation(i));
+    m_fusionDirty = true;
+}
+
+// Prediction target is next vsync plus display persistence delay of HMD, unavailable frequency is queried again after retry period
+void CServerDriver::UpdatePhotonOffset(int64_t f_time)
+{
+    const vr::PropertyContainerHandle_t l_hmdContainer = vr::VRProperties()->TrackedDeviceToPropertyContainer(vr::k_unTrackedDeviceIndex_Hmd);
+    const float l_frequency = vr::VRProperties()->GetFloatProperty(l_hmdContainer, vr::Prop_DisplayFrequency_Float);
+    const float l_vsyncToPhotons = vr::VRProperties()->GetFloatProperty(l_hmdContainer, vr::Prop_SecondsFromVsyncToPhotons_Float);
+    if(l_frequency > 0.f)
+    {
+        m_photonOffset = static_cast<int64_t>((1.f / l_frequency + l_vsyncToPhotons) * 1000000.f);
+        m_leapPoller->SetDisplayOffset(m_photonOffset);
+    }
+    else m_photonRetryTime = f_time + g_photonRetryPeriod;
+}
+
+// Called from RunFrame thread only, poller replays session in place of live source
+void CServerDriver::UpdateReplay()
+{
+    std::lock_guard<std::mutex> l_guard(m_replayLock);
+    m_liveSource->Terminate();
+    m_leapPoller->Terminate();
+    if(m_replayPath.empty())
+    {
+        m_liveSource->Initialize();
+        m_trackingSource = m_liveSource;
+    }
+    else
+    {
+        m_leapPoller->InitializeReplay(m_replayPath, m_replayMode);
+        m_trackingSource = m_leapPoller;
+    }
+    m_submitContinuity->Reset();
+    for(size_t i = 0U; i < LCH_Count; i++) m_submitLatencies[i]->Reset();
+}
+
+// Called from RunFrame thread only, replay keeps poller until it's stopped
+void CServerDriver::UpdateSource()
+{
+    std::lock_guard<std::mutex> l_guard(m_sourceLock);
+    const bool l_replaying = m_leapPoller->IsReplaying();
+    if(!l_replaying) m_liveSource->Terminate();
+
+    if(m_sourceType == CDriverConfig::TS_Synthetic)
+    {
+        if(!m_syntheticSource) m_syntheticSource = new CSyntheticSource();
+        m_syntheticSource->SetParameters(m_syntheticRate, m_syntheticHands, m_syntheticDevices);
+        UpdateSyntheticFusion();
+        m_liveSource = m_syntheticSource;
+    }
+    else m_liveSource = m_leapPoller;
+
+    if(!l_replaying)
+    {
+        m_liveSource->Initialize();
+        m_trackingSource = m_liveSource;
+        m_submitContinuity->Reset();
+        for(size_t i = 0U; i < LCH_Count; i++) m_submitLatencies[i]->Reset();
+    }
+}
+
+// Called from RunFrame thread only
+void CServerDriver::UpdateSyntheticFusion()
+{
+    if(m_syntheticSource)
+    {
+        m_syntheticSource->SetFusionMode(CDriverConfig::GetFusionMode());
+        for(size_t i = 0U; i < CHandFusion::GetDevicesLimit(); i++) m_syntheticSource->SetDeviceExtrinsics(i, CDriverConfig::GetDeviceOffset(i), CDriverConfig::GetDeviceOffsetRotation(i));
+    }
+}
+
+// Called from RunFrame thread only, values are read from atomics of statistics
+void CServerDriver::UpdateTelemetry(LEAP_HAND *const *f_hands)
+{
+    m_runFrames++;
+    if(m_telemetryBlock->IsOpen())
+    {
+        CTelemetryBlock::BlockData l_data = { 0 };
+        l_data.m_runFrames = m_runFrames;
+        l_data.m_hostTime = CLeapPoller::GetHostTime();
+        l_data.m_connected = (m_connectionState ? 1U : 0U);
+        l_data.m_sourceType = ((m_liveSource == m_syntheticSource) ? CDriverConfig::TS_Synthetic : CDriverConfig::TS_Leap);
+        l_data.m_replaying = (m_leapPoller->IsReplaying() ? 1U : 0U);
+        l_data.m_devicesCount = m_leapPoller->GetDevicesCount();
+        l_data.m_reconnectsCount = m_leapPoller->GetReconnectsCount();
+
+        const CSessionRecorder *l_recorder = m_leapPoller->GetRecorder();
+        l_data.m_recording = (l_recorder->IsRecording() ? 1U : 0U);
+        l_data.m_recorderDrops = l_recorder->GetDroppedFrames();
+
+        const CFrameContinuity *l_frames = m_leapPoller->GetFrameContinuity();
+        l_data.m_frameRate = l_frames->GetEffectiveFramerate();
+        l_data.m_framesCount = l_frames->GetFramesCount();
+        l_data.m_skippedFrames = l_frames->GetSkippedCount();
+        l_data.m_duplicatedFrames = l_frames->GetDuplicatesCount();
+        l_data.m_restartsCount = l_frames->GetRestartsCount();
+        l_data.m_submitRate = m_submitContinuity->GetEffectiveFramerate();
+        l_data.m_submittedFrames = m_submitContinuity->GetFramesCount();
+        l_data.m_skippedSubmits = m_submitContinuity->GetSkippedCount();
+        l_data.m_duplicatedSubmits = m_submitContinuity->GetDuplicatesCount();
+
+        for(size_t i = 0U; i < LCH_Count; i++)
+        {
+            CTelemetryBlock::HandData &l_hand = l_data.m_hands[i];
+            l_hand.m_present = ((f_hands[i] != nullptr) ? 1U : 0U);
+            l_hand.m_latencyCount = m_submitLatencies[i]->GetWindowCount();
+            for(size_t j = 0U; j < CTelemetryBlock::LV_Count; j++) l_hand.m_latencies[j] = m_submitLatencies[i]->GetWindowValue(j);
+
+            const CLeapController *l_controller = m_controllers[i];
+            if(l_controller)
+            {
+                l_hand.m_enabled = (l_controller->IsEnabled() ? 1U : 0U);
+
+                const std::vector<float> &l_gestures = l_controller->GetGestures();
+                l_hand.m_gesturesCount = static_cast<uint8_t>(std::min(l_gestures.size(), static_cast<size_t>(CTelemetryBlock::BF_GesturesLimit)));
+                for(size_t j = 0U; j < l_hand.m_gesturesCount; j++) l_hand.m_gestures[j] = l_gestures[j];
+
+                l_hand.m_buttonsCount = static_cast<uint8_t>(std::min(l_controller->GetButtonsCount(), static_cast<size_t>(CTelemetryBlock::BF_ButtonsLimit)));
+                for(size_t j = 0U; j < l_hand.m_buttonsCount; j++)
+                {
+                    const CControllerButton *l_button = l_controller->GetButton(j);
+                    if(l_button->GetState()) l_hand.m_buttonStates |= (1U << j);
+                    l_hand.m_buttonValues[j] = l_button->GetValue();
+                }
+            }
+        }
+        m_telemetryBlock->Write(l_data);
+    }
+}
+
+void CServerDriver::ProcessExternalMessage(const char *f_message, char *f_response, uint32_t f_responseSize)
 {
     std::stringstream l_stream(f_message);
     std::string l_event;
@@ -230,6 +552,263 @@ void CServerDriver::ProcessExternalMessage(const char *f_message)
                             // Change orientation mode
                             if(CDriverConfig::GetOrientationMode() == CDriverConfig::OM_HMD) m_leapPoller->SetPolicy(eLeapPolicyFlag_OptimizeHMD);
                             else m_leapPoller->SetPolicy(0U, eLeapPolicyFlag_OptimizeHMD);
+
+                            m_leapPoller->SetPollingMode(CDriverConfig::GetPollingMode(), CDriverConfig::GetPollingTimeout());
+                            m_leapPoller->SetInterpolation(CDriverConfig::IsInterpolationEnabled(), CDriverConfig::GetInterpolationMode());
+                            UpdateFusion();
+                            m_leapPoller->SetScheduling(CDriverConfig::GetThreadPriority(), CDriverConfig::IsThreadRealtime(), CDriverConfig::GetThreadAffinity());
+                            m_photonOffset = 0;
+                            m_photonRetryTime = 0;
+
+                            // Source restart reconnects to service and stops recording, so it's done only on change
+                            std::lock_guard<std::mutex> l_guard(m_sourceLock);
+                            const unsigned char l_sourceType = CDriverConfig::GetTrackingSource();
+                            const float l_syntheticRate = CDriverConfig::GetSyntheticRate();
+                            const uint32_t l_syntheticHands = CDriverConfig::GetSyntheticHands();
+                            const uint32_t l_syntheticDevices = CDriverConfig::GetSyntheticDevices();
+                            if((l_sourceType != m_sourceType) || (l_syntheticRate != m_syntheticRate) || (l_syntheticHands != m_syntheticHands) || (l_syntheticDevices != m_syntheticDevices))
+                            {
+                                m_sourceType = l_sourceType;
+                                m_syntheticRate = l_syntheticRate;
+                                m_syntheticHands = l_syntheticHands;
+                                m_syntheticDevices = l_syntheticDevices;
+                                m_sourceDirty = true;
+                            }
+                        } break;
+                        case SC_TrackingSource:
+                        {
+                            // Source name, synthetic source is followed by optional rate, hands count and devices count
+                            std::string l_source;
+                            l_stream >> l_source;
+                            const size_t l_type = ReadEnumVector(l_source, g_trackingSources);
+                            if(l_type != std::numeric_limits<size_t>::max())
+                            {
+                                float l_rate = 0.f;
+                                uint32_t l_hands = 0U;
+                                uint32_t l_devices = 0U;
+                                l_stream >> l_rate;
+                                if(l_stream.fail()) l_rate = CDriverConfig::GetSyntheticRate();
+                                l_stream >> l_hands;
+                                if(l_stream.fail()) l_hands = CDriverConfig::GetSyntheticHands();
+                                l_stream >> l_devices;
+                                if(l_stream.fail()) l_devices = CDriverConfig::GetSyntheticDevices();
+
+                                std::lock_guard<std::mutex> l_guard(m_sourceLock);
+                                m_sourceType = static_cast<unsigned char>(l_type);
+                                m_syntheticRate = glm::clamp(l_rate, 1.f, 1000.f);
+                                m_syntheticHands = std::min(l_hands, 4U);
+                                m_syntheticDevices = glm::clamp(l_devices, 1U, static_cast<uint32_t>(CDriverConfig::DL_Count));
+                                m_sourceDirty = true;
+                            }
+                        } break;
+                    }
+                }
+            } break;
+            case DR_Stats:
+            {
+                std::string l_statsRequest;
+                l_stream >> l_statsRequest;
+                if(!l_stream.fail() && !l_statsRequest.empty())
+                {
+                    std::stringstream l_response;
+                    switch(ReadEnumVector(l_statsRequest, g_statsRequests))
+                    {
+                        case SR_Poller:
+                        {
+                            // Wake-ups per second, average and maximal event-to-publish latency in microseconds
+                            l_response << m_leapPoller->GetWakeupRate() << ' ' << m_leapPoller->GetPublishLatencyAverage() << ' ' << m_leapPoller->GetPublishLatencyMax();
+                        } break;
+                        case SR_Memory:
+                        {
+                            // Live, peak live and reserved bytes of SDK allocations
+                            const CMemoryPool *l_pool = m_leapPoller->GetMemoryPool();
+                            l_response << l_pool->GetLiveBytes() << ' ' << l_pool->GetLiveBytesPeak() << ' ' << l_pool->GetReservedBytes();
+                        } break;
+                        case SR_Prediction:
+                        {
+                            // Average and maximal cost in nanoseconds, average and maximal palm error in millimeters
+                            l_response << m_handPredictor->GetCostAverage() << ' ' << m_handPredictor->GetCostMax() << ' ' << m_handPredictor->GetErrorAverage() << ' ' << m_handPredictor->GetErrorMax();
+                        } break;
+                        case SR_Interpolation:
+                        {
+                            // Mode, average and maximal palm jitter in millimeters of active interpolation
+                            l_response << static_cast<int>(CDriverConfig::GetInterpolationMode()) << ' ' << m_leapPoller->GetJitterAverage() << ' ' << m_leapPoller->GetJitterMax();
+                        } break;
+                        case SR_Devices:
+                        {
+                            // Opened devices, fusion mode, connection state and service reconnects
+                            l_response << m_leapPoller->GetDevicesCount() << ' ' << static_cast<int>(CDriverConfig::GetFusionMode()) << ' ' << m_leapPoller->IsConnected() << ' ' << m_leapPoller->GetReconnectsCount();
+                        } break;
+                        case SR_Clock:
+                        {
+                            // Clock offset min/avg/max and drift, frame age min/avg/p99, microseconds
+                            l_response << m_leapPoller->GetClockOffsetMin() << ' ' << m_leapPoller->GetClockOffsetAverage() << ' ' << m_leapPoller->GetClockOffsetMax() << ' ' << m_leapPoller->GetClockDrift() << ' ';
+                            l_response << m_leapPoller->GetFrameAgeMin() << ' ' << m_leapPoller->GetFrameAgeAverage() << ' ' << m_leapPoller->GetFrameAgeP99();
+                        } break;
+                        case SR_Scheduling:
+                        {
+                            // Applied options flags, wake-up latency avg/p99/max in microseconds
+                            l_response << static_cast<int>(m_leapPoller->GetSchedulingState()) << ' ' << m_leapPoller->GetWakeupLatencyAverage() << ' ' << m_leapPoller->GetWakeupLatencyP99() << ' ' << m_leapPoller->GetWakeupLatencyMax();
+                        } break;
+                        case SR_Frames:
+                            WriteContinuity(m_leapPoller->GetFrameContinuity(), l_response);
+                            break;
+                        case SR_Submits:
+                            WriteContinuity(m_submitContinuity, l_response);
+                            break;
+                        case SR_Replay:
+                        {
+                            // Replay and finish states, published frames
+                            l_response << m_leapPoller->IsReplaying() << ' ' << m_leapPoller->IsReplayFinished() << ' ' << m_leapPoller->GetReplayedFramesCount();
+                        } break;
+                        case SR_Recorder:
+                        {
+                            // Recording and failure states, written and dropped frames, written bytes
+                            const CSessionRecorder *l_recorder = m_leapPoller->GetRecorder();
+                            l_response << l_recorder->IsRecording() << ' ' << l_recorder->IsFailed() << ' ' << l_recorder->GetWrittenFrames() << ' ' << l_recorder->GetDroppedFrames() << ' ' << l_recorder->GetWrittenBytes();
+                        } break;
+                    }
+                    WriteResponse(l_response.str(), f_response, f_responseSize);
+                }
+            } break;
+            case DR_Record:
+            {
+                std::string l_recordCommand;
+                l_stream >> l_recordCommand;
+                if(!l_stream.fail() && !l_recordCommand.empty())
+                {
+                    size_t l_record = ReadEnumVector(l_recordCommand, g_recordCommands);
+                    switch(l_record)
+                    {
+                        case RC_Start: case RC_Compressed: case RC_Native:
+                        {
+                            // Rest of message is file name in recordings directory, it can contain spaces. Response is resolved path.
+                            std::string l_name;
+                            std::string l_path;
+                            std::getline(l_stream >> std::ws, l_name);
+                            if(GetOutputPath(l_name, g_recordingsDirectory, l_path))
+                            {
+                                m_leapPoller->StartRecording(l_path, static_cast<unsigned char>(l_record));
+                                WriteResponse(l_path, f_response, f_responseSize);
+                            }
+                        } break;
+                        case RC_Stop:
+                            m_leapPoller->StopRecording();
+                            break;
+                    }
+                }
+            } break;
+            case DR_Replay:
+            {
+                std::string l_replayCommand;
+                l_stream >> l_replayCommand;
+                if(!l_stream.fail() && !l_replayCommand.empty())
+                {
+                    switch(ReadEnumVector(l_replayCommand, g_replayCommands))
+                    {
+                        case RPC_Start:
+                        {
+                            // Mode goes first, rest of message is path
+                            std::string l_mode;
+                            std::string l_path;
+                            l_stream >> l_mode;
+                            std::getline(l_stream >> std::ws, l_path);
+                            const size_t l_tableIndex = ReadEnumVector(l_mode, g_replayModes);
+                            if((l_tableIndex != std::numeric_limits<size_t>::max()) && !l_path.empty())
+                            {
+                                std::lock_guard<std::mutex> l_guard(m_replayLock);
+                                m_replayPath.assign(l_path);
+                                m_replayMode = static_cast<unsigned char>(l_tableIndex);
+                                m_replayDirty = true;
+                            }
+                        } break;
+                        case RPC_Stop:
+                        {
+                            std::lock_guard<std::mutex> l_guard(m_replayLock);
+                            m_replayPath.clear();
+                            m_replayDirty = true;
+                        } break;
+                        case RPC_Step:
+                        {
+                            uint32_t l_count = 1U;
+                            l_stream >> l_count;
+                            m_leapPoller->StepReplay(l_stream.fail() ? 1U : l_count);
+                        } break;
+                        case RPC_Speed:
+                        {
+                            float l_speed = 1.f;
+                            l_stream >> l_speed;
+                            if(!l_stream.fail() && (l_speed > 0.f)) m_leapPoller->SetReplaySpeed(l_speed);
+                        } break;
+                    }
+                }
+            } break;
+            case DR_Trace:
+            {
+                std::string l_traceCommand;
+                l_stream >> l_traceCommand;
+                if(!l_stream.fail() && !l_traceCommand.empty())
+                {
+                    switch(ReadEnumVector(l_traceCommand, g_traceCommands))
+                    {
+                        case TC_Start:
+                            CFrameTrace::Clear();
+                            CFrameTrace::SetEnabled(true);
+                            break;
+                        case TC_Stop:
+                            CFrameTrace::SetEnabled(false);
+                            break;
+                        case TC_Dump:
+                        {
+                            // Rest of message is file name in logs directory, response is count of written events
+                            std::string l_name;
+                            std::string l_path;
+                            std::getline(l_stream >> std::ws, l_name);
+                            if(GetOutputPath(l_name, g_logsDirectory, l_path))
+                            {
+                                std::ofstream l_file(l_path, std::ios::trunc);
+                                if(l_file.is_open()) WriteResponse(std::to_string(CFrameTrace::Dump(l_file)), f_response, f_responseSize);
+                            }
+                        } break;
+                    }
+                }
+            } break;
+            case DR_Latency:
+            {
+                std::string l_latencyCommand;
+                l_stream >> l_latencyCommand;
+                if(!l_stream.fail() && !l_latencyCommand.empty())
+                {
+                    const size_t l_command = ReadEnumVector(l_latencyCommand, g_latencyCommands);
+                    switch(l_command)
+                    {
+                        case LC_Left: case LC_Right:
+                        {
+                            // Submits, p50/p90/p99/max in microseconds over sliding window
+                            const CSlidingHistogram *l_latencies = m_submitLatencies[l_command];
+                            std::stringstream l_response;
+                            l_response << l_latencies->GetWindowCount();
+                            for(size_t i = 0U; i < CSlidingHistogram::WV_Count; i++) l_response << ' ' << l_latencies->GetWindowValue(i);
+                            WriteResponse(l_response.str(), f_response, f_responseSize);
+                        } break;
+                        case LC_Dump:
+                        {
+                            // Rest of message is file name in logs directory
+                            std::string l_name;
+                            std::string l_path;
+                            std::getline(l_stream >> std::ws, l_name);
+                            if(GetOutputPath(l_name, g_logsDirectory, l_path))
+                            {
+                                std::ofstream l_file(l_path, std::ios::trunc);
+                                if(l_file.is_open())
+                                {
+                                    for(size_t i = 0U; i < LCH_Count; i++)
+                                    {
+                                        l_file << "hand " << g_latencyCommands[i] << '\n';
+                                        m_submitLatencies[i]->WriteWindow(l_file);
+                                    }
+                                }
+                            }
                         } break;
                     }
                 }
@@ -237,3 +816,11 @@ void CServerDriver::ProcessExternalMessage(const char *f_message)
         }
     }
 }
+
+// Frames, duplicates, skipped identifiers, restarts, effective and reported framerate, interval avg/p99/max in microseconds
+void CServerDriver::WriteContinuity(const CFrameContinuity *f_continuity, std::ostream &f_stream)
+{
+    f_stream << f_continuity->GetFramesCount() << ' ' << f_continuity->GetDuplicatesCount() << ' ' << f_continuity->GetSkippedCount() << ' ' << f_continuity->GetRestartsCount() << ' ';
+    f_stream << f_continuity->GetEffectiveFramerate() << ' ' << f_continuity->GetReportedFramerate() << ' ';
+    f_stream << f_continuity->GetIntervalAverage() << ' ' << f_continuity->GetIntervalP99() << ' ' << f_continuity->GetIntervalMax();
+}
@@ -1,8 +1,15 @@
 #pragma once
 
+class CFrameContinuity;
+class CHandPredictor;
+class CLeapFrame;
 class CLeapPoller;
 class CLeapController;
 class CLeapStation;
+class CSlidingHistogram;
+class CSyntheticSource;
+class CTelemetryBlock;
+class CTrackingSource;
 
 class CServerDriver final : public vr::IServerTrackedDeviceProvider
 {
@@ -17,14 +24,44 @@ class CServerDriver final : public vr::IServerTrackedDeviceProvider
     static const char* const ms_interfaces[];
 
     bool m_connectionState;
-    CLeapPoller *m_leapPoller;
+    CLeapPoller *m_leapPoller; // Exists for any source, LeapC controls and statistics
+    CTrackingSource *m_liveSource; // Poller or synthetic source by settings
+    CTrackingSource *m_trackingSource; // Live source or poller during replay, owned by RunFrame thread
+    CSyntheticSource *m_syntheticSource; // Created on first use
+    std::mutex m_sourceLock;
+    unsigned char m_sourceType; // Guarded by source lock, CDriverConfig::TrackingSource value
+    float m_syntheticRate; // Guarded by source lock
+    uint32_t m_syntheticHands; // Guarded by source lock
+    uint32_t m_syntheticDevices; // Guarded by source lock
+    std::atomic<bool> m_sourceDirty;
+    std::atomic<bool> m_fusionDirty; // Synthetic source takes fusion settings on RunFrame thread
+    CHandPredictor *m_handPredictor;
+    CLeapFrame *m_predictedFrame;
+    int64_t m_photonOffset;
+    int64_t m_photonRetryTime; // Host time of next query while display frequency is unavailable
+    CFrameContinuity *m_submitContinuity;
+    CSlidingHistogram *m_submitLatencies[LCH_Count]; // Motion to pose submit in microseconds
+    std::mutex m_replayLock;
+    std::string m_replayPath; // Guarded by replay lock, empty for live tracking
+    unsigned char m_replayMode; // Guarded by replay lock
+    std::atomic<bool> m_replayDirty;
     CLeapController *m_controllers[LCH_Count];
     CLeapStation *m_leapStation;
+    CTelemetryBlock *m_telemetryBlock;
+    uint64_t m_runFrames;
 
     CServerDriver(const CServerDriver &that) = delete;
     CServerDriver& operator=(const CServerDriver &that) = delete;
 
     void TryToPause();
+    void UpdatePhotonOffset(int64_t f_time);
+    void UpdateFusion();
+    void UpdateReplay();
+    void UpdateSource();
+    void UpdateSyntheticFusion();
+    void UpdateTelemetry(LEAP_HAND *const *f_hands);
+
+    static void WriteContinuity(const CFrameContinuity *f_continuity, std::ostream &f_stream);
 
     // vr::IServerTrackedDeviceProvider
     vr::EVRInitError Init(vr::IVRDriverContext *pDriverContext);
@@ -38,5 +75,5 @@ public:
     CServerDriver();
     ~CServerDriver();
 
-    void ProcessExternalMessage(const char *f_message);
+    void ProcessExternalMessage(const char *f_message, char *f_response = nullptr, uint32_t f_responseSize = 0U);
 };
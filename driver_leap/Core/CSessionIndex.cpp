@@ -0,0 +1,130 @@
+#include "stdafx.h"
+
+#include "Core/CSessionIndex.h"
+#include "Core/CSessionRecorder.h"
+
+CSessionIndex::CSessionIndex()
+{
+}
+
+CSessionIndex::~CSessionIndex()
+{
+}
+
+void CSessionIndex::Clear()
+{
+    m_entries.clear();
+}
+
+void CSessionIndex::Add(uint64_t f_offset, int64_t f_hostTime, int64_t f_timestamp, int64_t f_trackingFrameId)
+{
+    m_entries.push_back({ f_offset, f_hostTime, f_timestamp, f_trackingFrameId });
+}
+
+size_t CSessionIndex::GetEntriesCount() const
+{
+    return m_entries.size();
+}
+
+const CSessionIndex::Entry& CSessionIndex::GetEntry(size_t f_index) const
+{
+    return m_entries[f_index];
+}
+
+size_t CSessionIndex::Find(int64_t f_value, unsigned char f_key) const
+{
+    // Binary search of first entry with key above value
+    size_t l_low = 0U;
+    size_t l_high = m_entries.size();
+    while(l_low < l_high)
+    {
+        const size_t l_middle = l_low + (l_high - l_low) / 2U;
+        if(GetKey(m_entries[l_middle], f_key) <= f_value) l_low = l_middle + 1U;
+        else l_high = l_middle;
+    }
+    return ((l_low > 0U) ? (l_low - 1U) : 0U);
+}
+
+void CSessionIndex::Write(std::vector<uint8_t> &f_record, uint64_t f_recordOffset) const
+{
+    const uint8_t l_type = CSessionRecorder::RT_Index;
+    const uint32_t l_count = static_cast<uint32_t>(m_entries.size());
+    const uint32_t l_size = static_cast<uint32_t>(sizeof(uint32_t) + IF_EntrySize * m_entries.size() + IF_TrailerSize);
+    const uint32_t l_magic = IF_Magic;
+
+    const size_t l_start = f_record.size();
+    f_record.resize(l_start + CSessionRecorder::RF_RecordHeaderSize + l_size);
+    uint8_t *l_data = f_record.data() + l_start;
+    std::memcpy(l_data, &l_type, sizeof(l_type));
+    std::memcpy(l_data + sizeof(l_type), &l_size, sizeof(l_size));
+    l_data += CSessionRecorder::RF_RecordHeaderSize;
+
+    std::memcpy(l_data, &l_count, sizeof(l_count));
+    l_data += sizeof(l_count);
+    for(const auto &l_entry : m_entries)
+    {
+        std::memcpy(l_data, &l_entry.m_offset, sizeof(uint64_t));
+        std::memcpy(l_data + 8U, &l_entry.m_hostTime, sizeof(int64_t));
+        std::memcpy(l_data + 16U, &l_entry.m_timestamp, sizeof(int64_t));
+        std::memcpy(l_data + 24U, &l_entry.m_trackingFrameId, sizeof(int64_t));
+        l_data += IF_EntrySize;
+    }
+    std::memcpy(l_data, &f_recordOffset, sizeof(f_recordOffset));
+    std::memcpy(l_data + sizeof(f_recordOffset), &l_magic, sizeof(l_magic));
+}
+
+bool CSessionIndex::Read(const uint8_t *f_data, size_t f_size)
+{
+    bool l_result = false;
+    m_entries.clear();
+    if(f_size >= (CSessionRecorder::RF_HeaderSize + CSessionRecorder::RF_RecordHeaderSize + sizeof(uint32_t) + IF_TrailerSize))
+    {
+        uint64_t l_recordOffset = 0U;
+        uint32_t l_magic = 0U;
+        std::memcpy(&l_recordOffset, f_data + f_size - IF_TrailerSize, sizeof(l_recordOffset));
+        std::memcpy(&l_magic, f_data + f_size - sizeof(l_magic), sizeof(l_magic));
+        // Record header, entries count and trailer have to fit before any read of record
+        const uint64_t l_recordLimit = f_size - (CSessionRecorder::RF_RecordHeaderSize + sizeof(uint32_t) + IF_TrailerSize);
+        if((l_magic == IF_Magic) && (l_recordOffset >= CSessionRecorder::RF_HeaderSize) && (l_recordOffset <= l_recordLimit))
+        {
+            const uint8_t *l_record = f_data + l_recordOffset;
+            uint32_t l_size = 0U;
+            uint32_t l_count = 0U;
+            std::memcpy(&l_size, l_record + sizeof(uint8_t), sizeof(l_size));
+            std::memcpy(&l_count, l_record + CSessionRecorder::RF_RecordHeaderSize, sizeof(l_count));
+
+            // Record has to end exactly at end of file
+            const uint64_t l_expectedSize = sizeof(uint32_t) + static_cast<uint64_t>(IF_EntrySize) * l_count + IF_TrailerSize;
+            if((l_record[0U] == CSessionRecorder::RT_Index) && (l_size == l_expectedSize) && ((l_recordOffset + CSessionRecorder::RF_RecordHeaderSize + l_size) == f_size))
+            {
+                const uint8_t *l_entryData = l_record + CSessionRecorder::RF_RecordHeaderSize + sizeof(uint32_t);
+                m_entries.resize(l_count);
+                for(auto &l_entry : m_entries)
+                {
+                    std::memcpy(&l_entry.m_offset, l_entryData, sizeof(uint64_t));
+                    std::memcpy(&l_entry.m_hostTime, l_entryData + 8U, sizeof(int64_t));
+                    std::memcpy(&l_entry.m_timestamp, l_entryData + 16U, sizeof(int64_t));
+                    std::memcpy(&l_entry.m_trackingFrameId, l_entryData + 24U, sizeof(int64_t));
+                    l_entryData += IF_EntrySize;
+                }
+                l_result = true;
+            }
+        }
+    }
+    return l_result;
+}
+
+int64_t CSessionIndex::GetKey(const Entry &f_entry, unsigned char f_key)
+{
+    int64_t l_result = f_entry.m_hostTime;
+    switch(f_key)
+    {
+        case SK_Timestamp:
+            l_result = f_entry.m_timestamp;
+            break;
+        case SK_TrackingFrameId:
+            l_result = f_entry.m_trackingFrameId;
+            break;
+    }
+    return l_result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// Keyframe offsets of recording, stored as last record of file and located by fixed trailer
+class CSessionIndex final
+{
+public:
+    struct Entry
+    {
+        uint64_t m_offset; // Offset of record in file
+        int64_t m_hostTime;
+        int64_t m_timestamp;
+        int64_t m_trackingFrameId;
+    };
+    enum SeekKey : unsigned char
+    {
+        SK_HostTime = 0U,
+        SK_Timestamp,
+        SK_TrackingFrameId
+    };
+    // Index payload is entries count and entries as 64-bit values, ends with offset of index record and magic
+    enum IndexFormat : uint32_t
+    {
+        IF_Magic = 0x5844494CU, // "LIDX"
+        IF_EntrySize = 32U,
+        IF_TrailerSize = 12U
+    };
+private:
+    std::vector<Entry> m_entries;
+public:
+    CSessionIndex();
+    ~CSessionIndex();
+
+    void Clear();
+    // Keys have to be ascending
+    void Add(uint64_t f_offset, int64_t f_hostTime, int64_t f_timestamp, int64_t f_trackingFrameId);
+
+    size_t GetEntriesCount() const;
+    const Entry& GetEntry(size_t f_index) const;
+    // Last entry with key not above value, first entry if there is none
+    size_t Find(int64_t f_value, unsigned char f_key) const;
+
+    // Appends whole index record that starts at given file offset
+    void Write(std::vector<uint8_t> &f_record, uint64_t f_recordOffset) const;
+    // Parses index from trailer at end of mapped file
+    bool Read(const uint8_t *f_data, size_t f_size);
+
+    static int64_t GetKey(const Entry &f_entry, unsigned char f_key);
+};
@@ -0,0 +1,127 @@
+#include "stdafx.h"
+
+#include "Core/CSessionReader.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CSessionRecorder.h"
+#include "Core/CFrameDecoder.h"
+
+const uint32_t g_recordSizeLimit = 1048576U;
+
+CSessionReader::CSessionReader()
+{
+    m_readFrames = 0U;
+    m_decoder = new CFrameDecoder();
+}
+
+CSessionReader::~CSessionReader()
+{
+    Close();
+    delete m_decoder;
+}
+
+bool CSessionReader::Open(const std::string &f_path)
+{
+    Close();
+
+    m_file.open(f_path, std::ios::binary);
+    if(m_file.is_open() && !ReadHeader()) Close();
+    return m_file.is_open();
+}
+
+void CSessionReader::Close()
+{
+    if(m_file.is_open()) m_file.close();
+    m_file.clear();
+    m_readFrames = 0U;
+    m_decoder->Reset();
+}
+
+bool CSessionReader::IsOpen()
+{
+    return m_file.is_open();
+}
+
+bool CSessionReader::Read(CLeapFrame &f_frame, int64_t &f_hostTime)
+{
+    bool l_result = false;
+    while(!l_result && m_file.is_open())
+    {
+        uint8_t l_type = 0U;
+        uint32_t l_size = 0U;
+        m_file.read(reinterpret_cast<char*>(&l_type), sizeof(l_type));
+        m_file.read(reinterpret_cast<char*>(&l_size), sizeof(l_size));
+        if(m_file.fail() || (l_size > g_recordSizeLimit)) break;
+
+        m_record.resize(l_size);
+        if(l_size > 0U) m_file.read(reinterpret_cast<char*>(m_record.data()), l_size);
+        if(m_file.fail()) break;
+
+        if(l_type == CSessionRecorder::RT_Frame)
+        {
+            l_result = ParseFrame(m_record.data(), m_record.size(), f_frame, f_hostTime);
+            if(!l_result) break;
+            m_readFrames++;
+        }
+        else if(l_type == CSessionRecorder::RT_CompressedFrame)
+        {
+            // Decoder waits for keyframe after damaged record
+            l_result = m_decoder->Decode(m_record.data(), m_record.size(), f_frame, f_hostTime);
+            if(l_result) m_readFrames++;
+        }
+    }
+    return l_result;
+}
+
+bool CSessionReader::Rewind()
+{
+    bool l_result = false;
+    if(m_file.is_open())
+    {
+        m_file.clear();
+        m_file.seekg(0, std::ios::beg);
+        m_readFrames = 0U;
+        m_decoder->Reset();
+        l_result = ReadHeader();
+    }
+    return l_result;
+}
+
+uint64_t CSessionReader::GetReadFrames() const
+{
+    return m_readFrames;
+}
+
+bool CSessionReader::ReadHeader()
+{
+    uint32_t l_header[CSessionRecorder::RF_HeaderSize / sizeof(uint32_t)] = { 0U };
+    m_file.read(reinterpret_cast<char*>(l_header), sizeof(l_header));
+
+    // Hands are stored raw, layout has to match
+    return (!m_file.fail() && (l_header[0U] == CSessionRecorder::RF_Magic) && (l_header[1U] == CSessionRecorder::RF_Version) && (l_header[2U] == sizeof(LEAP_HAND)));
+}
+
+bool CSessionReader::ParseFrame(const uint8_t *f_data, size_t f_size, CLeapFrame &f_frame, int64_t &f_hostTime)
+{
+    const size_t l_fixedSize = sizeof(int64_t) * 4U + sizeof(float) + sizeof(uint32_t);
+    bool l_result = false;
+    if(f_size >= l_fixedSize)
+    {
+        const uint8_t *l_data = f_data;
+        LEAP_TRACKING_EVENT l_event = { 0 };
+        std::memcpy(&f_hostTime, l_data, sizeof(int64_t));
+        std::memcpy(&l_event.info.frame_id, l_data + sizeof(int64_t), sizeof(int64_t));
+        std::memcpy(&l_event.info.timestamp, l_data + sizeof(int64_t) * 2U, sizeof(int64_t));
+        std::memcpy(&l_event.tracking_frame_id, l_data + sizeof(int64_t) * 3U, sizeof(int64_t));
+        std::memcpy(&l_event.framerate, l_data + sizeof(int64_t) * 4U, sizeof(float));
+        std::memcpy(&l_event.nHands, l_data + sizeof(int64_t) * 4U + sizeof(float), sizeof(uint32_t));
+
+        if(f_size == (l_fixedSize + sizeof(LEAP_HAND) * l_event.nHands))
+        {
+            // Copied straight from record, frame clamps hands to its limit
+            l_event.pHands = reinterpret_cast<LEAP_HAND*>(const_cast<uint8_t*>(l_data + l_fixedSize));
+            f_frame.CopyEvent(&l_event);
+            l_result = true;
+        }
+    }
+    return l_result;
+}
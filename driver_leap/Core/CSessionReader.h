@@ -0,0 +1,34 @@
+#pragma once
+
+class CFrameDecoder;
+class CLeapFrame;
+
+// Sequential reader of files written by CSessionRecorder, unknown records and compressed frames before first keyframe are skipped
+class CSessionReader final
+{
+    std::ifstream m_file;
+    std::vector<uint8_t> m_record;
+    uint64_t m_readFrames;
+    CFrameDecoder *m_decoder;
+
+    CSessionReader(const CSessionReader &that) = delete;
+    CSessionReader& operator=(const CSessionReader &that) = delete;
+
+    bool ReadHeader();
+public:
+    CSessionReader();
+    ~CSessionReader();
+
+    bool Open(const std::string &f_path);
+    void Close();
+    bool IsOpen();
+
+    // Returns false at end of file or on damaged record
+    bool Read(CLeapFrame &f_frame, int64_t &f_hostTime);
+    bool Rewind();
+
+    uint64_t GetReadFrames() const;
+
+    // Uncompressed frame record payload
+    static bool ParseFrame(const uint8_t *f_data, size_t f_size, CLeapFrame &f_frame, int64_t &f_hostTime);
+};
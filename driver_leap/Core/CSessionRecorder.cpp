@@ -0,0 +1,248 @@
+#include "stdafx.h"
+
+#include "Core/CSessionRecorder.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CFrameEncoder.h"
+#include "Core/CSessionIndex.h"
+
+const size_t g_queueLimit = 512U; // About four seconds of frames at highest framerate
+const std::chrono::milliseconds g_writerDelay(5U);
+const uint32_t g_indexInterval = 120U;
+
+CSessionRecorder::CSessionRecorder()
+{
+    m_active = false;
+    m_writing = false;
+    m_thread = nullptr;
+    m_format = SF_Raw;
+    m_encoder = new CFrameEncoder(g_indexInterval);
+    m_index = new CSessionIndex();
+    m_frames = new CLeapFrame[g_queueLimit];
+    m_hostTimes = new int64_t[g_queueLimit];
+    m_head = 0U;
+    m_tail = 0U;
+    m_failed = false;
+    m_writtenFrames = 0U;
+    m_droppedFrames = 0U;
+    m_writtenBytes = 0U;
+}
+
+CSessionRecorder::~CSessionRecorder()
+{
+    Stop();
+    Join();
+    delete[]m_frames;
+    delete[]m_hostTimes;
+    delete m_encoder;
+    delete m_index;
+}
+
+void CSessionRecorder::Start(const std::string &f_path, unsigned char f_format)
+{
+    Stop();
+    Join();
+
+    m_path.assign(f_path);
+    m_format = f_format;
+    m_encoder->Reset();
+    m_index->Clear();
+    m_head = 0U;
+    m_tail = 0U;
+    m_failed = false;
+    m_writtenFrames = 0U;
+    m_droppedFrames = 0U;
+    m_writtenBytes = 0U;
+    m_active = true;
+    m_writing = true;
+    m_thread = new std::thread((m_format == SF_LeapC) ? &CSessionRecorder::ThreadUpdateNative : &CSessionRecorder::ThreadUpdate, this);
+}
+
+void CSessionRecorder::Stop()
+{
+    m_active = false;
+}
+
+void CSessionRecorder::Join()
+{
+    if(m_thread)
+    {
+        m_thread->join();
+        delete m_thread;
+        m_thread = nullptr;
+    }
+}
+
+bool CSessionRecorder::IsRecording() const
+{
+    return m_active;
+}
+
+bool CSessionRecorder::IsWriting() const
+{
+    return m_writing;
+}
+
+const std::string& CSessionRecorder::GetPath() const
+{
+    return m_path;
+}
+
+void CSessionRecorder::Push(const LEAP_TRACKING_EVENT *f_event, int64_t f_hostTime)
+{
+    if(m_active)
+    {
+        const size_t l_tail = m_tail.load(std::memory_order_relaxed);
+        if((l_tail - m_head.load(std::memory_order_acquire)) < g_queueLimit)
+        {
+            m_frames[l_tail % g_queueLimit].CopyEvent(f_event);
+            m_hostTimes[l_tail % g_queueLimit] = f_hostTime;
+            m_tail.store(l_tail + 1U, std::memory_order_release);
+        }
+        else m_droppedFrames++;
+    }
+}
+
+bool CSessionRecorder::IsFailed() const
+{
+    return m_failed;
+}
+
+uint64_t CSessionRecorder::GetWrittenFrames() const
+{
+    return m_writtenFrames;
+}
+
+uint64_t CSessionRecorder::GetDroppedFrames() const
+{
+    return m_droppedFrames;
+}
+
+uint64_t CSessionRecorder::GetWrittenBytes() const
+{
+    return m_writtenBytes;
+}
+
+size_t CSessionRecorder::GetQueueLimit()
+{
+    return g_queueLimit;
+}
+
+uint32_t CSessionRecorder::GetIndexInterval()
+{
+    return g_indexInterval;
+}
+
+// Opens file on writer thread, slow disk never stalls recording thread
+void CSessionRecorder::ThreadUpdate()
+{
+    std::ofstream l_file(m_path, std::ios::binary | std::ios::trunc);
+    if(l_file.is_open())
+    {
+        const uint32_t l_header[] = { RF_Magic, RF_Version, static_cast<uint32_t>(sizeof(LEAP_HAND)), CLeapFrame::GetHandsLimit() };
+        l_file.write(reinterpret_cast<const char*>(l_header), sizeof(l_header));
+        m_writtenBytes += sizeof(l_header);
+
+        // Queue is drained after stop request
+        while(m_active || (m_head.load(std::memory_order_relaxed) != m_tail.load(std::memory_order_acquire)))
+        {
+            const size_t l_head = m_head.load(std::memory_order_relaxed);
+            if(l_head != m_tail.load(std::memory_order_acquire))
+            {
+                WriteFrame(l_file, m_frames[l_head % g_queueLimit].GetEvent(), m_hostTimes[l_head % g_queueLimit]);
+                m_head.store(l_head + 1U, std::memory_order_release);
+            }
+            else std::this_thread::sleep_for(g_writerDelay);
+
+            if(l_file.fail())
+            {
+                m_failed = true;
+                break;
+            }
+        }
+
+        if(!m_failed)
+        {
+            m_record.clear();
+            m_index->Write(m_record, m_writtenBytes);
+            l_file.write(reinterpret_cast<const char*>(m_record.data()), static_cast<std::streamsize>(m_record.size()));
+            m_writtenBytes += m_record.size();
+            if(l_file.fail()) m_failed = true;
+        }
+        l_file.close();
+    }
+    else m_failed = true;
+
+    m_active = false;
+    m_writing = false;
+}
+
+// Same queue drain as own format, host times aren't stored
+void CSessionRecorder::ThreadUpdateNative()
+{
+    LEAP_RECORDING l_recording = nullptr;
+    LEAP_RECORDING_PARAMETERS l_params = { eLeapRecordingFlags_Writing };
+    if(LeapRecordingOpen(&l_recording, m_path.c_str(), l_params) == eLeapRS_Success)
+    {
+        while(m_active || (m_head.load(std::memory_order_relaxed) != m_tail.load(std::memory_order_acquire)))
+        {
+            const size_t l_head = m_head.load(std::memory_order_relaxed);
+            if(l_head != m_tail.load(std::memory_order_acquire))
+            {
+                uint64_t l_written = 0U;
+                const eLeapRS l_result = LeapRecordingWrite(l_recording, const_cast<LEAP_TRACKING_EVENT*>(m_frames[l_head % g_queueLimit].GetEvent()), &l_written);
+                m_head.store(l_head + 1U, std::memory_order_release);
+                if(l_result != eLeapRS_Success)
+                {
+                    m_failed = true;
+                    break;
+                }
+                m_writtenBytes += l_written;
+                m_writtenFrames++;
+            }
+            else std::this_thread::sleep_for(g_writerDelay);
+        }
+        LeapRecordingClose(&l_recording);
+    }
+    else m_failed = true;
+
+    m_active = false;
+    m_writing = false;
+}
+
+void CSessionRecorder::WriteFrame(std::ofstream &f_file, const LEAP_TRACKING_EVENT *f_event, int64_t f_hostTime)
+{
+    m_record.clear();
+
+    const uint8_t l_type = ((m_format == SF_Compressed) ? RT_CompressedFrame : RT_Frame);
+    uint32_t l_size = 0U;
+    WriteData(&l_type, sizeof(l_type));
+    WriteData(&l_size, sizeof(l_size));
+
+    bool l_keyframe = ((m_writtenFrames % g_indexInterval) == 0U);
+    if(m_format == SF_Compressed) l_keyframe = m_encoder->Encode(f_event, f_hostTime, m_record);
+    else
+    {
+        WriteData(&f_hostTime, sizeof(f_hostTime));
+        WriteData(&f_event->info.frame_id, sizeof(int64_t));
+        WriteData(&f_event->info.timestamp, sizeof(int64_t));
+        WriteData(&f_event->tracking_frame_id, sizeof(int64_t));
+        WriteData(&f_event->framerate, sizeof(float));
+        WriteData(&f_event->nHands, sizeof(uint32_t));
+        if(f_event->nHands > 0U) WriteData(f_event->pHands, sizeof(LEAP_HAND) * f_event->nHands);
+    }
+
+    l_size = static_cast<uint32_t>(m_record.size() - RF_RecordHeaderSize);
+    std::memcpy(m_record.data() + sizeof(l_type), &l_size, sizeof(l_size));
+
+    if(l_keyframe) m_index->Add(m_writtenBytes, f_hostTime, f_event->info.timestamp, f_event->tracking_frame_id);
+
+    f_file.write(reinterpret_cast<const char*>(m_record.data()), static_cast<std::streamsize>(m_record.size()));
+    m_writtenBytes += m_record.size();
+    m_writtenFrames++;
+}
+
+void CSessionRecorder::WriteData(const void *f_data, size_t f_size)
+{
+    const uint8_t *l_data = reinterpret_cast<const uint8_t*>(f_data);
+    m_record.insert(m_record.end(), l_data, l_data + f_size);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+class CFrameEncoder;
+class CSessionIndex;
+class CLeapFrame;
+
+// Streams tracking frames to append-only binary file from background writer, frames are dropped if queue is full
+class CSessionRecorder final
+{
+    std::atomic<bool> m_active;
+    std::atomic<bool> m_writing; // Cleared by writer thread on exit
+    std::thread *m_thread;
+    std::string m_path;
+    unsigned char m_format;
+    CFrameEncoder *m_encoder; // Owned by writer thread
+    CSessionIndex *m_index; // Owned by writer thread
+
+    // Single producer/single consumer queue
+    CLeapFrame *m_frames;
+    int64_t *m_hostTimes;
+    std::atomic<size_t> m_head; // Advanced by writer thread
+    std::atomic<size_t> m_tail; // Advanced by recording thread
+    std::vector<uint8_t> m_record; // Owned by writer thread
+
+    std::atomic<bool> m_failed;
+    std::atomic<uint64_t> m_writtenFrames;
+    std::atomic<uint64_t> m_droppedFrames;
+    std::atomic<uint64_t> m_writtenBytes;
+
+    CSessionRecorder(const CSessionRecorder &that) = delete;
+    CSessionRecorder& operator=(const CSessionRecorder &that) = delete;
+
+    void Join();
+    void ThreadUpdate();
+    void ThreadUpdateNative();
+    void WriteFrame(std::ofstream &f_file, const LEAP_TRACKING_EVENT *f_event, int64_t f_hostTime);
+    void WriteData(const void *f_data, size_t f_size);
+public:
+    // File starts with header of magic, version, size of LEAP_HAND and hands limit as 32-bit values.
+    // Each record is type byte and 32-bit payload size followed by payload.
+    enum RecordFormat : uint32_t
+    {
+        RF_Magic = 0x4345524CU, // "LREC"
+        RF_Version = 2U, // Compressed frames of version 1 were delta coded against previous frame only
+        RF_HeaderSize = 16U,
+        RF_RecordHeaderSize = 5U
+    };
+    // Frame payload is host time, frame id, timestamp and tracking frame id as 64-bit values, framerate, hands count and hands.
+    // Compressed frame payload is written by CFrameEncoder, index is written by CSessionIndex as last record on stop.
+    enum RecordType : uint8_t
+    {
+        RT_Frame = 1U,
+        RT_CompressedFrame,
+        RT_Index
+    };
+
+    // Compressed frames are written by CFrameEncoder, LeapC format is written by LeapRecordingWrite (.lmt)
+    enum SessionFormat : unsigned char
+    {
+        SF_Raw = 0U,
+        SF_Compressed,
+        SF_LeapC
+    };
+
+    CSessionRecorder();
+    ~CSessionRecorder();
+
+    // Called from recording thread only, stop doesn't wait for writer to drain queue and start waits for previous writer
+    void Start(const std::string &f_path, unsigned char f_format = SF_Raw);
+    void Stop();
+    bool IsRecording() const;
+    // Writer is still draining queue after stop, start doesn't block if it's false
+    bool IsWriting() const;
+    const std::string& GetPath() const;
+
+    // Deep copy, host time is steady clock in microseconds
+    void Push(const LEAP_TRACKING_EVENT *f_event, int64_t f_hostTime);
+
+    // Failed state is kept till next start
+    bool IsFailed() const;
+    uint64_t GetWrittenFrames() const;
+    uint64_t GetDroppedFrames() const;
+    uint64_t GetWrittenBytes() const;
+
+    static size_t GetQueueLimit();
+    // Uncompressed frames are indexed with this interval
+    static uint32_t GetIndexInterval();
+};
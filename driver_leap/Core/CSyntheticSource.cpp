@@ -0,0 +1,271 @@
+#include "stdafx.h"
+
+#include "Core/CSyntheticSource.h"
+#include "Core/CFrameHistory.h"
+#include "Core/CDriverConfig.h"
+#include "Core/CHandFusion.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CLeapPoller.h"
+
+#include "Utils/Utils.h"
+
+const float g_pi = glm::pi<float>();
+const float g_fingerOffsets[5U] = { -45.f, -22.f, 0.f, 20.f, 38.f }; // Along palm width for right hand, millimeters
+const float g_boneLengths[5U][4U] =
+{
+    { 20.f, 40.f, 30.f, 25.f }, // Thumb metacarpal isn't empty to keep bones directions defined
+    { 65.f, 40.f, 25.f, 20.f },
+    { 62.f, 45.f, 28.f, 22.f },
+    { 58.f, 42.f, 26.f, 22.f },
+    { 54.f, 33.f, 20.f, 20.f }
+};
+const float g_curlPeriod = 3.f; // Seconds of full finger curl cycle
+const float g_motionPeriod = 4.f; // Seconds of palm circle
+const float g_confidencePeriod = 2.f; // Seconds of confidence cycle, cycles of devices are evenly shifted
+const float g_dropoutPeriod = 5.f; // Seconds between tracking losses of same device
+const float g_dropoutLength = 0.5f; // Seconds, longer than frame lifetime of fusion
+
+CSyntheticSource::CSyntheticSource()
+{
+    m_active = false;
+    m_rate = 120.f;
+    m_handsCount = 2U;
+    m_devicesCount = 1U;
+    m_fusionMode = CDriverConfig::FM_None;
+    m_handFusion = new CHandFusion();
+    m_startTime = 0;
+    m_frameStart = 0;
+    m_lastIndex = -1;
+    m_generatedCount = 0U;
+    m_frameHistory = new CFrameHistory();
+    m_frame = new CLeapFrame();
+    m_interpolatedFrame = new CLeapFrame();
+    m_hands = new LEAP_HAND[CLeapFrame::GetHandsLimit()];
+}
+
+CSyntheticSource::~CSyntheticSource()
+{
+    delete m_handFusion;
+    delete m_frameHistory;
+    delete m_frame;
+    delete m_interpolatedFrame;
+    delete[] m_hands;
+}
+
+void CSyntheticSource::SetParameters(float f_rate, uint32_t f_handsCount, uint32_t f_devicesCount)
+{
+    m_rate = std::max(f_rate, 1.f);
+    m_handsCount = std::min(f_handsCount, CLeapFrame::GetHandsLimit());
+    m_devicesCount = glm::clamp(f_devicesCount, 1U, static_cast<uint32_t>(CHandFusion::GetDevicesLimit()));
+}
+
+void CSyntheticSource::SetFusionMode(unsigned char f_mode)
+{
+    m_fusionMode = f_mode;
+    m_handFusion->SetMode(f_mode);
+}
+
+void CSyntheticSource::SetDeviceExtrinsics(size_t f_device, const glm::vec3 &f_offset, const glm::quat &f_rotation)
+{
+    m_handFusion->SetExtrinsics(f_device, f_offset, f_rotation);
+}
+
+uint64_t CSyntheticSource::GetGeneratedFramesCount() const
+{
+    return m_generatedCount;
+}
+
+void CSyntheticSource::GenerateFrame(int64_t f_time, int64_t f_index, CLeapFrame &f_frame)
+{
+    const float l_time = static_cast<float>(static_cast<double>(f_time - m_startTime) / 1000000.0);
+
+    LEAP_TRACKING_EVENT l_event = { 0 };
+    l_event.info.frame_id = f_index;
+    l_event.info.timestamp = f_time;
+    l_event.tracking_frame_id = f_index;
+    l_event.framerate = m_rate;
+    l_event.nHands = m_handsCount;
+    l_event.pHands = m_hands;
+    if((m_devicesCount > 1U) && (m_fusionMode != CDriverConfig::FM_None))
+    {
+        // Device that lost tracking keeps frame from start of its dropout, fusion drops it after frame lifetime
+        for(uint32_t i = 0U; i < m_devicesCount; i++)
+        {
+            const float l_deviceTime = GetDeviceTime(l_time, i, m_devicesCount);
+            const float l_confidence = 0.6f + 0.3f * std::cos(2.f * g_pi * (l_deviceTime / g_confidencePeriod + static_cast<float>(i) / static_cast<float>(m_devicesCount)));
+            for(uint32_t j = 0U; j < m_handsCount; j++)
+            {
+                GenerateHand(l_deviceTime, j, m_hands[j]);
+                m_hands[j].confidence = l_confidence;
+                m_handFusion->ToDeviceSpace(i, m_hands[j]);
+            }
+            l_event.info.timestamp = f_time - static_cast<int64_t>(static_cast<double>(l_time - l_deviceTime) * 1000000.0);
+            m_handFusion->UpdateDevice(i, &l_event);
+        }
+        m_handFusion->Fuse(f_time, f_frame);
+    }
+    else
+    {
+        for(uint32_t i = 0U; i < m_handsCount; i++) GenerateHand(l_time, i, m_hands[i]);
+        f_frame.CopyEvent(&l_event);
+    }
+}
+
+// CTrackingSource
+bool CSyntheticSource::Initialize()
+{
+    if(!m_active)
+    {
+        m_startTime = CLeapPoller::GetHostTime();
+        m_frameStart = m_startTime;
+        m_lastIndex = -1;
+        m_generatedCount = 0U;
+        m_frameHistory->Clear();
+        m_frame->Clear();
+        m_interpolatedFrame->Clear();
+        m_active = true;
+    }
+    return m_active;
+}
+
+void CSyntheticSource::Terminate()
+{
+    m_active = false;
+}
+
+void CSyntheticSource::Update()
+{
+    if(m_active)
+    {
+        m_frameStart = CLeapPoller::GetHostTime();
+
+        // Frames passed since last update are generated to keep history continuous, limited by history size
+        const int64_t l_index = static_cast<int64_t>(static_cast<double>(m_frameStart - m_startTime) * static_cast<double>(m_rate) / 1000000.0);
+        for(int64_t i = std::max(m_lastIndex + 1, l_index - static_cast<int64_t>(CFrameHistory::GetLimit()) + 1); i <= l_index; i++)
+        {
+            GenerateFrame(GetFrameTime(i), i, *m_frame);
+            m_frameHistory->Push(m_frame->GetEvent());
+            m_generatedCount++;
+        }
+        m_lastIndex = std::max(m_lastIndex, l_index);
+
+        GenerateFrame(m_frameStart, l_index, *m_interpolatedFrame);
+    }
+}
+
+bool CSyntheticSource::IsConnected() const
+{
+    return m_active;
+}
+
+const LEAP_TRACKING_EVENT* CSyntheticSource::GetFrame()
+{
+    return ((m_active && (m_lastIndex >= 0)) ? m_frame->GetEvent() : nullptr);
+}
+
+const LEAP_TRACKING_EVENT* CSyntheticSource::GetInterpolatedFrame()
+{
+    return ((m_active && (m_lastIndex >= 0)) ? m_interpolatedFrame->GetEvent() : nullptr);
+}
+
+unsigned char CSyntheticSource::GetFramesAtTime(int64_t f_hostTime, CLeapFrame &f_before, CLeapFrame &f_after)
+{
+    return (m_active ? m_frameHistory->GetBracket(f_hostTime, f_before, f_after) : static_cast<unsigned char>(CFrameHistory::BR_None));
+}
+
+const CFrameHistory* CSyntheticSource::GetFrameHistory() const
+{
+    return m_frameHistory;
+}
+
+int64_t CSyntheticSource::GetFrameStartTime() const
+{
+    return m_frameStart;
+}
+
+// CSyntheticSource
+int64_t CSyntheticSource::GetFrameTime(int64_t f_index) const
+{
+    return (m_startTime + static_cast<int64_t>(static_cast<double>(f_index) * 1000000.0 / static_cast<double>(m_rate)));
+}
+
+// Dropouts of devices are evenly shifted and don't overlap, time of latest tracked frame is returned
+float CSyntheticSource::GetDeviceTime(float f_time, uint32_t f_device, uint32_t f_devicesCount)
+{
+    const float l_start = g_dropoutPeriod * (static_cast<float>(f_device) + 0.5f) / static_cast<float>(f_devicesCount);
+    float l_phase = std::fmod(f_time - l_start, g_dropoutPeriod);
+    if(l_phase < 0.f) l_phase += g_dropoutPeriod;
+    return ((l_phase < g_dropoutLength) ? (f_time - l_phase) : f_time);
+}
+
+// Palm moves on vertical circle and rolls, fingers curl one after another. Units and axes are of Leap Motion.
+void CSyntheticSource::GenerateHand(float f_time, uint32_t f_index, LEAP_HAND &f_hand)
+{
+    std::memset(&f_hand, 0, sizeof(LEAP_HAND));
+
+    const bool l_left = ((f_index % 2U) == 0U);
+    const float l_side = (l_left ? -1.f : 1.f);
+    const float l_phase = static_cast<float>(f_index) * 0.5f;
+    const float l_motionAngle = 2.f * g_pi * f_time / g_motionPeriod + l_phase;
+
+    f_hand.id = f_index + 1U;
+    f_hand.type = (l_left ? eLeapHandType_Left : eLeapHandType_Right);
+    f_hand.confidence = 1.f;
+    f_hand.visible_time = static_cast<uint64_t>(f_time * 1000000.f);
+
+    // Palm basis is normal cross direction, negative normal and negative direction
+    const glm::quat l_rotation = glm::angleAxis(0.2f * std::sin(l_motionAngle), glm::vec3(0.f, 1.f, 0.f)) * glm::angleAxis(l_side * 0.3f * std::sin(l_motionAngle * 0.5f), glm::vec3(0.f, 0.f, 1.f));
+    const glm::vec3 l_center(l_side * 120.f, 250.f, -100.f * static_cast<float>(f_index / 2U));
+    const glm::vec3 l_position = l_center + glm::vec3(40.f * std::cos(l_motionAngle), 40.f * std::sin(l_motionAngle), 0.f);
+    const glm::vec3 l_velocity = glm::vec3(-std::sin(l_motionAngle), std::cos(l_motionAngle), 0.f) * (40.f * 2.f * g_pi / g_motionPeriod);
+    const glm::vec3 l_normal = l_rotation * glm::vec3(0.f, -1.f, 0.f);
+    const glm::vec3 l_direction = l_rotation * glm::vec3(0.f, 0.f, -1.f);
+
+    LEAP_PALM &l_palm = f_hand.palm;
+    ConvertVector3(l_position, l_palm.position);
+    l_palm.stabilized_position = l_palm.position;
+    ConvertVector3(l_velocity, l_palm.velocity);
+    ConvertVector3(l_normal, l_palm.normal);
+    ConvertVector3(l_direction, l_palm.direction);
+    l_palm.width = 85.f;
+    ConvertQuaternion(l_rotation, l_palm.orientation);
+
+    float l_curlSum = 0.f;
+    for(size_t i = 0U; i < 5U; i++)
+    {
+        const float l_curl = 0.5f - 0.5f * std::cos(2.f * g_pi * f_time / g_curlPeriod + l_phase + static_cast<float>(i) * 0.4f);
+        l_curlSum += l_curl;
+
+        LEAP_DIGIT &l_digit = f_hand.digits[i];
+        l_digit.finger_id = static_cast<int32_t>(f_index * 5U + i);
+        l_digit.is_extended = ((l_curl < 0.5f) ? 1U : 0U);
+
+        // Metacarpals start behind palm center, each next joint bends towards palm
+        glm::vec3 l_joint = l_position + l_rotation * glm::vec3(l_side * g_fingerOffsets[i] * 0.6f, 0.f, 40.f);
+        float l_bend = 0.f;
+        for(size_t j = 0U; j < 4U; j++)
+        {
+            if(j > 0U) l_bend += (0.05f + l_curl * 0.4f * g_pi); // Joints are never fully straight as in real hands
+            const glm::quat l_boneRotation = l_rotation * glm::angleAxis(-l_bend, glm::vec3(1.f, 0.f, 0.f));
+            const glm::vec3 l_next = l_joint + l_boneRotation * glm::vec3((j == 0U) ? l_side * g_fingerOffsets[i] * 0.4f : 0.f, 0.f, -g_boneLengths[i][j]);
+
+            LEAP_BONE &l_bone = l_digit.bones[j];
+            ConvertVector3(l_joint, l_bone.prev_joint);
+            ConvertVector3(l_next, l_bone.next_joint);
+            l_bone.width = 16.f;
+            ConvertQuaternion(l_boneRotation, l_bone.rotation);
+            l_joint = l_next;
+        }
+    }
+    f_hand.grab_strength = l_curlSum / 5.f;
+    f_hand.grab_angle = f_hand.grab_strength * g_pi;
+    f_hand.pinch_strength = f_hand.grab_strength;
+    f_hand.pinch_distance = 60.f * (1.f - f_hand.pinch_strength);
+
+    const glm::vec3 l_wrist = l_position + l_rotation * glm::vec3(0.f, 0.f, 60.f);
+    const glm::vec3 l_elbow = l_wrist + l_rotation * glm::vec3(0.f, 0.f, 250.f);
+    ConvertVector3(l_elbow, f_hand.arm.prev_joint);
+    ConvertVector3(l_wrist, f_hand.arm.next_joint);
+    f_hand.arm.width = 60.f;
+    f_hand.arm.rotation = l_palm.orientation;
+}
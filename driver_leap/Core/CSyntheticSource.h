@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Core/CTrackingSource.h"
+
+class CFrameHistory;
+class CHandFusion;
+class CLeapFrame;
+
+// Tracking source without device that generates parametric hand motion in host clock.
+// Frames are computed from time only, so output doesn't depend on update rate of driver.
+// Several devices see same hands in own spaces with alternating confidence and take turns in losing tracking, their frames are fused as by poller.
+class CSyntheticSource final : public CTrackingSource
+{
+    bool m_active;
+    float m_rate;
+    uint32_t m_handsCount;
+    uint32_t m_devicesCount;
+    unsigned char m_fusionMode;
+    CHandFusion *m_handFusion;
+    int64_t m_startTime;
+    int64_t m_frameStart;
+    int64_t m_lastIndex; // Index of latest generated frame, negative before first
+    uint64_t m_generatedCount;
+    CFrameHistory *m_frameHistory;
+    CLeapFrame *m_frame;
+    CLeapFrame *m_interpolatedFrame;
+    LEAP_HAND *m_hands; // Generation buffer
+
+    CSyntheticSource(const CSyntheticSource &that) = delete;
+    CSyntheticSource& operator=(const CSyntheticSource &that) = delete;
+
+    int64_t GetFrameTime(int64_t f_index) const;
+
+    static void GenerateHand(float f_time, uint32_t f_index, LEAP_HAND &f_hand);
+    static float GetDeviceTime(float f_time, uint32_t f_device, uint32_t f_devicesCount);
+public:
+    CSyntheticSource();
+    ~CSyntheticSource();
+
+    // Applied on next initialization, rate is in frames per second
+    void SetParameters(float f_rate, uint32_t f_handsCount, uint32_t f_devicesCount = 1U);
+    // Several devices are fused unless fusion mode is none, then only first device is generated
+    void SetFusionMode(unsigned char f_mode);
+    // Offset in meters and rotation from device to first device space
+    void SetDeviceExtrinsics(size_t f_device, const glm::vec3 &f_offset, const glm::quat &f_rotation);
+    uint64_t GetGeneratedFramesCount() const;
+    // Frame at host time without history update, time is counted from initialization
+    void GenerateFrame(int64_t f_time, int64_t f_index, CLeapFrame &f_frame);
+
+    // CTrackingSource
+    bool Initialize() override;
+    void Terminate() override;
+    void Update() override;
+    bool IsConnected() const override;
+    const LEAP_TRACKING_EVENT* GetFrame() override;
+    // Frame generated exactly at start of current RunFrame
+    const LEAP_TRACKING_EVENT* GetInterpolatedFrame() override;
+    unsigned char GetFramesAtTime(int64_t f_hostTime, CLeapFrame &f_before, CLeapFrame &f_after) override;
+    const CFrameHistory* GetFrameHistory() const override;
+    int64_t GetFrameStartTime() const override;
+};
@@ -0,0 +1,167 @@
+#include "stdafx.h"
+
+#include "Core/CTelemetryBlock.h"
+
+#ifdef _WIN32
+const char g_blockName[] = "Local\\driver_leap_telemetry";
+#else
+const char g_blockName[] = "/driver_leap_telemetry";
+#endif
+
+CTelemetryBlock::CTelemetryBlock()
+{
+#ifdef _WIN32
+    m_mapping = NULL;
+#else
+    m_file = -1;
+#endif
+    m_memory = nullptr;
+    m_header = nullptr;
+    m_data = nullptr;
+    m_owner = false;
+}
+
+CTelemetryBlock::~CTelemetryBlock()
+{
+    Close();
+}
+
+bool CTelemetryBlock::Create()
+{
+    Close();
+    if(Map(true))
+    {
+        m_owner = true;
+
+        // Block of crashed writer is reused, its readers see odd sequence until reset is done
+        const uint32_t l_sequence = (m_header->m_sequence.load(std::memory_order_relaxed) + 1U) | 1U;
+        m_header->m_sequence.store(l_sequence, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_header->m_magic = BF_Magic;
+        m_header->m_version = BF_Version;
+        m_header->m_dataSize = static_cast<uint32_t>(sizeof(BlockData));
+        std::memset(m_data, 0, sizeof(BlockData));
+        m_header->m_sequence.store(l_sequence + 1U, std::memory_order_release);
+    }
+    return IsOpen();
+}
+
+bool CTelemetryBlock::Open()
+{
+    Close();
+    if(Map(false))
+    {
+        if((m_header->m_magic != BF_Magic) || (m_header->m_version != BF_Version) || (m_header->m_dataSize != sizeof(BlockData))) Close();
+    }
+    return IsOpen();
+}
+
+void CTelemetryBlock::Close()
+{
+#ifdef _WIN32
+    if(m_memory) UnmapViewOfFile(m_memory);
+    if(m_mapping) CloseHandle(m_mapping);
+    m_mapping = NULL;
+#else
+    if(m_memory) munmap(m_memory, sizeof(BlockHeader) + sizeof(BlockData));
+    if(m_file != -1)
+    {
+        close(m_file);
+        if(m_owner) shm_unlink(g_blockName);
+    }
+    m_file = -1;
+#endif
+    m_memory = nullptr;
+    m_header = nullptr;
+    m_data = nullptr;
+    m_owner = false;
+}
+
+bool CTelemetryBlock::IsOpen() const
+{
+    return (m_memory != nullptr);
+}
+
+void CTelemetryBlock::Write(const BlockData &f_data)
+{
+    if(m_owner)
+    {
+        const uint32_t l_sequence = m_header->m_sequence.load(std::memory_order_relaxed);
+        m_header->m_sequence.store(l_sequence + 1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(m_data, &f_data, sizeof(BlockData));
+        m_header->m_sequence.store(l_sequence + 2U, std::memory_order_release);
+    }
+}
+
+bool CTelemetryBlock::Read(BlockData &f_data, uint32_t f_attempts) const
+{
+    bool l_result = false;
+    if(m_memory)
+    {
+        for(uint32_t i = 0U; (i < f_attempts) && !l_result; i++)
+        {
+            const uint32_t l_sequence = m_header->m_sequence.load(std::memory_order_acquire);
+            if((l_sequence & 1U) == 0U)
+            {
+                std::memcpy(&f_data, m_data, sizeof(BlockData));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                l_result = (m_header->m_sequence.load(std::memory_order_relaxed) == l_sequence);
+            }
+            if(!l_result) std::this_thread::yield();
+        }
+    }
+    return l_result;
+}
+
+const char* CTelemetryBlock::GetName()
+{
+    return g_blockName;
+}
+
+// Readers map block as read-only
+bool CTelemetryBlock::Map(bool f_create)
+{
+    static_assert(ATOMIC_INT_LOCK_FREE == 2, "Sequence has to be lock-free to be shared between processes");
+    static_assert((sizeof(BlockHeader) % 8U) == 0U, "Data has to be aligned");
+
+    const size_t l_size = sizeof(BlockHeader) + sizeof(BlockData);
+#ifdef _WIN32
+    if(f_create) m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, static_cast<DWORD>(l_size), g_blockName);
+    else m_mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, g_blockName);
+    if(m_mapping)
+    {
+        m_memory = reinterpret_cast<uint8_t*>(MapViewOfFile(m_mapping, f_create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, l_size));
+        if(!m_memory)
+        {
+            CloseHandle(m_mapping);
+            m_mapping = NULL;
+        }
+    }
+#else
+    m_file = (f_create ? shm_open(g_blockName, O_CREAT | O_RDWR, 0644) : shm_open(g_blockName, O_RDONLY, 0));
+    if(m_file != -1)
+    {
+        struct stat l_stat;
+        bool l_sized = false;
+        if(f_create) l_sized = (ftruncate(m_file, static_cast<off_t>(l_size)) == 0);
+        else l_sized = ((fstat(m_file, &l_stat) == 0) && (static_cast<size_t>(l_stat.st_size) >= l_size));
+        if(l_sized)
+        {
+            void *l_memory = mmap(nullptr, l_size, f_create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, m_file, 0);
+            if(l_memory != MAP_FAILED) m_memory = reinterpret_cast<uint8_t*>(l_memory);
+        }
+        if(!m_memory)
+        {
+            close(m_file);
+            m_file = -1;
+        }
+    }
+#endif
+    if(m_memory)
+    {
+        m_header = reinterpret_cast<BlockHeader*>(m_memory);
+        m_data = reinterpret_cast<BlockData*>(m_memory + sizeof(BlockHeader));
+    }
+    return (m_memory != nullptr);
+}
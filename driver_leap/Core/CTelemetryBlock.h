@@ -0,0 +1,102 @@
+#pragma once
+
+// Named shared memory with latest driver state, written by driver after each RunFrame and read by any local process.
+// Header is followed by data, writer increments sequence before and after data update, so odd or changed sequence means torn read.
+class CTelemetryBlock final
+{
+public:
+    enum BlockFormat : uint32_t
+    {
+        BF_Magic = 0x4D4C4C54U, // "TLLM"
+        BF_Version = 1U,
+        BF_HandsCount = 2U,
+        BF_GesturesLimit = 16U, // Not less than CGestureMatcher::HG_Count
+        BF_ButtonsLimit = 32U
+    };
+    enum LatencyValue : size_t
+    {
+        LV_P50 = 0U,
+        LV_P90,
+        LV_P99,
+        LV_Max,
+
+        LV_Count
+    };
+
+    // Latencies are submit latencies over sliding window in microseconds, gestures and buttons are of latest present hand
+    struct HandData
+    {
+        uint8_t m_present; // In latest submitted frame
+        uint8_t m_enabled;
+        uint8_t m_gesturesCount;
+        uint8_t m_buttonsCount;
+        uint32_t m_buttonStates; // Bit for each button
+        uint64_t m_latencyCount;
+        int64_t m_latencies[LV_Count];
+        float m_gestures[BF_GesturesLimit]; // CGestureMatcher::HandGesture order
+        float m_buttonValues[BF_ButtonsLimit]; // Order of controller buttons
+    };
+    // Frame counters are totals since source change, framerates are measured over last second
+    struct BlockData
+    {
+        uint64_t m_runFrames;
+        int64_t m_hostTime; // Steady clock in microseconds at publish
+        uint8_t m_connected;
+        uint8_t m_sourceType; // CDriverConfig::TrackingSource value
+        uint8_t m_replaying;
+        uint8_t m_recording;
+        uint32_t m_devicesCount;
+        uint32_t m_reconnectsCount;
+        float m_frameRate; // Frames received by poller
+        float m_submitRate; // Frames submitted to controllers
+        uint32_t m_reserved;
+        uint64_t m_framesCount;
+        uint64_t m_skippedFrames;
+        uint64_t m_duplicatedFrames;
+        uint64_t m_restartsCount;
+        uint64_t m_submittedFrames;
+        uint64_t m_skippedSubmits;
+        uint64_t m_duplicatedSubmits;
+        uint64_t m_recorderDrops;
+        HandData m_hands[BF_HandsCount];
+    };
+private:
+    struct BlockHeader
+    {
+        uint32_t m_magic;
+        uint32_t m_version;
+        uint32_t m_dataSize;
+        std::atomic<uint32_t> m_sequence;
+    };
+
+#ifdef _WIN32
+    HANDLE m_mapping;
+#else
+    int m_file;
+#endif
+    uint8_t *m_memory;
+    BlockHeader *m_header;
+    BlockData *m_data;
+    bool m_owner;
+
+    CTelemetryBlock(const CTelemetryBlock &that) = delete;
+    CTelemetryBlock& operator=(const CTelemetryBlock &that) = delete;
+
+    bool Map(bool f_create);
+public:
+    CTelemetryBlock();
+    ~CTelemetryBlock();
+
+    // Writer creates block and removes it on close, reader opens existing block of same version
+    bool Create();
+    bool Open();
+    void Close();
+    bool IsOpen() const;
+
+    // Single writer only
+    void Write(const BlockData &f_data);
+    // False if block isn't open or writer was updating data for all attempts
+    bool Read(BlockData &f_data, uint32_t f_attempts = 16U) const;
+
+    static const char* GetName();
+};
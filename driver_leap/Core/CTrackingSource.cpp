@@ -0,0 +1,11 @@
+#include "stdafx.h"
+
+#include "Core/CTrackingSource.h"
+
+CTrackingSource::CTrackingSource()
+{
+}
+
+CTrackingSource::~CTrackingSource()
+{
+}
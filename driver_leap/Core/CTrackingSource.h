@@ -0,0 +1,32 @@
+#pragma once
+
+class CFrameHistory;
+class CLeapFrame;
+
+// Provider of hand frames for driver pipeline, frames are in LeapC layout and source clock
+class CTrackingSource
+{
+    CTrackingSource(const CTrackingSource &that) = delete;
+    CTrackingSource& operator=(const CTrackingSource &that) = delete;
+public:
+    CTrackingSource();
+    virtual ~CTrackingSource();
+
+    // Start and stop of frames production
+    virtual bool Initialize() = 0;
+    virtual void Terminate() = 0;
+
+    // Called at start of every RunFrame
+    virtual void Update() = 0;
+    virtual bool IsConnected() const = 0;
+
+    // Latest frame and frame at start of current RunFrame, nullptr if there is none
+    virtual const LEAP_TRACKING_EVENT* GetFrame() = 0;
+    virtual const LEAP_TRACKING_EVENT* GetInterpolatedFrame() = 0;
+
+    // Host time is steady clock in microseconds, result is CFrameHistory::BracketResult
+    virtual unsigned char GetFramesAtTime(int64_t f_hostTime, CLeapFrame &f_before, CLeapFrame &f_after) = 0;
+    virtual const CFrameHistory* GetFrameHistory() const = 0;
+    // Start of current RunFrame in source clock
+    virtual int64_t GetFrameStartTime() const = 0;
+};
@@ -4,6 +4,9 @@
 #include "Devices/CLeapController/CControllerButton.h"
 
 #include "Core/CDriverConfig.h"
+#include "Core/CLeapPoller.h"
+#include "Utils/CFrameProfiler.h"
+#include "Utils/CStageTimer.h"
 #include "Utils/Utils.h"
 
 const glm::quat g_reverseRotation(0.f, 0.f, 0.70106769f, -0.70106769f);
@@ -25,6 +28,7 @@ CLeapController::CLeapController()
     m_trackedDevice = vr::k_unTrackedDeviceIndexInvalid;
     m_haptic = vr::k_ulInvalidPropertyContainer;
 
+    m_submitTime = 0;
     m_pose = { 0 };
     m_pose.deviceIsConnected = false;
     for(size_t i = 0U; i < 3U; i++)
@@ -128,35 +132,71 @@ void CLeapController::RunFrame(const LEAP_HAND *f_hand, const LEAP_HAND *f_oppHa
     {
         if(m_isEnabled)
         {
-            UpdateTransformation(f_hand);
-            UpdateInputInterop();
-            vr::VRServerDriverHost()->TrackedDevicePoseUpdated(m_trackedDevice, m_pose, sizeof(vr::DriverPose_t));
-
-            UpdateGestures(f_hand, f_oppHand);
+            {
+                STAGE_TIMER(CFrameProfiler::FS_Transformation);
+                UpdateTransformation(f_hand);
+            }
+            {
+                // Pose submit is server call too
+                STAGE_TIMER(CFrameProfiler::FS_Interop);
+                UpdateInputInterop();
+                m_submitTime = CLeapPoller::GetHostTime();
+                vr::VRServerDriverHost()->TrackedDevicePoseUpdated(m_trackedDevice, m_pose, sizeof(vr::DriverPose_t));
+            }
+            {
+                STAGE_TIMER(CFrameProfiler::FS_Gestures);
+                UpdateGestures(f_hand, f_oppHand);
+            }
             UpdateInput();
         }
         else vr::VRServerDriverHost()->TrackedDevicePoseUpdated(m_trackedDevice, m_pose, sizeof(vr::DriverPose_t));
     }
 }
 
+int64_t CLeapController::GetSubmitTime() const
+{
+    return m_submitTime;
+}
+
+const std::vector<float>& CLeapController::GetGestures() const
+{
+    return m_gestures;
+}
+
+size_t CLeapController::GetButtonsCount() const
+{
+    return m_buttons.size();
+}
+
+const CControllerButton* CLeapController::GetButton(size_t f_index) const
+{
+    return ((f_index < m_buttons.size()) ? m_buttons[f_index] : nullptr);
+}
+
 void CLeapController::UpdateInput()
 {
-    for(auto l_button : m_buttons)
     {
-        if(l_button->IsUpdated())
+        STAGE_TIMER(CFrameProfiler::FS_Input);
+        for(auto l_button : m_buttons)
         {
-            switch(l_button->GetInputType())
+            if(l_button->IsUpdated())
             {
-                case CControllerButton::IT_Boolean:
-                    vr::VRDriverInput()->UpdateBooleanComponent(l_button->GetHandle(), l_button->GetState(), .0);
-                    break;
-                case CControllerButton::IT_Float:
-                    vr::VRDriverInput()->UpdateScalarComponent(l_button->GetHandle(), l_button->GetValue(), .0);
-                    break;
+                switch(l_button->GetInputType())
+                {
+                    case CControllerButton::IT_Boolean:
+                        vr::VRDriverInput()->UpdateBooleanComponent(l_button->GetHandle(), l_button->GetState(), .0);
+                        break;
+                    case CControllerButton::IT_Float:
+                        vr::VRDriverInput()->UpdateScalarComponent(l_button->GetHandle(), l_button->GetValue(), .0);
+                        break;
+                }
+                l_button->ResetUpdate();
             }
-            l_button->ResetUpdate();
         }
     }
+
+    // Skeleton of Index controller
+    STAGE_TIMER(CFrameProfiler::FS_Skeleton);
     UpdateInputInternal();
 }
 
@@ -9,6 +9,7 @@ class CLeapController : public vr::ITrackedDeviceServerDriver
     static glm::mat4 ms_world_transform;
     
     vr::DriverPose_t m_pose;
+    int64_t m_submitTime;
 
     CLeapController(const CLeapController &that) = delete;
     CLeapController& operator=(const CLeapController &that) = delete;
@@ -51,6 +52,12 @@ public:
     void SetEnabled(bool f_state);
 
     void RunFrame(const LEAP_HAND *f_hand, const LEAP_HAND *f_oppHand);
+    // Host time in microseconds of latest pose submit of enabled controller
+    int64_t GetSubmitTime() const;
+    // Latest matched gestures, empty before first hand
+    const std::vector<float>& GetGestures() const;
+    size_t GetButtonsCount() const;
+    const CControllerButton* GetButton(size_t f_index) const;
 
     static void UpdateHMDCoordinates();
 protected:
@@ -62,6 +69,7 @@ protected:
     unsigned char m_hand;
     unsigned char m_type;
     std::vector<CControllerButton*> m_buttons;
+    std::vector<float> m_gestures;
     bool m_isEnabled;
 
     virtual void ActivateInternal();
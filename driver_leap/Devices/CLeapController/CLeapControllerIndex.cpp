@@ -292,22 +292,21 @@ void CLeapControllerIndex::UpdateGestures(const LEAP_HAND *f_hand, const LEAP_HA
 {
     if(f_hand)
     {
-        std::vector<float> l_gestures;
-        CGestureMatcher::GetGestures(f_hand, l_gestures, f_oppHand);
+        CGestureMatcher::GetGestures(f_hand, m_gestures, f_oppHand);
 
-        m_buttons[IB_TriggerValue]->SetValue(l_gestures[CGestureMatcher::HG_Trigger]);
-        m_buttons[IB_TriggerClick]->SetState(l_gestures[CGestureMatcher::HG_Trigger] >= 0.75f);
+        m_buttons[IB_TriggerValue]->SetValue(m_gestures[CGestureMatcher::HG_Trigger]);
+        m_buttons[IB_TriggerClick]->SetState(m_gestures[CGestureMatcher::HG_Trigger] >= 0.75f);
 
-        m_buttons[IB_GripValue]->SetValue(l_gestures[CGestureMatcher::HG_Grab]);
-        m_buttons[IB_GripTouch]->SetState(l_gestures[CGestureMatcher::HG_Grab] >= 0.25f);
-        m_buttons[IB_GripForce]->SetValue((l_gestures[CGestureMatcher::HG_Grab] >= 0.75f) ? (l_gestures[CGestureMatcher::HG_Grab] - 0.75f) * 4.f : 0.f);
+        m_buttons[IB_GripValue]->SetValue(m_gestures[CGestureMatcher::HG_Grab]);
+        m_buttons[IB_GripTouch]->SetState(m_gestures[CGestureMatcher::HG_Grab] >= 0.25f);
+        m_buttons[IB_GripForce]->SetValue((m_gestures[CGestureMatcher::HG_Grab] >= 0.75f) ? (m_gestures[CGestureMatcher::HG_Grab] - 0.75f) * 4.f : 0.f);
 
-        m_buttons[IB_TrackpadTouch]->SetState(l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f);
-        m_buttons[IB_TrackpadForce]->SetState((l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f) ? (l_gestures[CGestureMatcher::HG_ThumbPress] - 0.5f) *2.f : 0.f);
-        if(l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f)
+        m_buttons[IB_TrackpadTouch]->SetState(m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f);
+        m_buttons[IB_TrackpadForce]->SetState((m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f) ? (m_gestures[CGestureMatcher::HG_ThumbPress] - 0.5f) *2.f : 0.f);
+        if(m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f)
         {
-            m_buttons[IB_TrackpadX]->SetValue(l_gestures[CGestureMatcher::HG_PalmPointX]);
-            m_buttons[IB_TrackpadY]->SetValue(l_gestures[CGestureMatcher::HG_PalmPointY]);
+            m_buttons[IB_TrackpadX]->SetValue(m_gestures[CGestureMatcher::HG_PalmPointX]);
+            m_buttons[IB_TrackpadY]->SetValue(m_gestures[CGestureMatcher::HG_PalmPointY]);
         }
         else
         {
@@ -315,22 +314,22 @@ void CLeapControllerIndex::UpdateGestures(const LEAP_HAND *f_hand, const LEAP_HA
             m_buttons[IB_TrackpadY]->SetValue(0.f);
         }
 
-        m_buttons[IB_SystemTouch]->SetState(l_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.5f);
-        m_buttons[IB_SystemClick]->SetState(l_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.75f);
+        m_buttons[IB_SystemTouch]->SetState(m_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.5f);
+        m_buttons[IB_SystemClick]->SetState(m_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.75f);
 
-        m_buttons[IB_BTouch]->SetState(l_gestures[CGestureMatcher::HG_PalmTouch] >= 0.5f);
-        m_buttons[IB_BClick]->SetState(l_gestures[CGestureMatcher::HG_PalmTouch] >= 0.75f);
+        m_buttons[IB_BTouch]->SetState(m_gestures[CGestureMatcher::HG_PalmTouch] >= 0.5f);
+        m_buttons[IB_BClick]->SetState(m_gestures[CGestureMatcher::HG_PalmTouch] >= 0.75f);
 
-        m_buttons[IB_ATouch]->SetState(l_gestures[CGestureMatcher::HG_MiddleCrossTouch] >= 0.5f);
-        m_buttons[IB_AClick]->SetState(l_gestures[CGestureMatcher::HG_MiddleCrossTouch] >= 0.75f);
+        m_buttons[IB_ATouch]->SetState(m_gestures[CGestureMatcher::HG_MiddleCrossTouch] >= 0.5f);
+        m_buttons[IB_AClick]->SetState(m_gestures[CGestureMatcher::HG_MiddleCrossTouch] >= 0.75f);
 
-        m_buttons[IB_ThumbstickTouch]->SetState(l_gestures[CGestureMatcher::HG_ThumbCrossTouch] >= 0.5f);
-        m_buttons[IB_ThumbstickClick]->SetState(l_gestures[CGestureMatcher::HG_ThumbCrossTouch] >= 0.75f);
+        m_buttons[IB_ThumbstickTouch]->SetState(m_gestures[CGestureMatcher::HG_ThumbCrossTouch] >= 0.5f);
+        m_buttons[IB_ThumbstickClick]->SetState(m_gestures[CGestureMatcher::HG_ThumbCrossTouch] >= 0.75f);
 
-        m_buttons[IB_FingerIndex]->SetValue(l_gestures[CGestureMatcher::HG_IndexBend]);
-        m_buttons[IB_FingerMiddle]->SetValue(l_gestures[CGestureMatcher::HG_MiddleBend]);
-        m_buttons[IB_FingerRing]->SetValue(l_gestures[CGestureMatcher::HG_RingBend]);
-        m_buttons[IB_FingerPinky]->SetValue(l_gestures[CGestureMatcher::HG_PinkyBend]);
+        m_buttons[IB_FingerIndex]->SetValue(m_gestures[CGestureMatcher::HG_IndexBend]);
+        m_buttons[IB_FingerMiddle]->SetValue(m_gestures[CGestureMatcher::HG_MiddleBend]);
+        m_buttons[IB_FingerRing]->SetValue(m_gestures[CGestureMatcher::HG_RingBend]);
+        m_buttons[IB_FingerPinky]->SetValue(m_gestures[CGestureMatcher::HG_PinkyBend]);
 
         const glm::quat rotateHalfPiZ(0.70106769f, 0.f, 0.f, 0.70106769f);
         const glm::quat rotateHalfPiX(0.70106769f, 0.70106769f, 0.f, 0.f);
@@ -145,21 +145,20 @@ void CLeapControllerOculus::UpdateGestures(const LEAP_HAND *f_hand, const LEAP_H
 {
     if(f_hand)
     {
-        std::vector<float> l_gestures;
-        CGestureMatcher::GetGestures(f_hand, l_gestures, f_oppHand);
+        CGestureMatcher::GetGestures(f_hand, m_gestures, f_oppHand);
 
-        m_buttons[TB_TriggerValue]->SetValue(l_gestures[CGestureMatcher::HG_Trigger]);
-        m_buttons[TB_TriggerTouch]->SetState(l_gestures[CGestureMatcher::HG_Trigger] >= 0.25f);
+        m_buttons[TB_TriggerValue]->SetValue(m_gestures[CGestureMatcher::HG_Trigger]);
+        m_buttons[TB_TriggerTouch]->SetState(m_gestures[CGestureMatcher::HG_Trigger] >= 0.25f);
 
-        m_buttons[TB_GripValue]->SetValue(l_gestures[CGestureMatcher::HG_Grab]);
-        m_buttons[TB_GripTouch]->SetState(l_gestures[CGestureMatcher::HG_Grab] >= 0.25f);
+        m_buttons[TB_GripValue]->SetValue(m_gestures[CGestureMatcher::HG_Grab]);
+        m_buttons[TB_GripTouch]->SetState(m_gestures[CGestureMatcher::HG_Grab] >= 0.25f);
 
-        m_buttons[TB_JoystickTouch]->SetValue(l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f);
-        m_buttons[TB_JoystickClick]->SetValue(l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.85f);
-        if(l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f)
+        m_buttons[TB_JoystickTouch]->SetValue(m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f);
+        m_buttons[TB_JoystickClick]->SetValue(m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.85f);
+        if(m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f)
         {
-            m_buttons[TB_JoystickX]->SetValue(l_gestures[CGestureMatcher::HG_PalmPointX]);
-            m_buttons[TB_JoystickY]->SetValue(l_gestures[CGestureMatcher::HG_PalmPointY]);
+            m_buttons[TB_JoystickX]->SetValue(m_gestures[CGestureMatcher::HG_PalmPointX]);
+            m_buttons[TB_JoystickY]->SetValue(m_gestures[CGestureMatcher::HG_PalmPointY]);
         }
         else
         {
@@ -167,13 +166,13 @@ void CLeapControllerOculus::UpdateGestures(const LEAP_HAND *f_hand, const LEAP_H
             m_buttons[TB_JoystickY]->SetValue(0.f);
         }
 
-        m_buttons[TB_SystemTouch]->SetState(l_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.5f);
-        m_buttons[TB_SystemClick]->SetState(l_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.75f);
+        m_buttons[TB_SystemTouch]->SetState(m_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.5f);
+        m_buttons[TB_SystemClick]->SetState(m_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.75f);
 
-        m_buttons[(m_hand == CH_Left) ? TB_YTouch : TB_BTouch]->SetState(l_gestures[CGestureMatcher::HG_PalmTouch] >= 0.5f);
-        m_buttons[(m_hand == CH_Left) ? TB_YClick : TB_BClick]->SetState(l_gestures[CGestureMatcher::HG_PalmTouch] >= 0.75f);
+        m_buttons[(m_hand == CH_Left) ? TB_YTouch : TB_BTouch]->SetState(m_gestures[CGestureMatcher::HG_PalmTouch] >= 0.5f);
+        m_buttons[(m_hand == CH_Left) ? TB_YClick : TB_BClick]->SetState(m_gestures[CGestureMatcher::HG_PalmTouch] >= 0.75f);
 
-        m_buttons[(m_hand == CH_Left) ? TB_XTouch : TB_ATouch]->SetState(l_gestures[CGestureMatcher::HG_MiddleCrossTouch] >= 0.5f);
-        m_buttons[(m_hand == CH_Left) ? TB_XClick : TB_AClick]->SetState(l_gestures[CGestureMatcher::HG_MiddleCrossTouch] >= 0.75f);
+        m_buttons[(m_hand == CH_Left) ? TB_XTouch : TB_ATouch]->SetState(m_gestures[CGestureMatcher::HG_MiddleCrossTouch] >= 0.5f);
+        m_buttons[(m_hand == CH_Left) ? TB_XClick : TB_AClick]->SetState(m_gestures[CGestureMatcher::HG_MiddleCrossTouch] >= 0.75f);
     }
 }
@@ -128,20 +128,19 @@ void CLeapControllerVive::UpdateGestures(const LEAP_HAND *f_hand, const LEAP_HAN
 {
     if(f_hand)
     {
-        std::vector<float> l_gestures;
-        CGestureMatcher::GetGestures(f_hand, l_gestures, f_oppHand);
+        CGestureMatcher::GetGestures(f_hand, m_gestures, f_oppHand);
 
-        m_buttons[VB_TriggerValue]->SetValue(l_gestures[CGestureMatcher::HG_Trigger]);
-        m_buttons[VB_TriggerClick]->SetState(l_gestures[CGestureMatcher::HG_Trigger] >= 0.75f);
+        m_buttons[VB_TriggerValue]->SetValue(m_gestures[CGestureMatcher::HG_Trigger]);
+        m_buttons[VB_TriggerClick]->SetState(m_gestures[CGestureMatcher::HG_Trigger] >= 0.75f);
 
-        m_buttons[VB_GripClick]->SetValue(l_gestures[CGestureMatcher::HG_Grab] >= 0.75f);
+        m_buttons[VB_GripClick]->SetValue(m_gestures[CGestureMatcher::HG_Grab] >= 0.75f);
 
-        m_buttons[VB_TrackpadTouch]->SetState(l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f);
-        m_buttons[VB_TrackpadClick]->SetState(l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.85f);
-        if(l_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f)
+        m_buttons[VB_TrackpadTouch]->SetState(m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f);
+        m_buttons[VB_TrackpadClick]->SetState(m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.85f);
+        if(m_gestures[CGestureMatcher::HG_ThumbPress] >= 0.5f)
         {
-            m_buttons[VB_TrackpadX]->SetValue(l_gestures[CGestureMatcher::HG_PalmPointX]);
-            m_buttons[VB_TrackpadY]->SetValue(l_gestures[CGestureMatcher::HG_PalmPointY]);
+            m_buttons[VB_TrackpadX]->SetValue(m_gestures[CGestureMatcher::HG_PalmPointX]);
+            m_buttons[VB_TrackpadY]->SetValue(m_gestures[CGestureMatcher::HG_PalmPointY]);
         }
         else
         {
@@ -149,7 +148,7 @@ void CLeapControllerVive::UpdateGestures(const LEAP_HAND *f_hand, const LEAP_HAN
             m_buttons[VB_TrackpadY]->SetValue(0.f);
         }
 
-        m_buttons[VB_SystemClick]->SetState(l_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.75f);
-        m_buttons[VB_MenuClick]->SetState(l_gestures[CGestureMatcher::HG_PalmTouch] >= 0.75f);
+        m_buttons[VB_SystemClick]->SetState(m_gestures[CGestureMatcher::HG_OpisthenarTouch] >= 0.75f);
+        m_buttons[VB_MenuClick]->SetState(m_gestures[CGestureMatcher::HG_PalmTouch] >= 0.75f);
     }
 }
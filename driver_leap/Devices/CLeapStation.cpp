@@ -106,7 +106,7 @@ void CLeapStation::DebugRequest(const char* pchRequest, char* pchResponseBuffer,
 {
     if(m_trackedDevice != vr::k_unTrackedDeviceIndexInvalid)
     {
-        if(m_serverDriver) m_serverDriver->ProcessExternalMessage(pchRequest);
+        if(m_serverDriver) m_serverDriver->ProcessExternalMessage(pchRequest, pchResponseBuffer, unResponseBufferSize);
     }
 }
 
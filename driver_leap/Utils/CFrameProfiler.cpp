@@ -0,0 +1,69 @@
+#include "stdafx.h"
+
+#include "Utils/CFrameProfiler.h"
+
+const char* const g_stageNames[]
+{
+    "hmd_update", "poller_update", "interpolation", "transformation", "interop", "gestures", "input", "skeleton",
+    "poller_poll", "poller_copy"
+};
+
+bool CFrameProfiler::ms_enabled = false;
+int64_t CFrameProfiler::ms_stageTimes[] = { 0 };
+const uint64_t *CFrameProfiler::ms_allocationsCounter = nullptr;
+uint64_t CFrameProfiler::ms_stageAllocations[] = { 0U };
+
+void CFrameProfiler::SetEnabled(bool f_state)
+{
+    ms_enabled = f_state;
+    Reset();
+}
+
+bool CFrameProfiler::IsEnabled()
+{
+    return ms_enabled;
+}
+
+void CFrameProfiler::Reset()
+{
+    for(size_t i = 0U; i < FS_Count; i++)
+    {
+        ms_stageTimes[i] = 0;
+        ms_stageAllocations[i] = 0U;
+    }
+}
+
+void CFrameProfiler::AddStageTime(size_t f_stage, int64_t f_time)
+{
+    if(f_stage < FS_Count) ms_stageTimes[f_stage] += f_time;
+}
+
+int64_t CFrameProfiler::GetStageTime(size_t f_stage)
+{
+    return ((f_stage < FS_Count) ? ms_stageTimes[f_stage] : 0);
+}
+
+void CFrameProfiler::SetAllocationsCounter(const uint64_t *f_counter)
+{
+    ms_allocationsCounter = f_counter;
+}
+
+const uint64_t* CFrameProfiler::GetAllocationsCounter()
+{
+    return ms_allocationsCounter;
+}
+
+void CFrameProfiler::AddStageAllocations(size_t f_stage, uint64_t f_count)
+{
+    if(f_stage < FS_Count) ms_stageAllocations[f_stage] += f_count;
+}
+
+uint64_t CFrameProfiler::GetStageAllocations(size_t f_stage)
+{
+    return ((f_stage < FS_Count) ? ms_stageAllocations[f_stage] : 0U);
+}
+
+const char* CFrameProfiler::GetStageName(size_t f_stage)
+{
+    return ((f_stage < FS_TraceCount) ? g_stageNames[f_stage] : "unknown");
+}
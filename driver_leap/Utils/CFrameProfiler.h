@@ -0,0 +1,52 @@
+#pragma once
+
+// CPU time of RunFrame stages for current frame, collected only when enabled. Accessed from RunFrame thread only.
+class CFrameProfiler final
+{
+public:
+    enum FrameStage : size_t
+    {
+        FS_HmdUpdate = 0U,
+        FS_PollerUpdate,
+        FS_Interpolation,
+        FS_Transformation,
+        FS_Interop,
+        FS_Gestures,
+        FS_Input,
+        FS_Skeleton,
+
+        FS_Count,
+
+        // Stages of poller thread, traced only
+        FS_PollerPoll = FS_Count,
+        FS_PollerCopy,
+
+        FS_TraceCount
+    };
+private:
+    static bool ms_enabled;
+    static int64_t ms_stageTimes[FS_Count];
+    static const uint64_t *ms_allocationsCounter;
+    static uint64_t ms_stageAllocations[FS_Count];
+
+    CFrameProfiler() = delete;
+    ~CFrameProfiler() = delete;
+    CFrameProfiler(const CFrameProfiler &that) = delete;
+    CFrameProfiler& operator=(const CFrameProfiler &that) = delete;
+public:
+    static void SetEnabled(bool f_state);
+    static bool IsEnabled();
+
+    // Clears stage times before new frame
+    static void Reset();
+    static void AddStageTime(size_t f_stage, int64_t f_time);
+    // Nanoseconds spent in stage since last reset
+    static int64_t GetStageTime(size_t f_stage);
+
+    // Counter of memory allocations maintained by host process, stages count allocations only if it's set
+    static void SetAllocationsCounter(const uint64_t *f_counter);
+    static const uint64_t* GetAllocationsCounter();
+    static void AddStageAllocations(size_t f_stage, uint64_t f_count);
+    static uint64_t GetStageAllocations(size_t f_stage);
+    static const char* GetStageName(size_t f_stage);
+};
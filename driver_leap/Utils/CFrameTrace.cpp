@@ -0,0 +1,106 @@
+#include "stdafx.h"
+
+#include "Utils/CFrameTrace.h"
+#include "Utils/CFrameProfiler.h"
+
+std::atomic<bool> CFrameTrace::ms_enabled(false);
+CFrameTrace::TraceRing CFrameTrace::ms_rings[TL_RingsCount];
+thread_local CFrameTrace::RingOwner CFrameTrace::ms_owner = { nullptr };
+
+CFrameTrace::RingOwner::~RingOwner()
+{
+    if(m_ring) m_ring->m_claimed.store(false, std::memory_order_release);
+}
+
+void CFrameTrace::SetEnabled(bool f_state)
+{
+    ms_enabled.store(f_state, std::memory_order_relaxed);
+}
+
+bool CFrameTrace::IsEnabled()
+{
+    return ms_enabled.load(std::memory_order_relaxed);
+}
+
+void CFrameTrace::AddEvent(size_t f_stage, int64_t f_start, int64_t f_duration)
+{
+    TraceRing *l_ring = GetThreadRing();
+    if(l_ring)
+    {
+        // Slot is published by head, reader drops slots that could be overwritten while it copies them
+        const uint64_t l_head = l_ring->m_head.load(std::memory_order_relaxed);
+        TraceEvent &l_event = l_ring->m_events[l_head % TL_RingSize];
+        l_event.m_start = f_start;
+        l_event.m_duration = f_duration;
+        l_event.m_stage = f_stage;
+        l_ring->m_head.store(l_head + 1U, std::memory_order_release);
+    }
+}
+
+void CFrameTrace::Clear()
+{
+    for(auto &l_ring : ms_rings) l_ring.m_tail.store(l_ring.m_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+size_t CFrameTrace::Dump(std::ostream &f_stream)
+{
+    size_t l_result = 0U;
+    std::vector<TraceEvent> l_events;
+    f_stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for(size_t i = 0U; i < TL_RingsCount; i++)
+    {
+        TraceRing &l_ring = ms_rings[i];
+        const uint64_t l_head = l_ring.m_head.load(std::memory_order_acquire);
+        uint64_t l_first = std::max(l_ring.m_tail.load(std::memory_order_relaxed), (l_head > TL_RingSize) ? (l_head - TL_RingSize) : 0U);
+        l_events.clear();
+        for(uint64_t j = l_first; j < l_head; j++) l_events.push_back(l_ring.m_events[j % TL_RingSize]);
+
+        // Slot after newest one can be in writing
+        const uint64_t l_newHead = l_ring.m_head.load(std::memory_order_acquire);
+        if((l_newHead - l_first) >= TL_RingSize)
+        {
+            const uint64_t l_valid = l_newHead - TL_RingSize + 1U;
+            const size_t l_skip = static_cast<size_t>(std::min(l_valid - l_first, static_cast<uint64_t>(l_events.size())));
+            l_events.erase(l_events.begin(), l_events.begin() + l_skip);
+        }
+        if(l_events.empty()) continue;
+
+        // Rings are threads of trace
+        f_stream << ((l_result > 0U) ? "," : "") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\"thread " << i << "\"}}";
+        for(const auto &l_event : l_events)
+        {
+            f_stream << ",\n{\"name\":\"" << CFrameProfiler::GetStageName(l_event.m_stage) << "\",\"cat\":\"driver\",\"ph\":\"X\",\"pid\":1,\"tid\":" << i;
+            f_stream << ",\"ts\":";
+            WriteMicroseconds(f_stream, l_event.m_start);
+            f_stream << ",\"dur\":";
+            WriteMicroseconds(f_stream, l_event.m_duration);
+            f_stream << '}';
+        }
+        l_result += l_events.size();
+    }
+    f_stream << "\n]}\n";
+    return l_result;
+}
+
+CFrameTrace::TraceRing* CFrameTrace::GetThreadRing()
+{
+    if(!ms_owner.m_ring)
+    {
+        for(auto &l_ring : ms_rings)
+        {
+            if(!l_ring.m_claimed.exchange(true, std::memory_order_acquire))
+            {
+                ms_owner.m_ring = &l_ring;
+                break;
+            }
+        }
+    }
+    return ms_owner.m_ring;
+}
+
+// Trace event times are microseconds, nanoseconds are kept as fraction
+void CFrameTrace::WriteMicroseconds(std::ostream &f_stream, int64_t f_time)
+{
+    const int64_t l_fraction = f_time % 1000;
+    f_stream << (f_time / 1000) << '.' << ((l_fraction < 100) ? "0" : "") << ((l_fraction < 10) ? "0" : "") << l_fraction;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// Timeline of stage timers, every thread writes own ring without locks. Rings are read from any thread and dumped as Chrome trace events.
+class CFrameTrace final
+{
+    enum TraceLimit : size_t
+    {
+        TL_RingSize = 8192U, // Events, oldest are overwritten
+        TL_RingsCount = 8U // Threads that trace at same time, events of others are dropped
+    };
+    struct TraceEvent
+    {
+        int64_t m_start; // Nanoseconds of steady clock
+        int64_t m_duration;
+        size_t m_stage;
+    };
+    struct TraceRing
+    {
+        std::atomic<bool> m_claimed;
+        std::atomic<uint64_t> m_head; // Events written
+        std::atomic<uint64_t> m_tail; // First event after clear
+        TraceEvent m_events[TL_RingSize];
+    };
+    // Releases ring of thread on its exit
+    struct RingOwner
+    {
+        TraceRing *m_ring;
+        ~RingOwner();
+    };
+
+    static std::atomic<bool> ms_enabled;
+    static TraceRing ms_rings[TL_RingsCount];
+    static thread_local RingOwner ms_owner;
+
+    CFrameTrace() = delete;
+    ~CFrameTrace() = delete;
+    CFrameTrace(const CFrameTrace &that) = delete;
+    CFrameTrace& operator=(const CFrameTrace &that) = delete;
+
+    static TraceRing* GetThreadRing();
+    static void WriteMicroseconds(std::ostream &f_stream, int64_t f_time);
+public:
+    static void SetEnabled(bool f_state);
+    static bool IsEnabled();
+
+    // Called by owner thread only
+    static void AddEvent(size_t f_stage, int64_t f_start, int64_t f_duration);
+    static void Clear();
+
+    // Writes Chrome trace event JSON, returns count of written events
+    static size_t Dump(std::ostream &f_stream);
+};
@@ -0,0 +1,114 @@
+#include "stdafx.h"
+
+#include "Utils/CHistogram.h"
+
+CHistogram::CHistogram(int64_t f_bucketWidth, size_t f_bucketsCount)
+{
+    m_bucketWidth = std::max(f_bucketWidth, static_cast<int64_t>(1));
+    m_buckets.resize(std::max(f_bucketsCount, static_cast<size_t>(1U)), 0U);
+    Reset();
+}
+
+CHistogram::~CHistogram()
+{
+}
+
+void CHistogram::Add(int64_t f_value)
+{
+    const size_t l_bucket = ((f_value > 0) ? std::min(static_cast<size_t>(f_value / m_bucketWidth), m_buckets.size() - 1U) : 0U);
+    m_buckets[l_bucket]++;
+
+    if(m_count == 0U)
+    {
+        m_min = f_value;
+        m_max = f_value;
+    }
+    else
+    {
+        m_min = std::min(m_min, f_value);
+        m_max = std::max(m_max, f_value);
+    }
+    m_sum += f_value;
+    m_count++;
+}
+
+void CHistogram::Merge(const CHistogram &f_histogram)
+{
+    if(f_histogram.m_count > 0U)
+    {
+        const std::vector<uint32_t> &l_buckets = f_histogram.m_buckets;
+        for(size_t i = 0U, j = l_buckets.size(); i < j; i++) m_buckets[std::min(i, m_buckets.size() - 1U)] += l_buckets[i];
+
+        if(m_count == 0U)
+        {
+            m_min = f_histogram.m_min;
+            m_max = f_histogram.m_max;
+        }
+        else
+        {
+            m_min = std::min(m_min, f_histogram.m_min);
+            m_max = std::max(m_max, f_histogram.m_max);
+        }
+        m_sum += f_histogram.m_sum;
+        m_count += f_histogram.m_count;
+    }
+}
+
+void CHistogram::Reset()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0U);
+    m_count = 0U;
+    m_sum = 0;
+    m_min = 0;
+    m_max = 0;
+}
+
+uint64_t CHistogram::GetCount() const
+{
+    return m_count;
+}
+
+int64_t CHistogram::GetMin() const
+{
+    return m_min;
+}
+
+int64_t CHistogram::GetMax() const
+{
+    return m_max;
+}
+
+int64_t CHistogram::GetAverage() const
+{
+    return ((m_count > 0U) ? (m_sum / static_cast<int64_t>(m_count)) : 0);
+}
+
+int64_t CHistogram::GetPercentile(float f_percentile) const
+{
+    int64_t l_result = 0;
+    if(m_count > 0U)
+    {
+        const uint64_t l_rank = std::max(static_cast<uint64_t>(std::ceil(static_cast<double>(m_count) * glm::clamp(f_percentile, 0.f, 100.f) / 100.0)), static_cast<uint64_t>(1U));
+        uint64_t l_accumulated = 0U;
+        for(size_t i = 0U, j = m_buckets.size(); i < j; i++)
+        {
+            l_accumulated += m_buckets[i];
+            if(l_accumulated >= l_rank)
+            {
+                l_result = std::min(static_cast<int64_t>(i + 1U) * m_bucketWidth, m_max);
+                break;
+            }
+        }
+    }
+    return l_result;
+}
+
+int64_t CHistogram::GetBucketWidth() const
+{
+    return m_bucketWidth;
+}
+
+const std::vector<uint32_t>& CHistogram::GetBuckets() const
+{
+    return m_buckets;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// Fixed width buckets, last bucket collects overflow, percentiles are resolved to bucket precision
+class CHistogram final
+{
+    std::vector<uint32_t> m_buckets;
+    int64_t m_bucketWidth;
+    uint64_t m_count;
+    int64_t m_sum;
+    int64_t m_min;
+    int64_t m_max;
+public:
+    CHistogram(int64_t f_bucketWidth, size_t f_bucketsCount);
+    ~CHistogram();
+
+    void Add(int64_t f_value);
+    // Histograms should have same bucket width, buckets out of range are added to last bucket
+    void Merge(const CHistogram &f_histogram);
+    void Reset();
+
+    uint64_t GetCount() const;
+    int64_t GetMin() const;
+    int64_t GetMax() const;
+    int64_t GetAverage() const;
+    // Upper bound of bucket that holds percentile, not above maximal value
+    int64_t GetPercentile(float f_percentile) const;
+
+    int64_t GetBucketWidth() const;
+    const std::vector<uint32_t>& GetBuckets() const;
+};
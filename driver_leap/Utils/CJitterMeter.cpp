@@ -0,0 +1,61 @@
+#include "stdafx.h"
+
+#include "Utils/CJitterMeter.h"
+
+CJitterMeter::CJitterMeter()
+{
+    m_id = 0U;
+    m_history = 0U;
+    m_sum = 0.f;
+    m_max = 0.f;
+    m_count = 0U;
+}
+
+CJitterMeter::~CJitterMeter()
+{
+}
+
+void CJitterMeter::Add(uint32_t f_id, const glm::vec3 &f_position)
+{
+    if((m_history > 0U) && (f_id != m_id)) m_history = 0U;
+    m_id = f_id;
+
+    if(m_history == 2U)
+    {
+        const float l_jitter = glm::length(f_position - m_positions[1U] * 2.f + m_positions[0U]);
+        m_sum += l_jitter;
+        m_max = std::max(m_max, l_jitter);
+        m_count++;
+    }
+    else m_history++;
+
+    m_positions[0U] = m_positions[1U];
+    m_positions[1U] = f_position;
+}
+
+void CJitterMeter::Restart()
+{
+    m_history = 0U;
+}
+
+float CJitterMeter::GetAverage() const
+{
+    return ((m_count > 0U) ? (m_sum / static_cast<float>(m_count)) : 0.f);
+}
+
+float CJitterMeter::GetMax() const
+{
+    return m_max;
+}
+
+uint32_t CJitterMeter::GetCount() const
+{
+    return m_count;
+}
+
+void CJitterMeter::ResetWindow()
+{
+    m_sum = 0.f;
+    m_max = 0.f;
+    m_count = 0U;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// Accumulates magnitude of second difference of tracked position between consecutive samples
+class CJitterMeter final
+{
+    glm::vec3 m_positions[2U];
+    uint32_t m_id;
+    size_t m_history;
+
+    float m_sum;
+    float m_max;
+    uint32_t m_count;
+
+    CJitterMeter(const CJitterMeter &that) = delete;
+    CJitterMeter& operator=(const CJitterMeter &that) = delete;
+public:
+    CJitterMeter();
+    ~CJitterMeter();
+
+    // Sequence restarts when identifier changes
+    void Add(uint32_t f_id, const glm::vec3 &f_position);
+    void Restart();
+
+    float GetAverage() const;
+    float GetMax() const;
+    uint32_t GetCount() const;
+    // Clears accumulated values, keeps sequence
+    void ResetWindow();
+};
@@ -0,0 +1,165 @@
+#include "stdafx.h"
+
+#include "Utils/CMemoryPool.h"
+
+CMemoryPool::CMemoryPool()
+{
+    for(size_t i = 0U; i < PL_ClassCount; i++)
+    {
+        m_sizeClasses[i].m_freeList = nullptr;
+        m_sizeClasses[i].m_blocksTotal = 0U;
+        m_sizeClasses[i].m_blocksUsed = 0U;
+        m_sizeClasses[i].m_blocksUsedPeak = 0U;
+    }
+    m_liveBytes = 0U;
+    m_liveBytesPeak = 0U;
+    m_reservedBytes = 0U;
+    m_oversizedAllocations = 0U;
+    for(size_t i = 0U; i < PL_HintCount; i++) m_hintAllocations[i] = 0U;
+}
+
+CMemoryPool::~CMemoryPool()
+{
+    for(size_t i = 0U; i < PL_ClassCount; i++)
+    {
+        for(auto l_slab : m_sizeClasses[i].m_slabs) delete[]l_slab;
+        m_sizeClasses[i].m_slabs.clear();
+        m_sizeClasses[i].m_freeList = nullptr;
+    }
+}
+
+void* CMemoryPool::Allocate(uint32_t f_size, eLeapAllocatorType f_typeHint)
+{
+    const size_t l_class = GetSizeClass(f_size);
+    BlockHeader *l_block = nullptr;
+    if(l_class != PL_Oversized)
+    {
+        SizeClass &l_sizeClass = m_sizeClasses[l_class];
+        std::lock_guard<std::mutex> l_guard(l_sizeClass.m_lock);
+
+        if(!l_sizeClass.m_freeList) AddSlab(l_class);
+        l_block = l_sizeClass.m_freeList;
+        l_sizeClass.m_freeList = l_block->m_next;
+
+        l_sizeClass.m_blocksUsed++;
+        if(l_sizeClass.m_blocksUsed > l_sizeClass.m_blocksUsedPeak) l_sizeClass.m_blocksUsedPeak = l_sizeClass.m_blocksUsed;
+    }
+    else
+    {
+        l_block = reinterpret_cast<BlockHeader*>(new uint8_t[PL_HeaderSize + f_size]);
+        m_oversizedAllocations++;
+    }
+    l_block->m_next = nullptr;
+    l_block->m_sizeClass = static_cast<uint32_t>(l_class);
+    l_block->m_size = f_size;
+
+    const size_t l_hint = static_cast<size_t>(f_typeHint);
+    if(l_hint < PL_HintCount) m_hintAllocations[l_hint]++;
+
+    const size_t l_liveBytes = (m_liveBytes += f_size);
+    size_t l_peak = m_liveBytesPeak.load();
+    while((l_liveBytes > l_peak) && !m_liveBytesPeak.compare_exchange_weak(l_peak, l_liveBytes));
+
+    return reinterpret_cast<uint8_t*>(l_block) + PL_HeaderSize;
+}
+
+void CMemoryPool::Deallocate(void *f_ptr)
+{
+    if(f_ptr)
+    {
+        BlockHeader *l_block = reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(f_ptr) - PL_HeaderSize);
+        m_liveBytes -= l_block->m_size;
+
+        if(l_block->m_sizeClass != PL_Oversized)
+        {
+            SizeClass &l_sizeClass = m_sizeClasses[l_block->m_sizeClass];
+            std::lock_guard<std::mutex> l_guard(l_sizeClass.m_lock);
+            l_block->m_next = l_sizeClass.m_freeList;
+            l_sizeClass.m_freeList = l_block;
+            l_sizeClass.m_blocksUsed--;
+        }
+        else delete[]reinterpret_cast<uint8_t*>(l_block);
+    }
+}
+
+size_t CMemoryPool::GetLiveBytes() const
+{
+    return m_liveBytes;
+}
+
+size_t CMemoryPool::GetLiveBytesPeak() const
+{
+    return m_liveBytesPeak;
+}
+
+size_t CMemoryPool::GetReservedBytes() const
+{
+    return m_reservedBytes;
+}
+
+size_t CMemoryPool::GetBlocksPeak(uint32_t f_blockSize)
+{
+    size_t l_result = 0U;
+    const size_t l_class = GetSizeClass(f_blockSize);
+    if(l_class != PL_Oversized)
+    {
+        std::lock_guard<std::mutex> l_guard(m_sizeClasses[l_class].m_lock);
+        l_result = m_sizeClasses[l_class].m_blocksUsedPeak;
+    }
+    return l_result;
+}
+
+uint64_t CMemoryPool::GetOversizedAllocations() const
+{
+    return m_oversizedAllocations;
+}
+
+uint64_t CMemoryPool::GetHintAllocations(eLeapAllocatorType f_typeHint) const
+{
+    const size_t l_hint = static_cast<size_t>(f_typeHint);
+    return ((l_hint < PL_HintCount) ? m_hintAllocations[l_hint].load() : 0U);
+}
+
+// Called with size class lock held
+void CMemoryPool::AddSlab(size_t f_class)
+{
+    SizeClass &l_sizeClass = m_sizeClasses[f_class];
+    const size_t l_blockSize = (static_cast<size_t>(1U) << (f_class + PL_MinBlockShift));
+    const size_t l_blocksCount = std::max(static_cast<size_t>(PL_SlabSize) / l_blockSize, static_cast<size_t>(1U));
+
+    uint8_t *l_slab = new uint8_t[l_blockSize * l_blocksCount];
+    l_sizeClass.m_slabs.push_back(l_slab);
+    for(size_t i = 0U; i < l_blocksCount; i++)
+    {
+        BlockHeader *l_block = reinterpret_cast<BlockHeader*>(l_slab + i * l_blockSize);
+        l_block->m_next = l_sizeClass.m_freeList;
+        l_sizeClass.m_freeList = l_block;
+    }
+    l_sizeClass.m_blocksTotal += l_blocksCount;
+    m_reservedBytes += l_blockSize * l_blocksCount;
+}
+
+size_t CMemoryPool::GetSizeClass(uint32_t f_size)
+{
+    size_t l_result = PL_Oversized;
+    const size_t l_required = static_cast<size_t>(f_size) + PL_HeaderSize;
+    for(size_t i = 0U; i < PL_ClassCount; i++)
+    {
+        if(l_required <= (static_cast<size_t>(1U) << (i + PL_MinBlockShift)))
+        {
+            l_result = i;
+            break;
+        }
+    }
+    return l_result;
+}
+
+void* CMemoryPool::AllocateMemory(uint32_t size, eLeapAllocatorType typeHint, void *state)
+{
+    return reinterpret_cast<CMemoryPool*>(state)->Allocate(size, typeHint);
+}
+
+void CMemoryPool::DeallocateMemory(void *ptr, void *state)
+{
+    reinterpret_cast<CMemoryPool*>(state)->Deallocate(ptr);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// Thread-safe size-class pool for LEAP_ALLOCATOR, blocks are recycled and never returned to heap until destruction
+class CMemoryPool final
+{
+    enum PoolLimit : size_t
+    {
+        PL_HeaderSize = 16U, // Keeps every eLeapAllocatorType aligned
+        PL_MinBlockShift = 6U, // 64 bytes
+        PL_MaxBlockShift = 20U, // 1 MB
+        PL_SlabSize = 65536U,
+        PL_ClassCount = PL_MaxBlockShift - PL_MinBlockShift + 1U,
+        PL_Oversized = 0xFFFFFFFFU,
+        PL_HintCount = 11U
+    };
+
+    struct BlockHeader
+    {
+        BlockHeader *m_next;
+        uint32_t m_sizeClass;
+        uint32_t m_size;
+    };
+
+    struct SizeClass
+    {
+        std::mutex m_lock;
+        BlockHeader *m_freeList;
+        std::vector<uint8_t*> m_slabs;
+        size_t m_blocksTotal;
+        size_t m_blocksUsed;
+        size_t m_blocksUsedPeak;
+    };
+
+    SizeClass m_sizeClasses[PL_ClassCount];
+
+    std::atomic<size_t> m_liveBytes;
+    std::atomic<size_t> m_liveBytesPeak;
+    std::atomic<size_t> m_reservedBytes;
+    std::atomic<uint64_t> m_oversizedAllocations;
+    std::atomic<uint64_t> m_hintAllocations[PL_HintCount];
+
+    CMemoryPool(const CMemoryPool &that) = delete;
+    CMemoryPool& operator=(const CMemoryPool &that) = delete;
+
+    void AddSlab(size_t f_class);
+    static size_t GetSizeClass(uint32_t f_size);
+public:
+    CMemoryPool();
+    ~CMemoryPool();
+
+    void* Allocate(uint32_t f_size, eLeapAllocatorType f_typeHint);
+    void Deallocate(void *f_ptr);
+
+    size_t GetLiveBytes() const;
+    size_t GetLiveBytesPeak() const;
+    size_t GetReservedBytes() const;
+    size_t GetBlocksPeak(uint32_t f_blockSize);
+    uint64_t GetOversizedAllocations() const;
+    uint64_t GetHintAllocations(eLeapAllocatorType f_typeHint) const;
+
+    // LEAP_ALLOCATOR callbacks, state is CMemoryPool instance
+    static void* AllocateMemory(uint32_t size, eLeapAllocatorType typeHint, void *state);
+    static void DeallocateMemory(void *ptr, void *state);
+};
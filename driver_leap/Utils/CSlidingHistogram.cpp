@@ -0,0 +1,85 @@
+#include "stdafx.h"
+
+#include "Utils/CSlidingHistogram.h"
+#include "Utils/CHistogram.h"
+
+const float g_windowPercentiles[] = { 50.f, 90.f, 99.f };
+
+CSlidingHistogram::CSlidingHistogram(int64_t f_bucketWidth, size_t f_bucketsCount, int64_t f_periodLength, size_t f_periodsCount)
+{
+    // Current period isn't published, at least one completed period is kept
+    for(size_t i = 0U, j = std::max(f_periodsCount, static_cast<size_t>(1U)) + 1U; i < j; i++) m_periods.push_back(new CHistogram(f_bucketWidth, f_bucketsCount));
+    m_periodLength = std::max(f_periodLength, static_cast<int64_t>(1));
+    m_window = new CHistogram(f_bucketWidth, f_bucketsCount);
+    Reset();
+}
+
+CSlidingHistogram::~CSlidingHistogram()
+{
+    for(auto l_period : m_periods) delete l_period;
+    delete m_window;
+}
+
+void CSlidingHistogram::Add(int64_t f_value, int64_t f_time)
+{
+    Update(f_time);
+    m_periods[m_period]->Add(f_value);
+}
+
+void CSlidingHistogram::Update(int64_t f_time)
+{
+    if(m_periodStart == 0) m_periodStart = f_time;
+    else if((f_time - m_periodStart) >= m_periodLength)
+    {
+        // Periods without values are passed at once, long pause clears whole window
+        const int64_t l_passed = (f_time - m_periodStart) / m_periodLength;
+        for(int64_t i = 0, j = std::min(l_passed, static_cast<int64_t>(m_periods.size())); i < j; i++)
+        {
+            m_period = (m_period + 1U) % m_periods.size();
+            m_periods[m_period]->Reset();
+        }
+        m_periodStart += l_passed * m_periodLength;
+        Publish();
+    }
+}
+
+void CSlidingHistogram::Reset()
+{
+    for(auto l_period : m_periods) l_period->Reset();
+    m_period = 0U;
+    m_periodStart = 0;
+    Publish();
+}
+
+uint64_t CSlidingHistogram::GetWindowCount() const
+{
+    return m_windowCount;
+}
+
+int64_t CSlidingHistogram::GetWindowValue(size_t f_value) const
+{
+    return ((f_value < WV_Count) ? m_windowValues[f_value].load() : 0);
+}
+
+void CSlidingHistogram::WriteWindow(std::ostream &f_stream) const
+{
+    std::lock_guard<std::mutex> l_guard(m_windowLock);
+    f_stream << "count " << m_window->GetCount();
+    f_stream << " p50 " << m_window->GetPercentile(g_windowPercentiles[WV_P50]) << " p90 " << m_window->GetPercentile(g_windowPercentiles[WV_P90]);
+    f_stream << " p99 " << m_window->GetPercentile(g_windowPercentiles[WV_P99]) << " max " << m_window->GetMax() << '\n';
+    f_stream << "bucket_width " << m_window->GetBucketWidth() << " buckets";
+    for(const auto l_bucket : m_window->GetBuckets()) f_stream << ' ' << l_bucket;
+    f_stream << '\n';
+}
+
+// Current period is empty after its change
+void CSlidingHistogram::Publish()
+{
+    std::lock_guard<std::mutex> l_guard(m_windowLock);
+    m_window->Reset();
+    for(const auto l_period : m_periods) m_window->Merge(*l_period);
+
+    for(size_t i = WV_P50; i < WV_Max; i++) m_windowValues[i] = m_window->GetPercentile(g_windowPercentiles[i]);
+    m_windowValues[WV_Max] = m_window->GetMax();
+    m_windowCount = m_window->GetCount();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+class CHistogram;
+
+// Histogram of latest periods, window of completed periods is published on period change and can be read from any thread
+class CSlidingHistogram final
+{
+public:
+    enum WindowValue : size_t
+    {
+        WV_P50 = 0U,
+        WV_P90,
+        WV_P99,
+        WV_Max,
+
+        WV_Count
+    };
+private:
+    std::vector<CHistogram*> m_periods;
+    size_t m_period; // Current period
+    int64_t m_periodLength;
+    int64_t m_periodStart;
+
+    mutable std::mutex m_windowLock;
+    CHistogram *m_window; // Guarded by window lock
+    std::atomic<uint64_t> m_windowCount;
+    std::atomic<int64_t> m_windowValues[WV_Count];
+
+    CSlidingHistogram(const CSlidingHistogram &that) = delete;
+    CSlidingHistogram& operator=(const CSlidingHistogram &that) = delete;
+
+    void Publish();
+public:
+    // Window is made of all periods except current one
+    CSlidingHistogram(int64_t f_bucketWidth, size_t f_bucketsCount, int64_t f_periodLength, size_t f_periodsCount);
+    ~CSlidingHistogram();
+
+    // Call from single thread, time is in units of period length and shouldn't decrease
+    void Add(int64_t f_value, int64_t f_time);
+    void Update(int64_t f_time);
+    void Reset();
+
+    uint64_t GetWindowCount() const;
+    int64_t GetWindowValue(size_t f_value) const;
+    // Count, percentiles, maximum, bucket width and buckets of window
+    void WriteWindow(std::ostream &f_stream) const;
+};
@@ -0,0 +1,36 @@
+#include "stdafx.h"
+
+#include "Utils/CStageTimer.h"
+#include "Utils/CFrameProfiler.h"
+#include "Utils/CFrameTrace.h"
+
+CStageTimer::CStageTimer(size_t f_stage)
+{
+    // Profiler belongs to RunFrame thread, its flag isn't read for stages of other threads
+    m_stage = f_stage;
+    m_profiled = ((f_stage < CFrameProfiler::FS_Count) && CFrameProfiler::IsEnabled());
+    m_traced = CFrameTrace::IsEnabled();
+    m_allocations = 0U;
+    if(m_profiled)
+    {
+        const uint64_t *l_counter = CFrameProfiler::GetAllocationsCounter();
+        if(l_counter) m_allocations = *l_counter;
+    }
+    if(m_profiled || m_traced) m_start = std::chrono::steady_clock::now();
+}
+
+CStageTimer::~CStageTimer()
+{
+    if(m_profiled || m_traced)
+    {
+        const std::chrono::steady_clock::time_point l_end = std::chrono::steady_clock::now();
+        const int64_t l_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(l_end - m_start).count();
+        if(m_profiled)
+        {
+            CFrameProfiler::AddStageTime(m_stage, l_duration);
+            const uint64_t *l_counter = CFrameProfiler::GetAllocationsCounter();
+            if(l_counter) CFrameProfiler::AddStageAllocations(m_stage, *l_counter - m_allocations);
+        }
+        if(m_traced) CFrameTrace::AddEvent(m_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(m_start.time_since_epoch()).count(), l_duration);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+// Adds time spent in scope to stage of frame profiler and to frame trace, clock isn't read while both are disabled
+class CStageTimer final
+{
+    size_t m_stage;
+    bool m_profiled;
+    bool m_traced;
+    std::chrono::steady_clock::time_point m_start;
+    uint64_t m_allocations; // Counter value at start
+
+    CStageTimer(const CStageTimer &that) = delete;
+    CStageTimer& operator=(const CStageTimer &that) = delete;
+public:
+    explicit CStageTimer(size_t f_stage);
+    ~CStageTimer();
+};
+
+// Stage timers are removed from build by LEAP_NO_STAGE_TIMERS definition
+#ifdef LEAP_NO_STAGE_TIMERS
+#define STAGE_TIMER(stage)
+#else
+#define STAGE_TIMER(stage) CStageTimer l_stageTimer(stage)
+#endif
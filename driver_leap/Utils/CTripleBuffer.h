@@ -0,0 +1,80 @@
+#pragma once
+
+// Lock-free single producer/single consumer exchange, reader always gets the newest published slot
+template<class T> class CTripleBuffer final
+{
+    enum SlotFlag : unsigned char
+    {
+        SF_IndexMask = 0x03U,
+        SF_Fresh = 0x04U
+    };
+
+    T m_slots[3U];
+    std::atomic<unsigned char> m_middleSlot;
+    unsigned char m_writeSlot; // Owned by producer
+    unsigned char m_readSlot; // Owned by consumer
+
+    std::atomic<uint64_t> m_produced;
+    std::atomic<uint64_t> m_consumed;
+    std::atomic<uint64_t> m_overwritten;
+
+    CTripleBuffer(const CTripleBuffer &that) = delete;
+    CTripleBuffer& operator=(const CTripleBuffer &that) = delete;
+public:
+    CTripleBuffer()
+    {
+        m_writeSlot = 0U;
+        m_middleSlot = 1U;
+        m_readSlot = 2U;
+        m_produced = 0U;
+        m_consumed = 0U;
+        m_overwritten = 0U;
+    }
+    ~CTripleBuffer()
+    {
+    }
+
+    // Producer side
+    T& GetWriteSlot()
+    {
+        return m_slots[m_writeSlot];
+    }
+    void Publish()
+    {
+        const unsigned char l_previous = m_middleSlot.exchange(m_writeSlot | SF_Fresh, std::memory_order_acq_rel);
+        if(l_previous & SF_Fresh) m_overwritten.fetch_add(1U, std::memory_order_relaxed);
+        m_writeSlot = (l_previous & SF_IndexMask);
+        m_produced.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    // Consumer side, returns true if newer slot has been acquired
+    bool Acquire()
+    {
+        bool l_result = false;
+        if(m_middleSlot.load(std::memory_order_acquire) & SF_Fresh)
+        {
+            const unsigned char l_previous = m_middleSlot.exchange(m_readSlot, std::memory_order_acq_rel);
+            m_readSlot = (l_previous & SF_IndexMask);
+            m_consumed.fetch_add(1U, std::memory_order_relaxed);
+            l_result = true;
+        }
+        return l_result;
+    }
+    const T& GetReadSlot() const
+    {
+        return m_slots[m_readSlot];
+    }
+
+    uint64_t GetProducedCount() const
+    {
+        return m_produced.load(std::memory_order_relaxed);
+    }
+    uint64_t GetConsumedCount() const
+    {
+        return m_consumed.load(std::memory_order_relaxed);
+    }
+    uint64_t GetOverwrittenCount() const
+    {
+        return m_overwritten.load(std::memory_order_relaxed);
+    }
+};
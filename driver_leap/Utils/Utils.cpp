@@ -2,6 +2,8 @@
 
 #include "Utils/Utils.h"
 
+extern char g_modulePath[];
+
 extern const glm::mat4 g_identityMatrix(1.f);
 
 extern const vr::VRBoneTransform_t g_openHandGesture[31U]
@@ -99,6 +101,16 @@ void ConvertVector3(const glm::vec3 &f_glmVec, vr::HmdVector4_t &f_vrVec)
     for(size_t i = 0U; i < 3U; i++) f_vrVec.v[i] = f_glmVec[i];
 }
 
+void ConvertVector3(const LEAP_VECTOR &f_leapVec, glm::vec3 &f_glmVec)
+{
+    for(size_t i = 0U; i < 3U; i++) f_glmVec[i] = f_leapVec.v[i];
+}
+
+void ConvertVector3(const glm::vec3 &f_glmVec, LEAP_VECTOR &f_leapVec)
+{
+    for(size_t i = 0U; i < 3U; i++) f_leapVec.v[i] = f_glmVec[i];
+}
+
 size_t ReadEnumVector(const std::string &f_val, const std::vector<std::string> &f_vec)
 {
     size_t l_result = std::numeric_limits<size_t>::max();
@@ -126,3 +138,45 @@ size_t ReadEnumVector(const char *f_val, const std::vector<std::string> &f_vec)
     }
     return l_result;
 }
+
+void WriteResponse(const std::string &f_text, char *f_buffer, uint32_t f_size)
+{
+    if(f_buffer && (f_size > 0U))
+    {
+        const size_t l_length = std::min(f_text.size(), static_cast<size_t>(f_size - 1U));
+        std::memcpy(f_buffer, f_text.data(), l_length);
+        f_buffer[l_length] = '\0';
+    }
+}
+
+bool GetOutputPath(const std::string &f_name, const char *f_directory, std::string &f_path)
+{
+    // Colon rejects drive letters and alternate streams on Windows
+    bool l_result = (!f_name.empty() && (f_name[0U] != '/') && (f_name[0U] != '\\') && (f_name.find(':') == std::string::npos));
+    // Any name starting with two dots is rejected, Windows trims trailing dots and spaces of names
+    for(size_t l_start = 0U; l_result && (l_start <= f_name.size());)
+    {
+        const size_t l_end = std::min(f_name.find_first_of("\\/", l_start), f_name.size());
+        l_result = (((l_end - l_start) < 2U) || (f_name.compare(l_start, 2U, "..") != 0));
+        l_start = l_end + 1U;
+    }
+
+    std::string l_directory(g_modulePath);
+    const size_t l_separator = l_directory.find_last_of("\\/");
+    if(l_result && (l_separator != std::string::npos))
+    {
+        l_directory.erase(l_directory.begin() + l_separator, l_directory.end());
+        l_directory.append("/../../");
+        l_directory.append(f_directory);
+#ifdef _WIN32
+        CreateDirectoryA(l_directory.c_str(), NULL);
+#else
+        mkdir(l_directory.c_str(), 0755);
+#endif
+        f_path.assign(l_directory);
+        f_path.push_back('/');
+        f_path.append(f_name);
+    }
+    else l_result = false;
+    return l_result;
+}
@@ -10,6 +10,13 @@ template<class T, class U> void ConvertQuaternion(const T &f_quatA, U &f_quatB)
 }
 void ConvertVector3(const vr::HmdVector4_t &f_vrVec, glm::vec3 &f_glmVec);
 void ConvertVector3(const glm::vec3 &f_glmVec, vr::HmdVector4_t &f_vrVec);
+void ConvertVector3(const LEAP_VECTOR &f_leapVec, glm::vec3 &f_glmVec);
+void ConvertVector3(const glm::vec3 &f_glmVec, LEAP_VECTOR &f_leapVec);
 
 size_t ReadEnumVector(const std::string &f_val, const std::vector<std::string> &f_vec);
 size_t ReadEnumVector(const char *f_val, const std::vector<std::string> &f_vec);
+
+void WriteResponse(const std::string &f_text, char *f_buffer, uint32_t f_size);
+
+// Name is relative to output directory of driver, absolute paths and parent references are rejected. Directory is created if missing.
+bool GetOutputPath(const std::string &f_name, const char *f_directory, std::string &f_path);
@@ -4,6 +4,7 @@
 
 char g_modulePath[2048U];
 
+#ifdef _WIN32
 BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID /* lpReserved */)
 {
     switch(ul_reason_for_call)
@@ -16,10 +17,15 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID /* lpRes
     }
     return TRUE;
 }
+#define DRIVER_EXPORT extern "C" __declspec(dllexport)
+#else
+// Path is set by host application before factory call
+#define DRIVER_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
 
 CServerDriver g_serverDriver;
 
-extern "C" __declspec(dllexport) void* HmdDriverFactory(const char *pInterfaceName, int *pReturnCode)
+DRIVER_EXPORT void* HmdDriverFactory(const char *pInterfaceName, int *pReturnCode)
 {
     void *l_result = nullptr;
     if(!strcmp(vr::IServerTrackedDeviceProvider_Version, pInterfaceName)) l_result = dynamic_cast<vr::IServerTrackedDeviceProvider*>(&g_serverDriver);
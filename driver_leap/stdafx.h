@@ -1,9 +1,21 @@
 ﻿#pragma once
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <SDKDDKVer.h>
 #include <Windows.h>
+#include <avrt.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include <string>
 #include <sstream>
@@ -15,6 +27,7 @@
 #include <atomic>
 #include <mutex>
 #include <thread>
+#include <fstream>
 
 #include "openvr_driver.h"
 #include "LeapC.h"
@@ -1,8 +1,15 @@
 #include "stdafx.h"
 
 #include "CLeapMonitor.h"
+#include "Core/CTelemetryBlock.h"
+#include "Utils/CMemoryPool.h"
 
 const std::chrono::milliseconds g_threadDelay(11U);
+const uint32_t g_responseSize = 128U;
+const char* const g_latencyHands[]
+{
+    "left", "right"
+};
 
 CLeapMonitor::CLeapMonitor()
 {
@@ -13,18 +20,23 @@ CLeapMonitor::CLeapMonitor()
 
     m_leapActive = false;
     m_leapConnection = nullptr;
-    m_leapAllocator.allocate = CLeapMonitor::AllocateMemory;
-    m_leapAllocator.deallocate = CLeapMonitor::DeallocateMemory;
-    m_leapAllocator.state = nullptr;
+    m_memoryPool = new CMemoryPool();
+    m_leapAllocator.allocate = CMemoryPool::AllocateMemory;
+    m_leapAllocator.deallocate = CMemoryPool::DeallocateMemory;
+    m_leapAllocator.state = m_memoryPool;
     m_leapDevice = nullptr;
 
     m_relayDevice = vr::k_unTrackedDeviceIndexInvalid;
+    m_telemetryBlock = new CTelemetryBlock();
     m_leftHotkey = false;
     m_rightHotkey = false;
     m_reloadHotkey = false;
+    m_latencyHotkey = false;
 }
 CLeapMonitor::~CLeapMonitor()
 {
+    delete m_memoryPool;
+    delete m_telemetryBlock;
 }
 
 bool CLeapMonitor::Initialize()
@@ -84,6 +96,8 @@ void CLeapMonitor::Terminate()
             m_leapActive = false;
         }
 
+        m_telemetryBlock->Close();
+
         if(m_notificationID) vr::VRNotifications()->RemoveNotification(m_notificationID);
         vr::VROverlay()->DestroyOverlay(m_overlayHandle);
         m_overlayHandle = vr::k_ulOverlayHandleInvalid;
@@ -153,6 +167,13 @@ bool CLeapMonitor::DoPulse()
                     SendNotification("Configuration is reloaded");
                 }
             }
+
+            l_hotkeyState = (GetAsyncKeyState(0x4C) & 0x8000); // Ctrl+L
+            if(m_latencyHotkey != l_hotkeyState)
+            {
+                m_latencyHotkey = l_hotkeyState;
+                if(m_latencyHotkey) ShowLatencies();
+            }
         }
     }
 
@@ -198,13 +219,59 @@ bool CLeapMonitor::DoPulse()
     return m_active;
 }
 
-void CLeapMonitor::SendCommand(const char *f_char)
+std::string CLeapMonitor::SendCommand(const char *f_char)
 {
+    std::string l_result;
     if(m_relayDevice != vr::k_unTrackedDeviceIndexInvalid)
     {
-        char l_response[32U];
-        vr::VRDebug()->DriverDebugRequest(m_relayDevice, f_char, l_response, 32U);
+        char l_response[g_responseSize] = { 0 };
+        vr::VRDebug()->DriverDebugRequest(m_relayDevice, f_char, l_response, g_responseSize);
+        l_result.assign(l_response);
+    }
+    return l_result;
+}
+
+// Telemetry block is read first, driver is asked if block isn't available. Values are p50/p90/p99/max in microseconds.
+bool CLeapMonitor::ReadLatencies(size_t f_hand, uint64_t &f_count, int64_t *f_values)
+{
+    bool l_result = false;
+    CTelemetryBlock::BlockData l_data;
+    if(!m_telemetryBlock->IsOpen()) m_telemetryBlock->Open();
+    if(m_telemetryBlock->Read(l_data))
+    {
+        const CTelemetryBlock::HandData &l_hand = l_data.m_hands[f_hand];
+        f_count = l_hand.m_latencyCount;
+        for(size_t i = 0U; i < CTelemetryBlock::LV_Count; i++) f_values[i] = l_hand.m_latencies[i];
+        l_result = true;
+    }
+    else
+    {
+        m_telemetryBlock->Close(); // Driver could be restarted
+
+        std::stringstream l_response(SendCommand((std::string("latency ") + g_latencyHands[f_hand]).c_str()));
+        l_response >> f_count;
+        for(size_t i = 0U; i < CTelemetryBlock::LV_Count; i++) l_response >> f_values[i];
+        l_result = !l_response.fail();
+    }
+    return l_result;
+}
+
+void CLeapMonitor::ShowLatencies()
+{
+    std::stringstream l_text;
+    l_text << std::fixed;
+    l_text.precision(1);
+    for(size_t i = 0U; i < 2U; i++)
+    {
+        uint64_t l_count = 0U;
+        int64_t l_values[CTelemetryBlock::LV_Count] = { 0 };
+        const bool l_read = ReadLatencies(i, l_count, l_values);
+        if(i > 0U) l_text << '\n';
+        l_text << ((i == 0U) ? "Left" : "Right");
+        if(l_read && (l_count > 0U)) l_text << " latency, ms: p50 " << (l_values[CTelemetryBlock::LV_P50] / 1000.0) << ", p90 " << (l_values[CTelemetryBlock::LV_P90] / 1000.0) << ", p99 " << (l_values[CTelemetryBlock::LV_P99] / 1000.0) << ", max " << (l_values[CTelemetryBlock::LV_Max] / 1000.0);
+        else l_text << " latency isn't measured";
     }
+    SendNotification(l_text.str().c_str());
 }
 
 void CLeapMonitor::SendNotification(const char *f_text)
@@ -218,13 +285,3 @@ void CLeapMonitor::SendNotification(const char *f_text)
         }
     }
 }
-
-void* CLeapMonitor::AllocateMemory(uint32_t size, eLeapAllocatorType typeHint, void *state)
-{
-    return new uint8_t[size];
-}
-
-void CLeapMonitor::DeallocateMemory(void *ptr, void *state)
-{
-    delete[]reinterpret_cast<uint8_t*>(ptr);
-}
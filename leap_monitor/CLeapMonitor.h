@@ -1,5 +1,8 @@
 #pragma once
 
+class CMemoryPool;
+class CTelemetryBlock;
+
 class CLeapMonitor final
 {
     enum GameProfile : unsigned char
@@ -17,20 +20,22 @@ class CLeapMonitor final
     bool m_leapActive;
     LEAP_CONNECTION m_leapConnection;
     LEAP_ALLOCATOR m_leapAllocator;
+    CMemoryPool *m_memoryPool;
     LEAP_DEVICE m_leapDevice;
 
     uint32_t m_relayDevice;
+    CTelemetryBlock *m_telemetryBlock;
     bool m_leftHotkey;
     bool m_rightHotkey;
     bool m_reloadHotkey;
+    bool m_latencyHotkey;
 
     CLeapMonitor(const CLeapMonitor &that) = delete;
     CLeapMonitor& operator=(const CLeapMonitor &that) = delete;
 
-    void SendCommand(const char *f_cmd);
-
-    static void* AllocateMemory(uint32_t size, eLeapAllocatorType typeHint, void *state);
-    static void DeallocateMemory(void *ptr, void *state);
+    std::string SendCommand(const char *f_cmd);
+    bool ReadLatencies(size_t f_hand, uint64_t &f_count, int64_t *f_values);
+    void ShowLatencies();
 public:
     CLeapMonitor();
     ~CLeapMonitor();
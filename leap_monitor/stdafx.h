@@ -5,9 +5,15 @@
 #include <Windows.h>
 
 #include <string>
+#include <cstring>
+#include <sstream>
+#include <vector>
 #include <set>
+#include <algorithm>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <atomic>
 
 #include "openvr.h"
 #include "LeapC.h"
@@ -0,0 +1,154 @@
+#include "stdafx.h"
+
+#include "CCodecBenchmark.h"
+#include "Core/CFrameDecoder.h"
+#include "Core/CFrameEncoder.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CSessionIndex.h"
+#include "Core/CSessionReader.h"
+#include "Core/CSessionRecorder.h"
+#include "Utils/CHistogram.h"
+
+const float g_targetRates[] = { 90.f, 120.f }; // Frame rates of hourly size
+
+CCodecBenchmark::CCodecBenchmark()
+{
+    m_reader = new CSessionReader();
+    m_encoder = new CFrameEncoder();
+    m_decoder = new CFrameDecoder();
+    m_frame = new CLeapFrame();
+    m_decodedFrame = new CLeapFrame();
+    m_encodeHistogram = new CHistogram(100, 1000U);
+    m_decodeHistogram = new CHistogram(100, 1000U);
+    m_index = new CSessionIndex();
+    m_rawBytes = 0U;
+    m_compressedBytes = 0U;
+    m_keyframesCount = 0U;
+    m_failuresCount = 0U;
+    m_positionError = 0.f;
+    m_rotationError = 0.f;
+}
+
+CCodecBenchmark::~CCodecBenchmark()
+{
+    delete m_reader;
+    delete m_encoder;
+    delete m_decoder;
+    delete m_frame;
+    delete m_decodedFrame;
+    delete m_encodeHistogram;
+    delete m_decodeHistogram;
+    delete m_index;
+}
+
+bool CCodecBenchmark::Run(const std::string &f_path, const std::string &f_outputPath)
+{
+    bool l_result = m_reader->Open(f_path);
+    if(l_result)
+    {
+        std::ofstream l_output;
+        uint64_t l_outputOffset = CSessionRecorder::RF_HeaderSize;
+        m_index->Clear();
+        if(!f_outputPath.empty())
+        {
+            l_output.open(f_outputPath, std::ios::binary | std::ios::trunc);
+            const uint32_t l_header[] = { CSessionRecorder::RF_Magic, CSessionRecorder::RF_Version, static_cast<uint32_t>(sizeof(LEAP_HAND)), CLeapFrame::GetHandsLimit() };
+            l_output.write(reinterpret_cast<const char*>(l_header), sizeof(l_header));
+        }
+
+        int64_t l_hostTime = 0;
+        while(m_reader->Read(*m_frame, l_hostTime))
+        {
+            const LEAP_TRACKING_EVENT *l_event = m_frame->GetEvent();
+
+            m_payload.clear();
+            const auto l_encodeStart = std::chrono::steady_clock::now();
+            const bool l_keyframe = m_encoder->Encode(l_event, l_hostTime, m_payload);
+            const auto l_encodeEnd = std::chrono::steady_clock::now();
+            if(l_keyframe)
+            {
+                m_index->Add(l_outputOffset, l_hostTime, l_event->info.timestamp, l_event->tracking_frame_id);
+                m_keyframesCount++;
+            }
+
+            int64_t l_decodedTime = 0;
+            const bool l_decoded = m_decoder->Decode(m_payload.data(), m_payload.size(), *m_decodedFrame, l_decodedTime);
+            const auto l_decodeEnd = std::chrono::steady_clock::now();
+
+            m_encodeHistogram->Add(std::chrono::duration_cast<std::chrono::nanoseconds>(l_encodeEnd - l_encodeStart).count());
+            m_decodeHistogram->Add(std::chrono::duration_cast<std::chrono::nanoseconds>(l_decodeEnd - l_encodeEnd).count());
+
+            // Sizes include record header, raw payload is fixed fields and hands
+            m_rawBytes += CSessionRecorder::RF_RecordHeaderSize + sizeof(int64_t) * 4U + sizeof(float) + sizeof(uint32_t) + sizeof(LEAP_HAND) * l_event->nHands;
+            m_compressedBytes += CSessionRecorder::RF_RecordHeaderSize + m_payload.size();
+
+            if(l_decoded && (l_decodedTime == l_hostTime) && (m_decodedFrame->GetEvent()->nHands == l_event->nHands)) UpdateErrors();
+            else m_failuresCount++;
+
+            if(l_output.is_open())
+            {
+                const uint8_t l_type = CSessionRecorder::RT_CompressedFrame;
+                const uint32_t l_size = static_cast<uint32_t>(m_payload.size());
+                l_output.write(reinterpret_cast<const char*>(&l_type), sizeof(l_type));
+                l_output.write(reinterpret_cast<const char*>(&l_size), sizeof(l_size));
+                l_output.write(reinterpret_cast<const char*>(m_payload.data()), static_cast<std::streamsize>(m_payload.size()));
+            }
+            l_outputOffset += CSessionRecorder::RF_RecordHeaderSize + m_payload.size();
+        }
+        m_reader->Close();
+
+        if(l_output.is_open())
+        {
+            m_payload.clear();
+            m_index->Write(m_payload, l_outputOffset);
+            l_output.write(reinterpret_cast<const char*>(m_payload.data()), static_cast<std::streamsize>(m_payload.size()));
+            l_output.close();
+            l_result = !l_output.fail();
+        }
+    }
+    return l_result;
+}
+
+void CCodecBenchmark::WriteSummary(std::ostream &f_stream) const
+{
+    const uint64_t l_frames = m_encodeHistogram->GetCount();
+    const double l_divider = static_cast<double>(std::max(l_frames, static_cast<uint64_t>(1U)));
+    f_stream << "frames " << l_frames << " keyframes " << m_keyframesCount << " failures " << m_failuresCount << '\n';
+    f_stream << "bytes_per_frame raw " << (static_cast<double>(m_rawBytes) / l_divider) << " compressed " << (static_cast<double>(m_compressedBytes) / l_divider);
+    f_stream << " ratio " << (static_cast<double>(m_rawBytes) / static_cast<double>(std::max(m_compressedBytes, static_cast<uint64_t>(1U)))) << '\n';
+    for(const auto l_rate : g_targetRates)
+    {
+        // Frame size of this recording at fixed rate, hands count of recording is kept
+        const double l_factor = static_cast<double>(l_rate) * 3600.0 / 1000000.0 / l_divider;
+        f_stream << "mb_per_hour " << l_rate << "hz raw " << (static_cast<double>(m_rawBytes) * l_factor) << " compressed " << (static_cast<double>(m_compressedBytes) * l_factor) << '\n';
+    }
+    f_stream << "encode_ns avg " << m_encodeHistogram->GetAverage() << " p99 " << m_encodeHistogram->GetPercentile(99.f) << " max " << m_encodeHistogram->GetMax() << '\n';
+    f_stream << "decode_ns avg " << m_decodeHistogram->GetAverage() << " p99 " << m_decodeHistogram->GetPercentile(99.f) << " max " << m_decodeHistogram->GetMax() << '\n';
+    f_stream << "max_error position_mm " << m_positionError << " rotation " << m_rotationError << '\n';
+}
+
+void CCodecBenchmark::UpdateErrors()
+{
+    const LEAP_TRACKING_EVENT *l_source = m_frame->GetEvent();
+    const LEAP_TRACKING_EVENT *l_decoded = m_decodedFrame->GetEvent();
+    for(uint32_t i = 0U; i < l_source->nHands; i++)
+    {
+        const LEAP_HAND &l_sourceHand = l_source->pHands[i];
+        const LEAP_HAND &l_decodedHand = l_decoded->pHands[i];
+        for(size_t j = 0U; j < 5U; j++)
+        {
+            for(size_t k = 0U; k < 4U; k++)
+            {
+                const LEAP_BONE &l_sourceBone = l_sourceHand.digits[j].bones[k];
+                const LEAP_BONE &l_decodedBone = l_decodedHand.digits[j].bones[k];
+                for(size_t l = 0U; l < 3U; l++)
+                {
+                    m_positionError = std::max(m_positionError, std::abs(l_sourceBone.prev_joint.v[l] - l_decodedBone.prev_joint.v[l]));
+                    m_positionError = std::max(m_positionError, std::abs(l_sourceBone.next_joint.v[l] - l_decodedBone.next_joint.v[l]));
+                }
+                for(size_t l = 0U; l < 4U; l++) m_rotationError = std::max(m_rotationError, std::abs(l_sourceBone.rotation.v[l] - l_decodedBone.rotation.v[l]));
+            }
+        }
+        for(size_t j = 0U; j < 3U; j++) m_positionError = std::max(m_positionError, std::abs(l_sourceHand.palm.position.v[j] - l_decodedHand.palm.position.v[j]));
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+class CFrameDecoder;
+class CFrameEncoder;
+class CHistogram;
+class CLeapFrame;
+class CSessionIndex;
+class CSessionReader;
+
+// Runs recorded frames through compressed frame codec, reports size, time and error
+class CCodecBenchmark final
+{
+    CSessionReader *m_reader;
+    CFrameEncoder *m_encoder;
+    CFrameDecoder *m_decoder;
+    CLeapFrame *m_frame;
+    CLeapFrame *m_decodedFrame;
+    CHistogram *m_encodeHistogram;
+    CHistogram *m_decodeHistogram;
+    CSessionIndex *m_index;
+    std::vector<uint8_t> m_payload;
+    uint64_t m_rawBytes;
+    uint64_t m_compressedBytes;
+    uint64_t m_keyframesCount;
+    uint64_t m_failuresCount;
+    float m_positionError;
+    float m_rotationError;
+
+    CCodecBenchmark(const CCodecBenchmark &that) = delete;
+    CCodecBenchmark& operator=(const CCodecBenchmark &that) = delete;
+
+    void UpdateErrors();
+public:
+    CCodecBenchmark();
+    ~CCodecBenchmark();
+
+    // Compressed recording is written to output path if it isn't empty
+    bool Run(const std::string &f_path, const std::string &f_outputPath);
+
+    // Bytes and nanoseconds per frame, maximal errors in millimeters and quaternion components
+    void WriteSummary(std::ostream &f_stream) const;
+};
@@ -0,0 +1,258 @@
+#include "stdafx.h"
+
+#include "CColumnExporter.h"
+#include "CColumnWriter.h"
+#include "StandIn/CStandInDriverContext.h"
+#include "StandIn/CStandInDriverInput.h"
+#include "StandIn/CStandInProperties.h"
+#include "StandIn/CStandInServerDriverHost.h"
+#include "Core/CDriverConfig.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CMappedSessionReader.h"
+#include "Devices/CLeapController/CLeapControllerIndex.h"
+#include "Devices/CLeapController/CLeapControllerOculus.h"
+#include "Devices/CLeapController/CLeapControllerVive.h"
+#include "Utils/CGestureMatcher.h"
+
+extern char g_modulePath[];
+
+const char* const g_handNames[]
+{
+    "left", "right"
+};
+const char* const g_gestureNames[]
+{
+    "thumb_bend", "index_bend", "middle_bend", "ring_bend", "pinky_bend",
+    "trigger", "grab", "thumb_press",
+    "opisthenar_touch", "palm_touch", "palm_point_x", "palm_point_y", "thumb_cross_touch", "middle_cross_touch"
+};
+const char* const g_frameColumns[]
+{
+    "frame.host_time", "frame.timestamp", "frame.tracking_frame_id", "frame.hands"
+};
+const char* const g_poseColumns[]
+{
+    "pose.valid", "pose.result",
+    "pose.position.x", "pose.position.y", "pose.position.z",
+    "pose.rotation.w", "pose.rotation.x", "pose.rotation.y", "pose.rotation.z",
+    "pose.velocity.x", "pose.velocity.y", "pose.velocity.z"
+};
+enum PoseColumn : size_t
+{
+    PC_Valid = 0U,
+    PC_Result,
+    PC_Position,
+    PC_Rotation = PC_Position + 3U,
+    PC_Velocity = PC_Rotation + 4U,
+
+    PC_Count = PC_Velocity + 3U
+};
+
+CColumnExporter::CColumnExporter()
+{
+    m_driverContext = nullptr;
+    m_reader = new CMappedSessionReader();
+    m_frame = new CLeapFrame();
+    m_writer = new CColumnWriter();
+    for(size_t i = 0U; i < EH_Count; i++)
+    {
+        m_controllers[i] = nullptr;
+        m_devices[i] = vr::k_unTrackedDeviceIndexInvalid;
+        m_handColumns[i] = 0U;
+    }
+    m_frameColumn = 0U;
+    m_exportTime = 0;
+}
+
+CColumnExporter::~CColumnExporter()
+{
+    DestroyControllers();
+    delete m_reader;
+    delete m_frame;
+    delete m_writer;
+}
+
+bool CColumnExporter::Run(const std::string &f_path, const std::string &f_outputPath, uint32_t f_chunkRows)
+{
+    bool l_result = false;
+    if(m_reader->Open(f_path))
+    {
+        if(CreateControllers())
+        {
+            AddColumns();
+            if(m_writer->Open(f_outputPath, f_chunkRows))
+            {
+                const auto l_start = std::chrono::steady_clock::now();
+                int64_t l_hostTime = 0;
+                while(m_reader->Read(*m_frame, l_hostTime)) ExportFrame(l_hostTime);
+                m_writer->Close();
+                m_exportTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_start).count();
+                l_result = true;
+            }
+            else std::cerr << "Unable to create " << f_outputPath << std::endl;
+        }
+        else std::cerr << "Controllers activation failed" << std::endl;
+        DestroyControllers();
+        m_reader->Close();
+    }
+    else std::cerr << "Unable to open " << f_path << std::endl;
+    return l_result;
+}
+
+void CColumnExporter::WriteSummary(std::ostream &f_stream) const
+{
+    f_stream << "rows " << m_writer->GetRowsCount() << " columns " << m_writer->GetColumnsCount() << " chunks " << m_writer->GetChunksCount() << '\n';
+    f_stream << "bytes " << m_writer->GetBytesCount() << " export_ms " << (m_exportTime / 1000) << '\n';
+}
+
+bool CColumnExporter::CreateControllers()
+{
+    // Settings are read relatively to module path
+    std::string l_modulePath(LEAP_REPLAY_ROOT);
+    l_modulePath.append("/bin/linux64/driver_leap.so");
+    std::strncpy(g_modulePath, l_modulePath.c_str(), 2047U);
+
+    m_driverContext = new CStandInDriverContext();
+    bool l_result = (vr::InitServerDriverContext(m_driverContext) == vr::VRInitError_None);
+    if(l_result)
+    {
+        CDriverConfig::Load();
+
+        // Both hands are exported regardless of enabled hands in settings
+        for(size_t i = 0U; i < EH_Count; i++)
+        {
+            const unsigned char l_hand = ((i == EH_Left) ? CLeapController::CH_Left : CLeapController::CH_Right);
+            switch(CDriverConfig::GetEmulatedController())
+            {
+                case CDriverConfig::EC_Vive:
+                    m_controllers[i] = new CLeapControllerVive(l_hand);
+                    break;
+                case CDriverConfig::EC_Index:
+                    m_controllers[i] = new CLeapControllerIndex(l_hand);
+                    break;
+                case CDriverConfig::EC_Oculus:
+                    m_controllers[i] = new CLeapControllerOculus(l_hand);
+                    break;
+            }
+            if(m_controllers[i])
+            {
+                CStandInServerDriverHost *l_host = m_driverContext->GetServerDriverHost();
+                const uint32_t l_device = l_host->GetDevicesCount();
+                if(l_host->TrackedDeviceAdded(m_controllers[i]->GetSerialNumber().c_str(), vr::TrackedDeviceClass_Controller, m_controllers[i]))
+                {
+                    m_devices[i] = l_device;
+                    m_controllers[i]->SetEnabled(true);
+                }
+                else l_result = false;
+            }
+            else l_result = false;
+        }
+    }
+    return l_result;
+}
+
+void CColumnExporter::DestroyControllers()
+{
+    if(m_driverContext)
+    {
+        m_driverContext->GetServerDriverHost()->DeactivateDevices();
+        for(size_t i = 0U; i < EH_Count; i++)
+        {
+            delete m_controllers[i];
+            m_controllers[i] = nullptr;
+            m_devices[i] = vr::k_unTrackedDeviceIndexInvalid;
+        }
+        vr::CleanupDriverContext();
+        delete m_driverContext;
+        m_driverContext = nullptr;
+    }
+}
+
+void CColumnExporter::AddColumns()
+{
+    m_frameColumn = m_writer->AddColumn(g_frameColumns[0U], CColumnWriter::CT_Integer);
+    for(size_t i = 1U; i < 4U; i++) m_writer->AddColumn(g_frameColumns[i], CColumnWriter::CT_Integer);
+
+    for(size_t i = 0U; i < EH_Count; i++)
+    {
+        const std::string l_prefix(std::string(g_handNames[i]) + '.');
+        m_handColumns[i] = m_writer->AddColumn(l_prefix + "present", CColumnWriter::CT_Boolean);
+        for(size_t j = 0U; j < CGestureMatcher::HG_Count; j++) m_writer->AddColumn(l_prefix + "gesture." + g_gestureNames[j], CColumnWriter::CT_Float);
+        for(size_t j = 0U; j < PC_Count; j++)
+        {
+            uint32_t l_type = CColumnWriter::CT_Float;
+            if(j == PC_Valid) l_type = CColumnWriter::CT_Boolean;
+            else if(j == PC_Result) l_type = CColumnWriter::CT_Integer;
+            m_writer->AddColumn(l_prefix + g_poseColumns[j], l_type);
+        }
+    }
+
+    // Input components of controllers, named by hand and input path
+    m_inputColumns.clear();
+    const CStandInDriverInput *l_input = m_driverContext->GetDriverInput();
+    for(size_t i = 0U; i < EH_Count; i++)
+    {
+        const vr::PropertyContainerHandle_t l_container = m_driverContext->GetProperties()->TrackedDeviceToPropertyContainer(m_devices[i]);
+        for(size_t j = 0U, k = l_input->GetComponentsCount(); j < k; j++)
+        {
+            const unsigned char l_type = l_input->GetComponentType(j);
+            if((l_input->GetComponentContainer(j) == l_container) && ((l_type == CStandInDriverInput::CT_Boolean) || (l_type == CStandInDriverInput::CT_Scalar)))
+            {
+                InputColumn l_column;
+                l_column.m_component = j;
+                l_column.m_boolean = (l_type == CStandInDriverInput::CT_Boolean);
+                l_column.m_column = m_writer->AddColumn(std::string(g_handNames[i]) + ".input" + l_input->GetComponentPath(j), l_column.m_boolean ? CColumnWriter::CT_Boolean : CColumnWriter::CT_Float);
+                m_inputColumns.push_back(l_column);
+            }
+        }
+    }
+}
+
+void CColumnExporter::ExportFrame(int64_t f_hostTime)
+{
+    const LEAP_TRACKING_EVENT *l_event = m_frame->GetEvent();
+    const LEAP_HAND *l_hands[EH_Count] = { nullptr };
+    for(uint32_t i = 0U; i < l_event->nHands; i++)
+    {
+        const size_t l_side = static_cast<size_t>(l_event->pHands[i].type);
+        if((l_side < EH_Count) && !l_hands[l_side]) l_hands[l_side] = &l_event->pHands[i];
+    }
+
+    // Same order of updates as in driver frame
+    CLeapController::UpdateHMDCoordinates();
+    for(size_t i = 0U; i < EH_Count; i++) m_controllers[i]->RunFrame(l_hands[i], l_hands[(i + 1U) % EH_Count]);
+
+    m_writer->AddInteger(m_frameColumn, f_hostTime);
+    m_writer->AddInteger(m_frameColumn + 1U, l_event->info.timestamp);
+    m_writer->AddInteger(m_frameColumn + 2U, l_event->tracking_frame_id);
+    m_writer->AddInteger(m_frameColumn + 3U, static_cast<int64_t>(l_event->nHands));
+
+    const CStandInServerDriverHost *l_host = m_driverContext->GetServerDriverHost();
+    for(size_t i = 0U; i < EH_Count; i++)
+    {
+        size_t l_column = m_handColumns[i];
+        m_writer->AddBoolean(l_column++, l_hands[i] != nullptr);
+
+        m_gestures.assign(CGestureMatcher::HG_Count, 0.f);
+        if(l_hands[i]) CGestureMatcher::GetGestures(l_hands[i], m_gestures, l_hands[(i + 1U) % EH_Count]);
+        for(size_t j = 0U; j < CGestureMatcher::HG_Count; j++) m_writer->AddFloat(l_column++, m_gestures[j]);
+
+        const vr::DriverPose_t &l_pose = *l_host->GetDevicePose(m_devices[i]);
+        m_writer->AddBoolean(l_column++, l_pose.poseIsValid);
+        m_writer->AddInteger(l_column++, static_cast<int64_t>(l_pose.result));
+        for(size_t j = 0U; j < 3U; j++) m_writer->AddFloat(l_column++, static_cast<float>(l_pose.vecPosition[j]));
+        m_writer->AddFloat(l_column++, static_cast<float>(l_pose.qRotation.w));
+        m_writer->AddFloat(l_column++, static_cast<float>(l_pose.qRotation.x));
+        m_writer->AddFloat(l_column++, static_cast<float>(l_pose.qRotation.y));
+        m_writer->AddFloat(l_column++, static_cast<float>(l_pose.qRotation.z));
+        for(size_t j = 0U; j < 3U; j++) m_writer->AddFloat(l_column++, static_cast<float>(l_pose.vecVelocity[j]));
+    }
+
+    const CStandInDriverInput *l_input = m_driverContext->GetDriverInput();
+    for(const auto &l_column : m_inputColumns)
+    {
+        const float l_value = l_input->GetComponentValue(l_column.m_component);
+        if(l_column.m_boolean) m_writer->AddBoolean(l_column.m_column, l_value != 0.f);
+        else m_writer->AddFloat(l_column.m_column, l_value);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+class CColumnWriter;
+class CLeapController;
+class CLeapFrame;
+class CMappedSessionReader;
+class CStandInDriverContext;
+
+// Runs recorded frames through gesture matcher and emulated controllers under stand-in server,
+// writes gestures, input components and poses of both hands as columns
+class CColumnExporter final
+{
+    enum ExportHand : size_t
+    {
+        EH_Left = 0U,
+        EH_Right,
+
+        EH_Count
+    };
+    struct InputColumn
+    {
+        size_t m_component;
+        size_t m_column;
+        bool m_boolean;
+    };
+
+    CStandInDriverContext *m_driverContext;
+    CMappedSessionReader *m_reader;
+    CLeapFrame *m_frame;
+    CColumnWriter *m_writer;
+    CLeapController *m_controllers[EH_Count];
+    uint32_t m_devices[EH_Count];
+    std::vector<float> m_gestures;
+    std::vector<InputColumn> m_inputColumns;
+    size_t m_frameColumn; // First of frame columns
+    size_t m_handColumns[EH_Count]; // First of hand presence, gestures and pose columns
+    int64_t m_exportTime;
+
+    CColumnExporter(const CColumnExporter &that) = delete;
+    CColumnExporter& operator=(const CColumnExporter &that) = delete;
+
+    bool CreateControllers();
+    void DestroyControllers();
+    void AddColumns();
+    void ExportFrame(int64_t f_hostTime);
+public:
+    CColumnExporter();
+    ~CColumnExporter();
+
+    // Chunk size is in rows
+    bool Run(const std::string &f_path, const std::string &f_outputPath, uint32_t f_chunkRows);
+
+    // Rows, columns, chunks, file size and export time in milliseconds
+    void WriteSummary(std::ostream &f_stream) const;
+};
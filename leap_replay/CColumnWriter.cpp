@@ -0,0 +1,209 @@
+#include "stdafx.h"
+
+#include "CColumnWriter.h"
+
+CColumnWriter::CColumnWriter()
+{
+    m_offset = 0U;
+    m_chunkRows = 0U;
+    m_rowsCount = 0U;
+    m_chunksCount = 0U;
+}
+
+CColumnWriter::~CColumnWriter()
+{
+    Close();
+}
+
+size_t CColumnWriter::AddColumn(const std::string &f_name, uint32_t f_type)
+{
+    size_t l_result = std::numeric_limits<size_t>::max();
+    if(!m_file.is_open() && (f_type < CT_Count))
+    {
+        Column l_column;
+        l_column.m_name.assign(f_name);
+        l_column.m_type = f_type;
+        l_column.m_rowsCount = 0U;
+        l_column.m_min = .0;
+        l_column.m_max = .0;
+        m_columns.push_back(l_column);
+        l_result = m_columns.size() - 1U;
+    }
+    return l_result;
+}
+
+size_t CColumnWriter::GetColumnsCount() const
+{
+    return m_columns.size();
+}
+
+bool CColumnWriter::Open(const std::string &f_path, uint32_t f_chunkRows)
+{
+    if(!m_file.is_open() && !m_columns.empty() && (f_chunkRows > 0U))
+    {
+        m_file.open(f_path, std::ios::binary | std::ios::trunc);
+        if(m_file.is_open())
+        {
+            m_chunkRows = f_chunkRows;
+            m_rowsCount = 0U;
+            m_chunksCount = 0U;
+            for(auto &l_column : m_columns)
+            {
+                l_column.m_buffer.clear();
+                l_column.m_buffer.reserve(GetValueSize(l_column.m_type) * m_chunkRows);
+                l_column.m_rowsCount = 0U;
+                l_column.m_chunks.clear();
+            }
+
+            const uint32_t l_header[] = { CF_Magic, CF_Version, m_chunkRows, static_cast<uint32_t>(m_columns.size()) };
+            m_file.write(reinterpret_cast<const char*>(l_header), sizeof(l_header));
+            m_offset = CF_HeaderSize;
+        }
+    }
+    return m_file.is_open();
+}
+
+void CColumnWriter::Close()
+{
+    if(m_file.is_open())
+    {
+        for(auto &l_column : m_columns)
+        {
+            if(l_column.m_rowsCount > 0U) WriteChunk(l_column);
+        }
+        WriteDirectory();
+        m_file.close();
+    }
+}
+
+bool CColumnWriter::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+void CColumnWriter::AddFloat(size_t f_column, float f_value)
+{
+    if(m_file.is_open() && (f_column < m_columns.size()) && (m_columns[f_column].m_type == CT_Float)) AddValue(f_column, &f_value, sizeof(float), static_cast<double>(f_value));
+}
+
+void CColumnWriter::AddBoolean(size_t f_column, bool f_value)
+{
+    const uint8_t l_value = (f_value ? 1U : 0U);
+    if(m_file.is_open() && (f_column < m_columns.size()) && (m_columns[f_column].m_type == CT_Boolean)) AddValue(f_column, &l_value, sizeof(uint8_t), static_cast<double>(l_value));
+}
+
+void CColumnWriter::AddInteger(size_t f_column, int64_t f_value)
+{
+    if(m_file.is_open() && (f_column < m_columns.size()) && (m_columns[f_column].m_type == CT_Integer)) AddValue(f_column, &f_value, sizeof(int64_t), static_cast<double>(f_value));
+}
+
+uint64_t CColumnWriter::GetRowsCount() const
+{
+    return m_rowsCount;
+}
+
+uint64_t CColumnWriter::GetChunksCount() const
+{
+    return m_chunksCount;
+}
+
+uint64_t CColumnWriter::GetBytesCount() const
+{
+    return m_offset;
+}
+
+void CColumnWriter::AddValue(size_t f_column, const void *f_value, size_t f_size, double f_statValue)
+{
+    Column &l_column = m_columns[f_column];
+    const uint8_t *l_value = reinterpret_cast<const uint8_t*>(f_value);
+    l_column.m_buffer.insert(l_column.m_buffer.end(), l_value, l_value + f_size);
+    if(l_column.m_rowsCount == 0U)
+    {
+        l_column.m_min = f_statValue;
+        l_column.m_max = f_statValue;
+    }
+    else
+    {
+        l_column.m_min = std::min(l_column.m_min, f_statValue);
+        l_column.m_max = std::max(l_column.m_max, f_statValue);
+    }
+    l_column.m_rowsCount++;
+    if(f_column == 0U) m_rowsCount++;
+
+    if(l_column.m_rowsCount >= m_chunkRows) WriteChunk(l_column);
+}
+
+void CColumnWriter::WriteChunk(Column &f_column)
+{
+    // Chunks start at page boundary to be mapped separately
+    const uint64_t l_padding = (CF_Alignment - (m_offset % CF_Alignment)) % CF_Alignment;
+    if(l_padding > 0U)
+    {
+        const std::vector<char> l_zeros(static_cast<size_t>(l_padding), 0);
+        m_file.write(l_zeros.data(), l_zeros.size());
+        m_offset += l_padding;
+    }
+
+    Chunk l_chunk;
+    l_chunk.m_offset = m_offset;
+    l_chunk.m_rowsCount = f_column.m_rowsCount;
+    l_chunk.m_min = f_column.m_min;
+    l_chunk.m_max = f_column.m_max;
+    f_column.m_chunks.push_back(l_chunk);
+    m_chunksCount++;
+
+    m_file.write(reinterpret_cast<const char*>(f_column.m_buffer.data()), f_column.m_buffer.size());
+    m_offset += f_column.m_buffer.size();
+    f_column.m_buffer.clear();
+    f_column.m_rowsCount = 0U;
+}
+
+void CColumnWriter::WriteDirectory()
+{
+    const uint64_t l_directoryOffset = m_offset;
+    std::vector<uint8_t> l_directory;
+    for(const auto &l_column : m_columns)
+    {
+        const uint32_t l_nameLength = static_cast<uint32_t>(l_column.m_name.size());
+        const uint32_t l_chunksCount = static_cast<uint32_t>(l_column.m_chunks.size());
+        const uint8_t *l_data = reinterpret_cast<const uint8_t*>(&l_nameLength);
+        l_directory.insert(l_directory.end(), l_data, l_data + sizeof(uint32_t));
+        l_directory.insert(l_directory.end(), l_column.m_name.begin(), l_column.m_name.end());
+        l_data = reinterpret_cast<const uint8_t*>(&l_column.m_type);
+        l_directory.insert(l_directory.end(), l_data, l_data + sizeof(uint32_t));
+        l_data = reinterpret_cast<const uint8_t*>(&l_chunksCount);
+        l_directory.insert(l_directory.end(), l_data, l_data + sizeof(uint32_t));
+        for(const auto &l_chunk : l_column.m_chunks)
+        {
+            l_data = reinterpret_cast<const uint8_t*>(&l_chunk);
+            l_directory.insert(l_directory.end(), l_data, l_data + CF_ChunkEntrySize);
+        }
+    }
+
+    const uint32_t l_magic = CF_Magic;
+    const uint8_t *l_data = reinterpret_cast<const uint8_t*>(&l_directoryOffset);
+    l_directory.insert(l_directory.end(), l_data, l_data + sizeof(uint64_t));
+    l_data = reinterpret_cast<const uint8_t*>(&l_magic);
+    l_directory.insert(l_directory.end(), l_data, l_data + sizeof(uint32_t));
+
+    m_file.write(reinterpret_cast<const char*>(l_directory.data()), l_directory.size());
+    m_offset += l_directory.size();
+}
+
+size_t CColumnWriter::GetValueSize(uint32_t f_type)
+{
+    size_t l_result = 0U;
+    switch(f_type)
+    {
+        case CT_Float:
+            l_result = sizeof(float);
+            break;
+        case CT_Boolean:
+            l_result = sizeof(uint8_t);
+            break;
+        case CT_Integer:
+            l_result = sizeof(int64_t);
+            break;
+    }
+    return l_result;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+// Column-chunked binary file. Values of each column are gathered into chunks that are written at page aligned offsets,
+// directory of columns with offset, rows count, minimum and maximum of every chunk is stored in footer.
+// Analysis tools can map single column by its chunks without reading rows.
+class CColumnWriter final
+{
+public:
+    enum ColumnType : uint32_t
+    {
+        CT_Float = 0U, // 32-bit float
+        CT_Boolean, // 8-bit, 0 or 1
+        CT_Integer, // 64-bit signed
+
+        CT_Count
+    };
+    // Header is magic, version, rows per chunk and columns count as 32-bit values.
+    // Directory entry is name length, name, type and chunks count as 32-bit values followed by chunks as offset, rows, minimum and maximum as 64-bit values.
+    // File ends with offset of directory and magic.
+    enum ColumnFormat : uint32_t
+    {
+        CF_Magic = 0x4C4F434CU, // "LCOL"
+        CF_Version = 1U,
+        CF_HeaderSize = 16U,
+        CF_ChunkEntrySize = 32U,
+        CF_TrailerSize = 12U,
+        CF_Alignment = 4096U
+    };
+private:
+    struct Chunk
+    {
+        uint64_t m_offset;
+        uint64_t m_rowsCount;
+        double m_min;
+        double m_max;
+    };
+    struct Column
+    {
+        std::string m_name;
+        uint32_t m_type;
+        std::vector<uint8_t> m_buffer;
+        uint64_t m_rowsCount; // Rows in buffer
+        double m_min;
+        double m_max;
+        std::vector<Chunk> m_chunks;
+    };
+
+    std::ofstream m_file;
+    uint64_t m_offset;
+    uint32_t m_chunkRows;
+    std::vector<Column> m_columns;
+    uint64_t m_rowsCount;
+    uint64_t m_chunksCount;
+
+    CColumnWriter(const CColumnWriter &that) = delete;
+    CColumnWriter& operator=(const CColumnWriter &that) = delete;
+
+    void AddValue(size_t f_column, const void *f_value, size_t f_size, double f_statValue);
+    void WriteChunk(Column &f_column);
+    void WriteDirectory();
+
+    static size_t GetValueSize(uint32_t f_type);
+public:
+    CColumnWriter();
+    ~CColumnWriter();
+
+    // Columns can be added only before opening
+    size_t AddColumn(const std::string &f_name, uint32_t f_type);
+    size_t GetColumnsCount() const;
+
+    bool Open(const std::string &f_path, uint32_t f_chunkRows);
+    // Writes remaining chunks and directory
+    void Close();
+    bool IsOpen() const;
+
+    // Every column receives one value per row
+    void AddFloat(size_t f_column, float f_value);
+    void AddBoolean(size_t f_column, bool f_value);
+    void AddInteger(size_t f_column, int64_t f_value);
+
+    uint64_t GetRowsCount() const;
+    uint64_t GetChunksCount() const;
+    uint64_t GetBytesCount() const;
+};
@@ -0,0 +1,239 @@
+#include "stdafx.h"
+
+#include "CDriverBenchmark.h"
+#include "StandIn/CApiStatistics.h"
+#include "StandIn/CStandInDriverContext.h"
+#include "StandIn/CStandInServerDriverHost.h"
+#include "Utils/CFrameProfiler.h"
+#include "Utils/CHistogram.h"
+
+extern "C" void* HmdDriverFactory(const char *pInterfaceName, int *pReturnCode);
+extern char g_modulePath[];
+
+const size_t g_responseSize = 256U;
+const char g_syntheticSource[] = "synthetic";
+const float g_syntheticRate = 120.f; // Hand frames per second, as of Leap Motion in HMD mode
+const uint32_t g_syntheticHands = 2U;
+const uint32_t g_warmupFrames = 100U;
+
+CDriverBenchmark::CDriverBenchmark()
+{
+    m_driverContext = nullptr;
+    m_provider = nullptr;
+    m_station = nullptr;
+    m_replay = false;
+    m_wallHistogram = new CHistogram(100, 20000U); // Up to 2 ms
+    m_cpuHistogram = new CHistogram(100, 20000U);
+    for(size_t i = 0U; i < CFrameProfiler::FS_Count; i++) m_stageHistograms.push_back(new CHistogram(100, 2000U));
+    m_lastCalls.assign(CApiStatistics::AC_Count, CallCounters());
+    m_callTotals.assign(CApiStatistics::AC_Count, CallCounters());
+    m_callMaximums.assign(CApiStatistics::AC_Count, 0U);
+    m_framesCount = 0U;
+    m_runTime = 0;
+}
+
+CDriverBenchmark::~CDriverBenchmark()
+{
+    Terminate();
+    delete m_wallHistogram;
+    delete m_cpuHistogram;
+    for(auto l_histogram : m_stageHistograms) delete l_histogram;
+}
+
+bool CDriverBenchmark::Run(const std::string &f_source, uint32_t f_rate, uint64_t f_framesLimit, int64_t f_latency)
+{
+    bool l_result = false;
+    if(Initialize(f_source, f_latency))
+    {
+        const std::chrono::nanoseconds l_period((f_rate > 0U) ? (1000000000LL / f_rate) : 0LL);
+        const auto l_start = std::chrono::steady_clock::now();
+        auto l_nextFrame = l_start;
+        CFrameProfiler::SetEnabled(true);
+        while((m_framesCount < f_framesLimit) && (!m_replay || (m_framesCount == 0U) || !IsReplayFinished()))
+        {
+            RunFrame();
+            if(f_rate > 0U)
+            {
+                l_nextFrame += l_period;
+                std::this_thread::sleep_until(l_nextFrame);
+            }
+        }
+        CFrameProfiler::SetEnabled(false);
+        m_runTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_start).count();
+        Terminate();
+        l_result = true;
+    }
+    return l_result;
+}
+
+void CDriverBenchmark::WriteSummary(std::ostream &f_stream) const
+{
+    f_stream << "frames " << m_framesCount << " run_ms " << (m_runTime / 1000) << '\n';
+    f_stream << "runframe_wall_ns avg " << m_wallHistogram->GetAverage() << " p50 " << m_wallHistogram->GetPercentile(50.f) << " p90 " << m_wallHistogram->GetPercentile(90.f);
+    f_stream << " p99 " << m_wallHistogram->GetPercentile(99.f) << " max " << m_wallHistogram->GetMax() << '\n';
+    f_stream << "runframe_cpu_ns avg " << m_cpuHistogram->GetAverage() << " p50 " << m_cpuHistogram->GetPercentile(50.f) << " p90 " << m_cpuHistogram->GetPercentile(90.f);
+    f_stream << " p99 " << m_cpuHistogram->GetPercentile(99.f) << " max " << m_cpuHistogram->GetMax() << '\n';
+    for(size_t i = 0U; i < CFrameProfiler::FS_Count; i++)
+    {
+        const CHistogram *l_histogram = m_stageHistograms[i];
+        f_stream << "stage_ns " << CFrameProfiler::GetStageName(i) << " avg " << l_histogram->GetAverage() << " p50 " << l_histogram->GetPercentile(50.f) << " p90 " << l_histogram->GetPercentile(90.f);
+        f_stream << " p99 " << l_histogram->GetPercentile(99.f) << " max " << l_histogram->GetMax() << '\n';
+    }
+
+    // Interfaces calls that weren't made during frames are skipped
+    const double l_frames = static_cast<double>(std::max(m_framesCount, static_cast<uint64_t>(1U)));
+    uint64_t l_calls = 0U;
+    uint64_t l_payload = 0U;
+    int64_t l_time = 0;
+    for(size_t i = 0U; i < CApiStatistics::AC_Count; i++)
+    {
+        const CallCounters &l_total = m_callTotals[i];
+        if(l_total.m_count > 0U)
+        {
+            f_stream << "calls_per_frame " << CApiStatistics::GetCallName(i) << " avg " << (static_cast<double>(l_total.m_count) / l_frames) << " max " << m_callMaximums[i];
+            f_stream << " bytes " << (static_cast<double>(l_total.m_payload) / l_frames) << " ns " << (static_cast<double>(l_total.m_time) / l_frames) << '\n';
+            l_calls += l_total.m_count;
+            l_payload += l_total.m_payload;
+            l_time += l_total.m_time;
+        }
+    }
+    f_stream << "api_per_frame calls " << (static_cast<double>(l_calls) / l_frames) << " bytes " << (static_cast<double>(l_payload) / l_frames) << " ns " << (static_cast<double>(l_time) / l_frames) << '\n';
+}
+
+bool CDriverBenchmark::Initialize(const std::string &f_source, int64_t f_latency)
+{
+    // Settings are read relatively to module path
+    std::string l_modulePath(LEAP_REPLAY_ROOT);
+    l_modulePath.append("/bin/linux64/driver_leap.so");
+    std::strncpy(g_modulePath, l_modulePath.c_str(), 2047U);
+
+    int l_error = vr::VRInitError_None;
+    m_provider = reinterpret_cast<vr::IServerTrackedDeviceProvider*>(HmdDriverFactory(vr::IServerTrackedDeviceProvider_Version, &l_error));
+    if(m_provider)
+    {
+        m_driverContext = new CStandInDriverContext();
+        m_driverContext->GetStatistics()->SetLatency(f_latency);
+        if(m_provider->Init(m_driverContext) == vr::VRInitError_None)
+        {
+            CStandInServerDriverHost *l_host = m_driverContext->GetServerDriverHost();
+            m_station = l_host->GetDevice(l_host->FindDevice(vr::TrackedDeviceClass_TrackingReference));
+            if(m_station)
+            {
+                m_replay = (f_source != g_syntheticSource);
+                if(m_replay)
+                {
+                    std::string l_command("replay start fast ");
+                    l_command.append(f_source);
+                    SendCommand(l_command.c_str());
+                }
+                else
+                {
+                    std::string l_command("setting tracking_source synthetic ");
+                    l_command.append(std::to_string(g_syntheticRate));
+                    l_command.push_back(' ');
+                    l_command.append(std::to_string(g_syntheticHands));
+                    SendCommand(l_command.c_str());
+                }
+
+                // Source is switched by first frame after command, switch and warm-up frames aren't measured.
+                // Replay gets single frame, warm-up would consume recorded frames.
+                const uint32_t l_warmupFrames = (m_replay ? 1U : g_warmupFrames);
+                for(uint32_t i = 0U; i < l_warmupFrames; i++) m_provider->RunFrame();
+
+                m_wallHistogram->Reset();
+                m_cpuHistogram->Reset();
+                for(auto l_histogram : m_stageHistograms) l_histogram->Reset();
+                m_driverContext->GetStatistics()->Reset();
+                m_lastCalls.assign(CApiStatistics::AC_Count, CallCounters());
+                m_callTotals.assign(CApiStatistics::AC_Count, CallCounters());
+                m_callMaximums.assign(CApiStatistics::AC_Count, 0U);
+                m_framesCount = 0U;
+            }
+            else
+            {
+                std::cerr << "Tracking reference isn't added by driver" << std::endl;
+                m_driverContext->GetServerDriverHost()->DeactivateDevices();
+                m_provider->Cleanup();
+            }
+        }
+        else std::cerr << "Driver initialization failed" << std::endl;
+
+        if(!m_station)
+        {
+            delete m_driverContext;
+            m_driverContext = nullptr;
+            m_provider = nullptr;
+        }
+    }
+    else std::cerr << "Driver factory failed with error " << l_error << std::endl;
+    return (m_station != nullptr);
+}
+
+void CDriverBenchmark::Terminate()
+{
+    if(m_station)
+    {
+        if(m_replay) SendCommand("replay stop");
+        m_driverContext->GetServerDriverHost()->DeactivateDevices();
+        m_provider->Cleanup();
+        delete m_driverContext;
+        m_driverContext = nullptr;
+        m_provider = nullptr;
+        m_station = nullptr;
+    }
+}
+
+void CDriverBenchmark::RunFrame()
+{
+    CFrameProfiler::Reset();
+    const int64_t l_startCpu = GetThreadTime();
+    const auto l_start = std::chrono::steady_clock::now();
+    m_provider->RunFrame();
+    const auto l_end = std::chrono::steady_clock::now();
+    const int64_t l_endCpu = GetThreadTime();
+    m_wallHistogram->Add(std::chrono::duration_cast<std::chrono::nanoseconds>(l_end - l_start).count());
+    m_cpuHistogram->Add(l_endCpu - l_startCpu);
+    for(size_t i = 0U; i < CFrameProfiler::FS_Count; i++) m_stageHistograms[i]->Add(CFrameProfiler::GetStageTime(i));
+
+    const CApiStatistics *l_statistics = m_driverContext->GetStatistics();
+    for(size_t i = 0U; i < CApiStatistics::AC_Count; i++)
+    {
+        CallCounters &l_last = m_lastCalls[i];
+        CallCounters &l_total = m_callTotals[i];
+        const uint64_t l_count = l_statistics->GetCallsCount(i);
+        const uint64_t l_payload = l_statistics->GetPayloadSize(i);
+        const int64_t l_time = l_statistics->GetCallsTime(i);
+        m_callMaximums[i] = std::max(m_callMaximums[i], l_count - l_last.m_count);
+        l_total.m_count += (l_count - l_last.m_count);
+        l_total.m_payload += (l_payload - l_last.m_payload);
+        l_total.m_time += (l_time - l_last.m_time);
+        l_last.m_count = l_count;
+        l_last.m_payload = l_payload;
+        l_last.m_time = l_time;
+    }
+    m_framesCount++;
+}
+
+std::string CDriverBenchmark::SendCommand(const char *f_cmd)
+{
+    char l_response[g_responseSize] = { 0 };
+    m_station->DebugRequest(f_cmd, l_response, g_responseSize);
+    return std::string(l_response);
+}
+
+bool CDriverBenchmark::IsReplayFinished()
+{
+    // Replaying, finished and frames count
+    std::stringstream l_stream(SendCommand("stats replay"));
+    bool l_replaying = false;
+    bool l_finished = false;
+    l_stream >> l_replaying >> l_finished;
+    return (l_stream.fail() || !l_replaying || l_finished);
+}
+
+int64_t CDriverBenchmark::GetThreadTime()
+{
+    timespec l_time = { 0 };
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &l_time);
+    return (static_cast<int64_t>(l_time.tv_sec) * 1000000000LL + static_cast<int64_t>(l_time.tv_nsec));
+}
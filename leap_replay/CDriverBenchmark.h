@@ -0,0 +1,51 @@
+#pragma once
+
+class CHistogram;
+class CStandInDriverContext;
+
+// Headless host that runs driver frames at fixed rate over synthetic or recorded hands,
+// collects per-stage timing of RunFrame and calls of stand-in server interfaces per frame
+class CDriverBenchmark final
+{
+    struct CallCounters
+    {
+        uint64_t m_count;
+        uint64_t m_payload;
+        int64_t m_time;
+    };
+
+    CStandInDriverContext *m_driverContext;
+    vr::IServerTrackedDeviceProvider *m_provider;
+    vr::ITrackedDeviceServerDriver *m_station;
+    bool m_replay;
+    CHistogram *m_wallHistogram;
+    CHistogram *m_cpuHistogram;
+    std::vector<CHistogram*> m_stageHistograms;
+    std::vector<CallCounters> m_lastCalls; // Counters before current frame
+    std::vector<CallCounters> m_callTotals;
+    std::vector<uint64_t> m_callMaximums; // Most calls in single frame
+    uint64_t m_framesCount;
+    int64_t m_runTime;
+
+    CDriverBenchmark(const CDriverBenchmark &that) = delete;
+    CDriverBenchmark& operator=(const CDriverBenchmark &that) = delete;
+
+    bool Initialize(const std::string &f_source, int64_t f_latency);
+    void Terminate();
+    void RunFrame();
+    std::string SendCommand(const char *f_cmd);
+    bool IsReplayFinished();
+
+    static int64_t GetThreadTime();
+public:
+    CDriverBenchmark();
+    ~CDriverBenchmark();
+
+    // Source is "synthetic" or path of recording, zero rate runs frames without pause.
+    // Recording is replayed once in fast mode and benchmark ends with it.
+    // Latency in nanoseconds is added to every call of server interfaces.
+    bool Run(const std::string &f_source, uint32_t f_rate, uint64_t f_framesLimit, int64_t f_latency);
+
+    // Times are in nanoseconds. Wall time of frame includes preemption and sleeps of frame thread, thread CPU time doesn't.
+    void WriteSummary(std::ostream &f_stream) const;
+};
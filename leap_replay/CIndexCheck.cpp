@@ -0,0 +1,130 @@
+#include "stdafx.h"
+
+#include "CIndexCheck.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CMappedSessionReader.h"
+#include "Core/CSessionIndex.h"
+#include "Core/CSessionRecorder.h"
+
+CIndexCheck::CIndexCheck()
+{
+    m_framesCount = 0U;
+}
+
+CIndexCheck::~CIndexCheck()
+{
+}
+
+bool CIndexCheck::Run(const std::string &f_path)
+{
+    bool l_result = false;
+    m_results.clear();
+
+    CSessionIndex l_index;
+    bool l_opened = false;
+    if(ReadFile(f_path, m_data) && l_index.Read(m_data.data(), m_data.size()))
+    {
+        m_framesCount = CountFrames(f_path, l_opened);
+
+        const size_t l_size = m_data.size();
+        const std::string l_path(f_path + ".index_check");
+        std::vector<uint8_t> l_data;
+        uint64_t l_offset = 0U;
+
+        // Trailer offsets that leave no room for record header and entries count
+        const uint64_t l_offsets[] = { l_size - 3U, l_size - CSessionIndex::IF_TrailerSize - 1U, l_size + 100U };
+        const char *l_offsetNames[] = { "offset_near_end", "offset_in_trailer", "offset_past_end" };
+        for(size_t i = 0U; i < 3U; i++)
+        {
+            l_data = m_data;
+            l_offset = l_offsets[i];
+            std::memcpy(l_data.data() + l_size - CSessionIndex::IF_TrailerSize, &l_offset, sizeof(l_offset));
+            RunCase(l_offsetNames[i], l_data, l_path);
+        }
+
+        // Offset of first frame record instead of index record
+        l_data = m_data;
+        l_offset = CSessionRecorder::RF_HeaderSize;
+        std::memcpy(l_data.data() + l_size - CSessionIndex::IF_TrailerSize, &l_offset, sizeof(l_offset));
+        RunCase("offset_to_frame", l_data, l_path);
+
+        // Entries count that doesn't match record size
+        l_data = m_data;
+        std::memcpy(&l_offset, l_data.data() + l_size - CSessionIndex::IF_TrailerSize, sizeof(l_offset));
+        const uint32_t l_count = std::numeric_limits<uint32_t>::max();
+        std::memcpy(l_data.data() + l_offset + CSessionRecorder::RF_RecordHeaderSize, &l_count, sizeof(l_count));
+        RunCase("count_overflow", l_data, l_path);
+
+        // Writer stopped in middle of trailer
+        l_data = m_data;
+        l_data.resize(l_size - 6U);
+        RunCase("truncated_trailer", l_data, l_path);
+
+        std::remove(l_path.c_str());
+        l_result = l_opened;
+    }
+    else std::cerr << "Unable to read index of " << f_path << std::endl;
+    return l_result;
+}
+
+bool CIndexCheck::IsPassed() const
+{
+    bool l_result = !m_results.empty();
+    for(const auto &l_case : m_results) l_result = (l_result && l_case.m_indexRejected && l_case.m_opened && (l_case.m_framesCount == m_framesCount));
+    return l_result;
+}
+
+void CIndexCheck::WriteSummary(std::ostream &f_stream) const
+{
+    f_stream << "frames " << m_framesCount << '\n';
+    for(const auto &l_case : m_results)
+    {
+        const bool l_passed = (l_case.m_indexRejected && l_case.m_opened && (l_case.m_framesCount == m_framesCount));
+        f_stream << l_case.m_name << " index_rejected " << l_case.m_indexRejected << " opened " << l_case.m_opened << " frames " << l_case.m_framesCount << (l_passed ? " passed" : " FAILED") << '\n';
+    }
+}
+
+void CIndexCheck::RunCase(const char *f_name, const std::vector<uint8_t> &f_data, const std::string &f_path)
+{
+    Result l_result = { f_name, false, false, 0U };
+
+    // Parsed from exact size buffer, so any read past end is caught by address sanitizer
+    CSessionIndex l_index;
+    uint8_t *l_buffer = new uint8_t[f_data.size()];
+    std::memcpy(l_buffer, f_data.data(), f_data.size());
+    l_result.m_indexRejected = !l_index.Read(l_buffer, f_data.size());
+    delete[]l_buffer;
+
+    if(WriteFile(f_path, f_data)) l_result.m_framesCount = CountFrames(f_path, l_result.m_opened);
+    m_results.push_back(l_result);
+}
+
+bool CIndexCheck::ReadFile(const std::string &f_path, std::vector<uint8_t> &f_data)
+{
+    std::ifstream l_file(f_path, std::ios::binary);
+    f_data.assign(std::istreambuf_iterator<char>(l_file), std::istreambuf_iterator<char>());
+    return (l_file.is_open() && !f_data.empty());
+}
+
+bool CIndexCheck::WriteFile(const std::string &f_path, const std::vector<uint8_t> &f_data)
+{
+    std::ofstream l_file(f_path, std::ios::binary | std::ios::trunc);
+    l_file.write(reinterpret_cast<const char*>(f_data.data()), static_cast<std::streamsize>(f_data.size()));
+    l_file.close();
+    return !l_file.fail();
+}
+
+uint64_t CIndexCheck::CountFrames(const std::string &f_path, bool &f_opened)
+{
+    uint64_t l_result = 0U;
+    CMappedSessionReader l_reader;
+    f_opened = l_reader.Open(f_path);
+    if(f_opened)
+    {
+        CLeapFrame l_frame;
+        int64_t l_hostTime = 0;
+        while(l_reader.Read(l_frame, l_hostTime)) l_result++;
+        l_reader.Close();
+    }
+    return l_result;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// Damages footer index of copies of indexed recording and checks that reader falls back to linear scan with same frames
+class CIndexCheck final
+{
+    struct Result
+    {
+        std::string m_name;
+        bool m_indexRejected;
+        bool m_opened;
+        uint64_t m_framesCount;
+    };
+
+    std::vector<uint8_t> m_data;
+    uint64_t m_framesCount;
+    std::vector<Result> m_results;
+
+    CIndexCheck(const CIndexCheck &that) = delete;
+    CIndexCheck& operator=(const CIndexCheck &that) = delete;
+
+    void RunCase(const char *f_name, const std::vector<uint8_t> &f_data, const std::string &f_path);
+
+    static bool ReadFile(const std::string &f_path, std::vector<uint8_t> &f_data);
+    static bool WriteFile(const std::string &f_path, const std::vector<uint8_t> &f_data);
+    static uint64_t CountFrames(const std::string &f_path, bool &f_opened);
+public:
+    CIndexCheck();
+    ~CIndexCheck();
+
+    // Damaged copies are written next to recording and removed after check
+    bool Run(const std::string &f_path);
+    bool IsPassed() const;
+
+    void WriteSummary(std::ostream &f_stream) const;
+};
@@ -0,0 +1,366 @@
+#include "stdafx.h"
+
+#include "CKernelBenchmark.h"
+#include "StandIn/CStandInDriverContext.h"
+#include "StandIn/CStandInServerDriverHost.h"
+#include "Core/CDriverConfig.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CMappedSessionReader.h"
+#include "Core/CSyntheticSource.h"
+#include "Devices/CLeapController/CControllerButton.h"
+#include "Devices/CLeapController/CLeapControllerIndex.h"
+#include "Utils/CFrameProfiler.h"
+#include "Utils/CGestureMatcher.h"
+#include "Utils/CStageTimer.h"
+#include "Utils/Utils.h"
+
+extern char g_modulePath[];
+extern uint64_t g_allocationsCount;
+
+const char g_syntheticSource[] = "synthetic";
+const float g_syntheticRate = 120.f;
+const size_t g_syntheticFrames = 512U; // Covers full periods of synthetic motion
+const size_t g_recordedFrames = 4096U;
+const size_t g_buttonsCount = 16U; // Roughly as of Index controller
+
+CKernelBenchmark::CKernelBenchmark()
+{
+    m_driverContext = nullptr;
+    for(size_t i = 0U; i < KH_Count; i++) m_controllers[i] = nullptr;
+    m_iterations = 0U;
+    m_sink = 0.f;
+}
+
+CKernelBenchmark::~CKernelBenchmark()
+{
+    DestroyControllers();
+}
+
+bool CKernelBenchmark::Run(const std::string &f_source, uint64_t f_iterations)
+{
+    bool l_result = false;
+    m_results.clear();
+    m_iterations = std::max(f_iterations, static_cast<uint64_t>(1U));
+    if(LoadFrames(f_source))
+    {
+        if(CreateControllers())
+        {
+            RunGestures(false);
+            RunGestures(true);
+            RunTransformation(CDriverConfig::OM_HMD);
+            RunTransformation(CDriverConfig::OM_Desktop);
+            RunSkeleton();
+            RunButtons();
+            RunMatrixConversion();
+            RunQuaternionConversion();
+            l_result = true;
+        }
+        else std::cerr << "Controllers activation failed" << std::endl;
+        DestroyControllers();
+    }
+    return l_result;
+}
+
+void CKernelBenchmark::WriteJson(std::ostream &f_stream) const
+{
+    f_stream << "{\n";
+    f_stream << "  \"source\": \"" << ((m_source == g_syntheticSource) ? m_source : std::string("recording")) << "\",\n";
+    f_stream << "  \"frames\": " << m_frames.size() << ",\n";
+    f_stream << "  \"iterations\": " << m_iterations << ",\n";
+    f_stream << "  \"results\": [\n";
+    for(size_t i = 0U, j = m_results.size(); i < j; i++)
+    {
+        const Result &l_result = m_results[i];
+        const double l_operations = static_cast<double>(std::max(l_result.m_operations, static_cast<uint64_t>(1U)));
+        f_stream << "    { \"name\": \"" << l_result.m_name << "\", \"kernel\": \"" << l_result.m_kernel << "\", \"timing\": \"" << (l_result.m_stage ? "stage" : "loop") << "\"";
+        f_stream << ", \"operations\": " << l_result.m_operations;
+        f_stream << ", \"ns_per_op\": " << (static_cast<double>(l_result.m_time) / l_operations);
+        f_stream << ", \"allocations_per_op\": " << (static_cast<double>(l_result.m_allocations) / l_operations);
+        if(l_result.m_stage) f_stream << ", \"timer_overhead_ns\": " << l_result.m_overhead;
+        f_stream << " }";
+        f_stream << (((i + 1U) < j) ? ",\n" : "\n");
+    }
+    f_stream << "  ]\n";
+    f_stream << "}\n";
+}
+
+bool CKernelBenchmark::LoadFrames(const std::string &f_source)
+{
+    m_source.assign(f_source);
+    m_frames.clear();
+    m_hands.clear();
+
+    if(f_source == g_syntheticSource)
+    {
+        // Frames are generated by time only, source isn't initialized
+        CSyntheticSource l_source;
+        l_source.SetParameters(g_syntheticRate, 2U);
+        CLeapFrame l_frame;
+        for(size_t i = 0U; i < g_syntheticFrames; i++)
+        {
+            l_source.GenerateFrame(static_cast<int64_t>(static_cast<double>(i) * 1000000.0 / static_cast<double>(g_syntheticRate)), static_cast<int64_t>(i), l_frame);
+            m_frames.push_back(l_frame);
+        }
+    }
+    else
+    {
+        CMappedSessionReader l_reader;
+        if(l_reader.Open(f_source))
+        {
+            // Frames without hands don't run kernels
+            CLeapFrame l_frame;
+            int64_t l_hostTime = 0;
+            while((m_frames.size() < g_recordedFrames) && l_reader.Read(l_frame, l_hostTime))
+            {
+                if(l_frame.GetEvent()->nHands > 0U) m_frames.push_back(l_frame);
+            }
+            l_reader.Close();
+        }
+        else std::cerr << "Unable to open " << f_source << std::endl;
+    }
+
+    // Frames don't move anymore
+    for(const auto &l_frame : m_frames)
+    {
+        const LEAP_TRACKING_EVENT *l_event = l_frame.GetEvent();
+        const LEAP_HAND *l_hands[KH_Count] = { nullptr };
+        for(uint32_t i = 0U; i < l_event->nHands; i++)
+        {
+            const size_t l_side = static_cast<size_t>(l_event->pHands[i].type);
+            if((l_side < KH_Count) && !l_hands[l_side]) l_hands[l_side] = &l_event->pHands[i];
+        }
+        for(size_t i = 0U; i < KH_Count; i++) m_hands.push_back(l_hands[i]);
+    }
+
+    if(m_frames.empty()) std::cerr << "No frames with hands in " << f_source << std::endl;
+    return !m_frames.empty();
+}
+
+bool CKernelBenchmark::CreateControllers()
+{
+    // Settings are read relatively to module path
+    std::string l_modulePath(LEAP_REPLAY_ROOT);
+    l_modulePath.append("/bin/linux64/driver_leap.so");
+    std::strncpy(g_modulePath, l_modulePath.c_str(), 2047U);
+
+    m_driverContext = new CStandInDriverContext();
+    bool l_result = (vr::InitServerDriverContext(m_driverContext) == vr::VRInitError_None);
+    if(l_result)
+    {
+        CDriverConfig::Load();
+
+        // Index controller runs every stage, including skeleton
+        for(size_t i = 0U; i < KH_Count; i++)
+        {
+            m_controllers[i] = new CLeapControllerIndex((i == KH_Left) ? CLeapController::CH_Left : CLeapController::CH_Right);
+            if(m_driverContext->GetServerDriverHost()->TrackedDeviceAdded(m_controllers[i]->GetSerialNumber().c_str(), vr::TrackedDeviceClass_Controller, m_controllers[i])) m_controllers[i]->SetEnabled(true);
+            else l_result = false;
+        }
+        CLeapController::UpdateHMDCoordinates();
+    }
+    return l_result;
+}
+
+void CKernelBenchmark::DestroyControllers()
+{
+    if(m_driverContext)
+    {
+        m_driverContext->GetServerDriverHost()->DeactivateDevices();
+        for(size_t i = 0U; i < KH_Count; i++)
+        {
+            delete m_controllers[i];
+            m_controllers[i] = nullptr;
+        }
+        vr::CleanupDriverContext();
+        delete m_driverContext;
+        m_driverContext = nullptr;
+    }
+}
+
+void CKernelBenchmark::RunGestures(bool f_opposite)
+{
+    m_gestures.assign(CGestureMatcher::HG_Count, 0.f);
+
+    uint64_t l_operations = 0U;
+    const uint64_t l_allocations = g_allocationsCount;
+    const auto l_start = std::chrono::steady_clock::now();
+    for(uint64_t i = 0U; i < m_iterations; i++)
+    {
+        const size_t l_frame = static_cast<size_t>(i % m_frames.size());
+        const size_t l_side = static_cast<size_t>(i % KH_Count);
+        const LEAP_HAND *l_hand = GetHand(l_frame, l_side);
+        if(l_hand)
+        {
+            CGestureMatcher::GetGestures(l_hand, m_gestures, f_opposite ? GetHand(l_frame, (l_side + 1U) % KH_Count) : nullptr);
+            m_sink += m_gestures[CGestureMatcher::HG_Trigger];
+            l_operations++;
+        }
+    }
+    const int64_t l_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start).count();
+    AddResult(f_opposite ? "gestures_opposite_hand" : "gestures", "CGestureMatcher::GetGestures", false, l_operations, l_time, g_allocationsCount - l_allocations);
+}
+
+void CKernelBenchmark::RunTransformation(unsigned char f_mode)
+{
+    const unsigned char l_mode = CDriverConfig::GetOrientationMode();
+    CDriverConfig::SetOrientationMode(f_mode);
+    RunStage(CFrameProfiler::FS_Transformation, (f_mode == CDriverConfig::OM_HMD) ? "transformation_hmd" : "transformation_desktop", "CLeapController::UpdateTransformation");
+    CDriverConfig::SetOrientationMode(l_mode);
+}
+
+void CKernelBenchmark::RunSkeleton()
+{
+    RunStage(CFrameProfiler::FS_Gestures, "index_skeleton", "CLeapControllerIndex::UpdateGestures");
+}
+
+void CKernelBenchmark::RunButtons()
+{
+    std::vector<CControllerButton*> l_buttons;
+    for(size_t i = 0U; i < g_buttonsCount; i++)
+    {
+        CControllerButton *l_button = new CControllerButton();
+        l_button->SetInputType(((i % 2U) == 0U) ? CControllerButton::IT_Boolean : CControllerButton::IT_Float);
+        l_buttons.push_back(l_button);
+    }
+
+    // Operation is update of all buttons by gestures of hand and pass over dirty ones as in controller input update
+    uint64_t l_operations = 0U;
+    const uint64_t l_allocations = g_allocationsCount;
+    const auto l_start = std::chrono::steady_clock::now();
+    for(uint64_t i = 0U; i < m_iterations; i++)
+    {
+        const LEAP_HAND *l_hand = GetHand(static_cast<size_t>(i % m_frames.size()), static_cast<size_t>(i % KH_Count));
+        if(l_hand)
+        {
+            for(size_t j = 0U; j < g_buttonsCount; j++)
+            {
+                const float l_value = ((j < 10U) ? l_hand->grab_strength : l_hand->pinch_strength);
+                l_buttons[j]->SetState(l_value > 0.5f);
+                l_buttons[j]->SetValue(l_value);
+            }
+            for(auto l_button : l_buttons)
+            {
+                if(l_button->IsUpdated())
+                {
+                    m_sink += ((l_button->GetInputType() == CControllerButton::IT_Boolean) ? (l_button->GetState() ? 1.f : 0.f) : l_button->GetValue());
+                    l_button->ResetUpdate();
+                }
+            }
+            l_operations++;
+        }
+    }
+    const int64_t l_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start).count();
+    AddResult("button_dirty_tracking", "CControllerButton", false, l_operations, l_time, g_allocationsCount - l_allocations);
+
+    for(auto l_button : l_buttons) delete l_button;
+}
+
+void CKernelBenchmark::RunMatrixConversion()
+{
+    // Device matrices are made of palm positions of frames
+    std::vector<vr::HmdMatrix34_t> l_matrices(m_frames.size());
+    for(size_t i = 0U; i < m_frames.size(); i++)
+    {
+        const LEAP_HAND *l_hand = GetHand(i, KH_Left) ? GetHand(i, KH_Left) : GetHand(i, KH_Right);
+        vr::HmdMatrix34_t &l_matrix = l_matrices[i];
+        std::memset(&l_matrix, 0, sizeof(vr::HmdMatrix34_t));
+        for(size_t j = 0U; j < 3U; j++)
+        {
+            l_matrix.m[j][j] = 1.f;
+            l_matrix.m[j][3U] = l_hand->palm.position.v[j] * 0.001f;
+        }
+    }
+
+    glm::mat4 l_result(1.f);
+    const uint64_t l_allocations = g_allocationsCount;
+    const auto l_start = std::chrono::steady_clock::now();
+    for(uint64_t i = 0U; i < m_iterations; i++)
+    {
+        ConvertMatrix(l_matrices[static_cast<size_t>(i % l_matrices.size())], l_result);
+        m_sink += l_result[3].x;
+    }
+    const int64_t l_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start).count();
+    AddResult("convert_matrix", "ConvertMatrix", false, m_iterations, l_time, g_allocationsCount - l_allocations);
+}
+
+void CKernelBenchmark::RunQuaternionConversion()
+{
+    // Operation is conversion of LeapC orientation to glm and of glm to OpenVR, as for skeleton bones
+    glm::quat l_rotation(1.f, 0.f, 0.f, 0.f);
+    vr::HmdQuaternionf_t l_result = { 1.f, 0.f, 0.f, 0.f };
+    uint64_t l_operations = 0U;
+    const uint64_t l_allocations = g_allocationsCount;
+    const auto l_start = std::chrono::steady_clock::now();
+    for(uint64_t i = 0U; i < m_iterations; i++)
+    {
+        const LEAP_HAND *l_hand = GetHand(static_cast<size_t>(i % m_frames.size()), static_cast<size_t>(i % KH_Count));
+        if(l_hand)
+        {
+            ConvertQuaternion(l_hand->digits[i % 5U].bones[i % 4U].rotation, l_rotation);
+            ConvertQuaternion(l_rotation, l_result);
+            m_sink += l_result.w;
+            l_operations++;
+        }
+    }
+    const int64_t l_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start).count();
+    AddResult("convert_quaternion", "ConvertQuaternion", false, l_operations, l_time, g_allocationsCount - l_allocations);
+}
+
+// Controller runs whole frame, only time and allocations of stage are taken.
+// Each operation is timed separately by stage timer, its overhead is measured on empty scope and subtracted.
+void CKernelBenchmark::RunStage(size_t f_stage, const char *f_name, const char *f_kernel)
+{
+    uint64_t l_operations = 0U;
+    int64_t l_time = 0;
+    uint64_t l_allocations = 0U;
+    CFrameProfiler::SetAllocationsCounter(&g_allocationsCount);
+    CFrameProfiler::SetEnabled(true);
+
+    int64_t l_overheadTime = 0;
+    for(uint64_t i = 0U; i < m_iterations; i++)
+    {
+        CFrameProfiler::Reset();
+        {
+            STAGE_TIMER(f_stage);
+        }
+        l_overheadTime += CFrameProfiler::GetStageTime(f_stage);
+    }
+    const double l_overhead = static_cast<double>(l_overheadTime) / static_cast<double>(m_iterations);
+
+    for(uint64_t i = 0U; i < m_iterations; i++)
+    {
+        const size_t l_frame = static_cast<size_t>(i % m_frames.size());
+        const size_t l_side = static_cast<size_t>(i % KH_Count);
+        const LEAP_HAND *l_hand = GetHand(l_frame, l_side);
+        if(l_hand)
+        {
+            CFrameProfiler::Reset();
+            m_controllers[l_side]->RunFrame(l_hand, GetHand(l_frame, (l_side + 1U) % KH_Count));
+            l_time += CFrameProfiler::GetStageTime(f_stage);
+            l_allocations += CFrameProfiler::GetStageAllocations(f_stage);
+            l_operations++;
+        }
+    }
+    CFrameProfiler::SetEnabled(false);
+    CFrameProfiler::SetAllocationsCounter(nullptr);
+    l_time = std::max(l_time - static_cast<int64_t>(std::llround(l_overhead * static_cast<double>(l_operations))), static_cast<int64_t>(0));
+    AddResult(f_name, f_kernel, true, l_operations, l_time, l_allocations, l_overhead);
+}
+
+void CKernelBenchmark::AddResult(const char *f_name, const char *f_kernel, bool f_stage, uint64_t f_operations, int64_t f_time, uint64_t f_allocations, double f_overhead)
+{
+    Result l_result;
+    l_result.m_name.assign(f_name);
+    l_result.m_kernel.assign(f_kernel);
+    l_result.m_stage = f_stage;
+    l_result.m_operations = f_operations;
+    l_result.m_time = f_time;
+    l_result.m_allocations = f_allocations;
+    l_result.m_overhead = f_overhead;
+    m_results.push_back(l_result);
+}
+
+const LEAP_HAND* CKernelBenchmark::GetHand(size_t f_frame, size_t f_hand) const
+{
+    return m_hands[f_frame * KH_Count + f_hand];
+}
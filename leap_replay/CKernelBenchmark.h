@@ -0,0 +1,65 @@
+#pragma once
+
+class CLeapController;
+class CLeapFrame;
+class CStandInDriverContext;
+
+// Measures per-frame kernels of driver over synthetic or recorded hands, time and allocations are counted per operation.
+// Private controller stages are measured through frame profiler while controller runs its frame under stand-in server.
+class CKernelBenchmark final
+{
+    enum KernelHand : size_t
+    {
+        KH_Left = 0U,
+        KH_Right,
+
+        KH_Count
+    };
+    struct Result
+    {
+        std::string m_name;
+        std::string m_kernel;
+        bool m_stage; // Measured by frame profiler
+        uint64_t m_operations;
+        int64_t m_time;
+        uint64_t m_allocations;
+        double m_overhead; // Nanoseconds of stage timer per operation, subtracted from time
+    };
+
+    CStandInDriverContext *m_driverContext;
+    CLeapController *m_controllers[KH_Count];
+    std::vector<CLeapFrame> m_frames;
+    std::vector<const LEAP_HAND*> m_hands; // Left and right hand of each frame, nullptr if absent
+    std::vector<float> m_gestures;
+    std::vector<Result> m_results;
+    std::string m_source;
+    uint64_t m_iterations;
+    float m_sink; // Keeps results of kernels alive
+
+    CKernelBenchmark(const CKernelBenchmark &that) = delete;
+    CKernelBenchmark& operator=(const CKernelBenchmark &that) = delete;
+
+    bool LoadFrames(const std::string &f_source);
+    bool CreateControllers();
+    void DestroyControllers();
+
+    void RunGestures(bool f_opposite);
+    void RunTransformation(unsigned char f_mode);
+    void RunSkeleton();
+    void RunButtons();
+    void RunMatrixConversion();
+    void RunQuaternionConversion();
+    void RunStage(size_t f_stage, const char *f_name, const char *f_kernel);
+    void AddResult(const char *f_name, const char *f_kernel, bool f_stage, uint64_t f_operations, int64_t f_time, uint64_t f_allocations, double f_overhead = 0.0);
+
+    const LEAP_HAND* GetHand(size_t f_frame, size_t f_hand) const;
+public:
+    CKernelBenchmark();
+    ~CKernelBenchmark();
+
+    // Source is "synthetic" or path of recording, iterations are operations of each kernel
+    bool Run(const std::string &f_source, uint64_t f_iterations);
+
+    // Nanoseconds and allocations per operation of each kernel, stage kernels report subtracted timer overhead
+    void WriteJson(std::ostream &f_stream) const;
+};
@@ -0,0 +1,153 @@
+#include "stdafx.h"
+
+#include "CLeapReplay.h"
+#include "StandIn/CStandInDriverContext.h"
+#include "StandIn/CStandInServerDriverHost.h"
+#include "Utils/CHistogram.h"
+
+extern "C" void* HmdDriverFactory(const char *pInterfaceName, int *pReturnCode);
+extern char g_modulePath[];
+
+const char* const g_replayModes[]
+{
+    "realtime", "fast", "step"
+};
+const size_t g_responseSize = 256U;
+const std::chrono::microseconds g_framePeriod(11111); // 90 Hz
+
+CLeapReplay::CLeapReplay()
+{
+    m_active = false;
+    m_mode = RM_Realtime;
+    m_output = nullptr;
+    m_driverContext = nullptr;
+    m_provider = nullptr;
+    m_station = nullptr;
+    m_frameHistogram = new CHistogram(10, 1000U);
+    m_framesCount = 0U;
+}
+
+CLeapReplay::~CLeapReplay()
+{
+    delete m_frameHistogram;
+}
+
+bool CLeapReplay::Initialize(const std::string &f_path, unsigned char f_mode, std::ostream *f_output)
+{
+    if(!m_active && (f_mode < RM_Count))
+    {
+        m_path.assign(f_path);
+        m_mode = f_mode;
+        m_output = f_output;
+
+        // Settings are read relatively to module path
+        std::string l_modulePath(LEAP_REPLAY_ROOT);
+        l_modulePath.append("/bin/linux64/driver_leap.so");
+        std::strncpy(g_modulePath, l_modulePath.c_str(), 2047U);
+
+        int l_error = vr::VRInitError_None;
+        m_provider = reinterpret_cast<vr::IServerTrackedDeviceProvider*>(HmdDriverFactory(vr::IServerTrackedDeviceProvider_Version, &l_error));
+        if(m_provider)
+        {
+            m_driverContext = new CStandInDriverContext();
+            m_driverContext->SetOutput(m_output);
+            if(m_provider->Init(m_driverContext) == vr::VRInitError_None)
+            {
+                CStandInServerDriverHost *l_host = m_driverContext->GetServerDriverHost();
+                m_station = l_host->GetDevice(l_host->FindDevice(vr::TrackedDeviceClass_TrackingReference));
+                if(m_station)
+                {
+                    std::string l_command("replay start ");
+                    l_command.append(g_replayModes[m_mode]);
+                    l_command.push_back(' ');
+                    l_command.append(m_path);
+                    SendCommand(l_command.c_str());
+
+                    m_frameHistogram->Reset();
+                    m_framesCount = 0U;
+                    m_nextFrame = std::chrono::steady_clock::now();
+                    m_active = true;
+                }
+                else
+                {
+                    std::cerr << "Tracking reference isn't added by driver" << std::endl;
+                    m_provider->Cleanup();
+                }
+            }
+            else std::cerr << "Driver initialization failed" << std::endl;
+
+            if(!m_active)
+            {
+                delete m_driverContext;
+                m_driverContext = nullptr;
+                m_provider = nullptr;
+            }
+        }
+        else std::cerr << "Driver factory failed with error " << l_error << std::endl;
+    }
+    return m_active;
+}
+
+void CLeapReplay::Terminate()
+{
+    if(m_active)
+    {
+        SendCommand("replay stop");
+        m_driverContext->GetServerDriverHost()->DeactivateDevices();
+        m_provider->Cleanup();
+        delete m_driverContext;
+        m_driverContext = nullptr;
+        m_provider = nullptr;
+        m_station = nullptr;
+        m_active = false;
+    }
+}
+
+bool CLeapReplay::DoPulse()
+{
+    bool l_result = false;
+    if(m_active)
+    {
+        if(m_output) *m_output << "frame " << m_framesCount << '\n';
+        if(m_mode == RM_Step) SendCommand("replay step 1");
+
+        const auto l_start = std::chrono::steady_clock::now();
+        m_provider->RunFrame();
+        const auto l_end = std::chrono::steady_clock::now();
+        m_frameHistogram->Add(std::chrono::duration_cast<std::chrono::microseconds>(l_end - l_start).count());
+        m_framesCount++;
+
+        // Replay is started by driver on first frame
+        l_result = ((m_framesCount == 1U) || !IsFinished());
+        if(l_result && (m_mode == RM_Realtime))
+        {
+            m_nextFrame += g_framePeriod;
+            std::this_thread::sleep_until(m_nextFrame);
+        }
+    }
+    return l_result;
+}
+
+void CLeapReplay::WriteSummary(std::ostream &f_stream) const
+{
+    f_stream << "frames " << m_frameHistogram->GetCount() << '\n';
+    f_stream << "runframe_us avg " << m_frameHistogram->GetAverage() << " p50 " << m_frameHistogram->GetPercentile(50.f);
+    f_stream << " p99 " << m_frameHistogram->GetPercentile(99.f) << " max " << m_frameHistogram->GetMax() << '\n';
+}
+
+std::string CLeapReplay::SendCommand(const char *f_cmd)
+{
+    char l_response[g_responseSize] = { 0 };
+    m_station->DebugRequest(f_cmd, l_response, g_responseSize);
+    return std::string(l_response);
+}
+
+bool CLeapReplay::IsFinished()
+{
+    // Replaying, finished and frames count
+    std::stringstream l_stream(SendCommand("stats replay"));
+    bool l_replaying = false;
+    bool l_finished = false;
+    l_stream >> l_replaying >> l_finished;
+    return (l_stream.fail() || !l_replaying || l_finished);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+class CHistogram;
+class CStandInDriverContext;
+
+// Headless host that loads driver with stand-in server interfaces and runs its frames over recorded session
+class CLeapReplay final
+{
+    bool m_active;
+    std::string m_path;
+    unsigned char m_mode;
+    std::ostream *m_output;
+    CStandInDriverContext *m_driverContext;
+    vr::IServerTrackedDeviceProvider *m_provider;
+    vr::ITrackedDeviceServerDriver *m_station;
+    CHistogram *m_frameHistogram;
+    uint64_t m_framesCount;
+    std::chrono::steady_clock::time_point m_nextFrame;
+
+    CLeapReplay(const CLeapReplay &that) = delete;
+    CLeapReplay& operator=(const CLeapReplay &that) = delete;
+
+    std::string SendCommand(const char *f_cmd);
+    bool IsFinished();
+public:
+    // Matches driver replay modes
+    enum ReplayMode : unsigned char
+    {
+        RM_Realtime = 0U,
+        RM_Fast,
+        RM_Step,
+
+        RM_Count
+    };
+
+    CLeapReplay();
+    ~CLeapReplay();
+
+    // Output can be nullptr
+    bool Initialize(const std::string &f_path, unsigned char f_mode, std::ostream *f_output);
+    void Terminate();
+    bool DoPulse();
+
+    // Time of RunFrame in microseconds
+    void WriteSummary(std::ostream &f_stream) const;
+};
@@ -0,0 +1,195 @@
+#include "stdafx.h"
+
+#include "CPredictionBenchmark.h"
+#include "Core/CFrameHistory.h"
+#include "Core/CHandPredictor.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CMappedSessionReader.h"
+#include "Core/CSyntheticSource.h"
+#include "Utils/CHistogram.h"
+#include "Utils/Utils.h"
+
+const char g_syntheticSource[] = "synthetic";
+const float g_syntheticRate = 120.f;
+const size_t g_syntheticFrames = 1200U;
+const size_t g_samplesCount = 4U; // Same as driver predictor
+
+CPredictionBenchmark::CPredictionBenchmark()
+{
+    m_history = new CFrameHistory();
+    m_samples = new CLeapFrame[g_samplesCount];
+    m_predicted = new CLeapFrame();
+}
+
+CPredictionBenchmark::~CPredictionBenchmark()
+{
+    ClearResults();
+    delete m_history;
+    delete[]m_samples;
+    delete m_predicted;
+}
+
+bool CPredictionBenchmark::Run(const std::string &f_source, const std::vector<int64_t> &f_horizons)
+{
+    bool l_result = false;
+    ClearResults();
+    if(LoadFrames(f_source) && (m_frames.size() > 1U))
+    {
+        for(const auto l_horizon : f_horizons)
+        {
+            Result l_horizonResult;
+            l_horizonResult.m_horizon = l_horizon;
+            l_horizonResult.m_palmError = new CHistogram(10, 10000U);
+            l_horizonResult.m_jointError = new CHistogram(10, 10000U);
+            l_horizonResult.m_heldError = new CHistogram(10, 10000U);
+            l_horizonResult.m_cost = new CHistogram(10, 10000U);
+            RunHorizon(l_horizonResult);
+            m_results.push_back(l_horizonResult);
+        }
+        l_result = true;
+    }
+    return l_result;
+}
+
+void CPredictionBenchmark::WriteSummary(std::ostream &f_stream) const
+{
+    f_stream << "source " << ((m_source == g_syntheticSource) ? m_source : std::string("recording")) << " frames " << m_frames.size() << '\n';
+    for(const auto &l_result : m_results)
+    {
+        f_stream << "horizon_ms " << (static_cast<double>(l_result.m_horizon) / 1000.0) << " predictions " << l_result.m_cost->GetCount() << " hands " << l_result.m_palmError->GetCount() << '\n';
+        f_stream << "  palm_mm avg " << (static_cast<double>(l_result.m_palmError->GetAverage()) / 1000.0) << " p50 " << (static_cast<double>(l_result.m_palmError->GetPercentile(50.f)) / 1000.0);
+        f_stream << " p99 " << (static_cast<double>(l_result.m_palmError->GetPercentile(99.f)) / 1000.0) << " max " << (static_cast<double>(l_result.m_palmError->GetMax()) / 1000.0) << '\n';
+        f_stream << "  joints_mm avg " << (static_cast<double>(l_result.m_jointError->GetAverage()) / 1000.0) << " p99 " << (static_cast<double>(l_result.m_jointError->GetPercentile(99.f)) / 1000.0);
+        f_stream << " max " << (static_cast<double>(l_result.m_jointError->GetMax()) / 1000.0) << '\n';
+        f_stream << "  held_palm_mm avg " << (static_cast<double>(l_result.m_heldError->GetAverage()) / 1000.0) << " p99 " << (static_cast<double>(l_result.m_heldError->GetPercentile(99.f)) / 1000.0);
+        f_stream << " max " << (static_cast<double>(l_result.m_heldError->GetMax()) / 1000.0) << '\n';
+        f_stream << "  cost_ns avg " << l_result.m_cost->GetAverage() << " p99 " << l_result.m_cost->GetPercentile(99.f) << " max " << l_result.m_cost->GetMax() << '\n';
+    }
+}
+
+bool CPredictionBenchmark::LoadFrames(const std::string &f_source)
+{
+    m_source.assign(f_source);
+    m_frames.clear();
+
+    bool l_result = false;
+    if(f_source == g_syntheticSource)
+    {
+        // Frames are generated by time only, source isn't initialized
+        CSyntheticSource l_source;
+        l_source.SetParameters(g_syntheticRate, 2U);
+        CLeapFrame l_frame;
+        for(size_t i = 0U; i < g_syntheticFrames; i++)
+        {
+            l_source.GenerateFrame(static_cast<int64_t>(static_cast<double>(i) * 1000000.0 / static_cast<double>(g_syntheticRate)), static_cast<int64_t>(i), l_frame);
+            m_frames.push_back(l_frame);
+        }
+        l_result = true;
+    }
+    else
+    {
+        CMappedSessionReader l_reader;
+        if(l_reader.Open(f_source))
+        {
+            // Frames with repeated timestamps aren't accepted by history and can't be ground truth
+            CLeapFrame l_frame;
+            int64_t l_hostTime = 0;
+            while(l_reader.Read(l_frame, l_hostTime))
+            {
+                if(m_frames.empty() || (l_frame.GetEvent()->info.timestamp > m_frames.back().GetEvent()->info.timestamp)) m_frames.push_back(l_frame);
+            }
+            l_reader.Close();
+            l_result = true;
+        }
+        else std::cerr << "Unable to open " << f_source << std::endl;
+    }
+    return l_result;
+}
+
+// Ground truth is interpolated between recorded frames around target time, frames without later frame aren't scored
+void CPredictionBenchmark::RunHorizon(Result &f_result)
+{
+    m_history->Clear();
+    size_t l_after = 0U;
+    for(size_t i = 0U, j = m_frames.size(); i < j; i++)
+    {
+        const LEAP_TRACKING_EVENT *l_event = m_frames[i].GetEvent();
+        m_history->Push(l_event);
+
+        const int64_t l_targetTime = l_event->info.timestamp + f_result.m_horizon;
+        while((l_after < j) && (m_frames[l_after].GetEvent()->info.timestamp <= l_targetTime)) l_after++;
+        if(l_after >= j) break;
+
+        // Same work as driver predictor does per call
+        const auto l_start = std::chrono::steady_clock::now();
+        const size_t l_count = m_history->GetLatest(m_samples, g_samplesCount);
+        CHandPredictor::Extrapolate(m_samples, l_count, l_targetTime, f_result.m_horizon, *m_predicted);
+        f_result.m_cost->Add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start).count());
+
+        const LEAP_TRACKING_EVENT *l_before = m_frames[l_after - 1U].GetEvent();
+        const LEAP_TRACKING_EVENT *l_next = m_frames[l_after].GetEvent();
+        const float l_weight = static_cast<float>(static_cast<double>(l_targetTime - l_before->info.timestamp) / static_cast<double>(l_next->info.timestamp - l_before->info.timestamp));
+        const LEAP_TRACKING_EVENT *l_predicted = m_predicted->GetEvent();
+        for(uint32_t k = 0U; k < l_predicted->nHands; k++)
+        {
+            const LEAP_HAND &l_hand = l_predicted->pHands[k];
+            const LEAP_HAND *l_beforeHand = FindHand(l_before, l_hand.id);
+            const LEAP_HAND *l_nextHand = FindHand(l_next, l_hand.id);
+            const LEAP_HAND *l_heldHand = FindHand(l_event, l_hand.id);
+            if(l_beforeHand && l_nextHand && l_heldHand)
+            {
+                glm::vec3 l_position;
+                const glm::vec3 l_actual = Interpolate(l_beforeHand->palm.position, l_nextHand->palm.position, l_weight);
+                ConvertVector3(l_hand.palm.position, l_position);
+                f_result.m_palmError->Add(static_cast<int64_t>(glm::distance(l_position, l_actual) * 1000.f));
+                ConvertVector3(l_heldHand->palm.position, l_position);
+                f_result.m_heldError->Add(static_cast<int64_t>(glm::distance(l_position, l_actual) * 1000.f));
+
+                float l_jointError = 0.f;
+                for(size_t l = 0U; l < 5U; l++)
+                {
+                    for(size_t m = 0U; m < 4U; m++)
+                    {
+                        ConvertVector3(l_hand.digits[l].bones[m].next_joint, l_position);
+                        l_jointError += glm::distance(l_position, Interpolate(l_beforeHand->digits[l].bones[m].next_joint, l_nextHand->digits[l].bones[m].next_joint, l_weight));
+                    }
+                }
+                f_result.m_jointError->Add(static_cast<int64_t>(l_jointError / 20.f * 1000.f));
+            }
+        }
+    }
+}
+
+void CPredictionBenchmark::ClearResults()
+{
+    for(auto &l_result : m_results)
+    {
+        delete l_result.m_palmError;
+        delete l_result.m_jointError;
+        delete l_result.m_heldError;
+        delete l_result.m_cost;
+    }
+    m_results.clear();
+}
+
+const LEAP_HAND* CPredictionBenchmark::FindHand(const LEAP_TRACKING_EVENT *f_event, uint32_t f_id)
+{
+    const LEAP_HAND *l_result = nullptr;
+    for(uint32_t i = 0U; i < f_event->nHands; i++)
+    {
+        if(f_event->pHands[i].id == f_id)
+        {
+            l_result = &f_event->pHands[i];
+            break;
+        }
+    }
+    return l_result;
+}
+
+glm::vec3 CPredictionBenchmark::Interpolate(const LEAP_VECTOR &f_before, const LEAP_VECTOR &f_after, float f_weight)
+{
+    glm::vec3 l_before, l_after;
+    ConvertVector3(f_before, l_before);
+    ConvertVector3(f_after, l_after);
+    return glm::mix(l_before, l_after, f_weight);
+}
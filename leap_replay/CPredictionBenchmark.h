@@ -0,0 +1,45 @@
+#pragma once
+
+class CFrameHistory;
+class CHistogram;
+class CLeapFrame;
+
+// Replays synthetic or recorded frames through frame history and hand extrapolation.
+// Each frame is extrapolated by horizon and scored against recorded frames at target time, held frame is scored as baseline.
+class CPredictionBenchmark final
+{
+    struct Result
+    {
+        int64_t m_horizon;
+        CHistogram *m_palmError; // Micrometers
+        CHistogram *m_jointError; // Micrometers, average over joints of hand
+        CHistogram *m_heldError; // Micrometers, newest frame without extrapolation
+        CHistogram *m_cost; // Nanoseconds
+    };
+
+    CFrameHistory *m_history;
+    CLeapFrame *m_samples;
+    CLeapFrame *m_predicted;
+    std::vector<CLeapFrame> m_frames;
+    std::vector<Result> m_results;
+    std::string m_source;
+
+    CPredictionBenchmark(const CPredictionBenchmark &that) = delete;
+    CPredictionBenchmark& operator=(const CPredictionBenchmark &that) = delete;
+
+    bool LoadFrames(const std::string &f_source);
+    void RunHorizon(Result &f_result);
+    void ClearResults();
+
+    static const LEAP_HAND* FindHand(const LEAP_TRACKING_EVENT *f_event, uint32_t f_id);
+    static glm::vec3 Interpolate(const LEAP_VECTOR &f_before, const LEAP_VECTOR &f_after, float f_weight);
+public:
+    CPredictionBenchmark();
+    ~CPredictionBenchmark();
+
+    // Source is "synthetic" or path of recording, horizons are in microseconds
+    bool Run(const std::string &f_source, const std::vector<int64_t> &f_horizons);
+
+    // Errors in millimeters and cost of history copy with extrapolation in nanoseconds for each horizon
+    void WriteSummary(std::ostream &f_stream) const;
+};
@@ -0,0 +1,96 @@
+#include "stdafx.h"
+
+#include "CSegmentBenchmark.h"
+#include "Core/CLeapFrame.h"
+#include "Core/CMappedSessionReader.h"
+#include "Core/CSessionIndex.h"
+
+CSegmentBenchmark::CSegmentBenchmark()
+{
+    m_totalTime = 0;
+}
+
+CSegmentBenchmark::~CSegmentBenchmark()
+{
+}
+
+bool CSegmentBenchmark::Run(const std::string &f_path, size_t f_count)
+{
+    bool l_result = false;
+    m_path.assign(f_path);
+    m_segments.clear();
+
+    CMappedSessionReader *l_reader = new CMappedSessionReader();
+    if(l_reader->Open(f_path))
+    {
+        // Segments start at evenly spread index entries
+        const CSessionIndex *l_index = l_reader->GetIndex();
+        const size_t l_entries = l_index->GetEntriesCount();
+        const size_t l_count = std::max(std::min(f_count, l_entries), static_cast<size_t>(1U));
+        for(size_t i = 0U; i < l_count; i++)
+        {
+            Segment l_segment = { std::numeric_limits<int64_t>::min(), 0, true, 0U, 0, 0 };
+            if(l_entries > 0U) l_segment.m_start = l_index->GetEntry(i * l_entries / l_count).m_hostTime;
+            if(i > 0U)
+            {
+                m_segments.back().m_end = l_segment.m_start;
+                m_segments.back().m_last = false;
+            }
+            m_segments.push_back(l_segment);
+        }
+        l_result = true;
+    }
+    delete l_reader;
+
+    if(l_result)
+    {
+        const auto l_start = std::chrono::steady_clock::now();
+        std::vector<std::thread*> l_threads;
+        for(size_t i = 0U; i < m_segments.size(); i++) l_threads.push_back(new std::thread(&CSegmentBenchmark::ProcessSegment, this, i));
+        for(auto l_thread : l_threads)
+        {
+            l_thread->join();
+            delete l_thread;
+        }
+        m_totalTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_start).count();
+    }
+    return l_result;
+}
+
+void CSegmentBenchmark::WriteSummary(std::ostream &f_stream) const
+{
+    uint64_t l_frames = 0U;
+    for(size_t i = 0U; i < m_segments.size(); i++)
+    {
+        const Segment &l_segment = m_segments[i];
+        f_stream << "segment " << i << " frames " << l_segment.m_framesCount << " seek_us " << l_segment.m_seekTime << " decode_us " << l_segment.m_decodeTime << '\n';
+        l_frames += l_segment.m_framesCount;
+    }
+    f_stream << "frames " << l_frames << " total_us " << m_totalTime << '\n';
+}
+
+// Called from own thread
+void CSegmentBenchmark::ProcessSegment(size_t f_index)
+{
+    Segment &l_segment = m_segments[f_index];
+    CMappedSessionReader *l_reader = new CMappedSessionReader();
+    CLeapFrame *l_frame = new CLeapFrame();
+    if(l_reader->Open(m_path))
+    {
+        const auto l_start = std::chrono::steady_clock::now();
+        const bool l_found = l_reader->Seek(l_segment.m_start, CSessionIndex::SK_HostTime);
+        const auto l_seekEnd = std::chrono::steady_clock::now();
+
+        int64_t l_hostTime = 0;
+        while(l_found && l_reader->Read(*l_frame, l_hostTime))
+        {
+            if(!l_segment.m_last && (l_hostTime >= l_segment.m_end)) break;
+            l_segment.m_framesCount++;
+        }
+        const auto l_end = std::chrono::steady_clock::now();
+        l_segment.m_seekTime = std::chrono::duration_cast<std::chrono::microseconds>(l_seekEnd - l_start).count();
+        l_segment.m_decodeTime = std::chrono::duration_cast<std::chrono::microseconds>(l_end - l_seekEnd).count();
+    }
+    delete l_frame;
+    delete l_reader;
+}
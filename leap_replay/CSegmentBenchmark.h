@@ -0,0 +1,32 @@
+#pragma once
+
+// Splits recording by index into segments that are decoded in parallel by own mapped readers
+class CSegmentBenchmark final
+{
+    struct Segment
+    {
+        int64_t m_start;
+        int64_t m_end;
+        bool m_last;
+        uint64_t m_framesCount;
+        int64_t m_seekTime;
+        int64_t m_decodeTime;
+    };
+
+    std::string m_path;
+    std::vector<Segment> m_segments;
+    int64_t m_totalTime;
+
+    CSegmentBenchmark(const CSegmentBenchmark &that) = delete;
+    CSegmentBenchmark& operator=(const CSegmentBenchmark &that) = delete;
+
+    void ProcessSegment(size_t f_index);
+public:
+    CSegmentBenchmark();
+    ~CSegmentBenchmark();
+
+    bool Run(const std::string &f_path, size_t f_count);
+
+    // Frames, seek and decode time in microseconds per segment
+    void WriteSummary(std::ostream &f_stream) const;
+};
@@ -0,0 +1,136 @@
+#include "stdafx.h"
+
+// LeapC runtime isn't available on Linux, service and recordings are reported as absent and only clock functions work
+
+int64_t LEAP_CALL LeapGetNow(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+eLeapRS LEAP_CALL LeapCreateConnection(const LEAP_CONNECTION_CONFIG* /* pConfig */, LEAP_CONNECTION* phConnection)
+{
+    if(phConnection) *phConnection = nullptr;
+    return eLeapRS_NotAvailable;
+}
+
+eLeapRS LEAP_CALL LeapOpenConnection(LEAP_CONNECTION /* hConnection */)
+{
+    return eLeapRS_NotAvailable;
+}
+
+void LEAP_CALL LeapCloseConnection(LEAP_CONNECTION /* hConnection */)
+{
+}
+
+void LEAP_CALL LeapDestroyConnection(LEAP_CONNECTION /* hConnection */)
+{
+}
+
+eLeapRS LEAP_CALL LeapSetAllocator(LEAP_CONNECTION /* hConnection */, const LEAP_ALLOCATOR* /* allocator */)
+{
+    return eLeapRS_NotConnected;
+}
+
+eLeapRS LEAP_CALL LeapSetPolicyFlags(LEAP_CONNECTION /* hConnection */, uint64_t /* set */, uint64_t /* clear */)
+{
+    return eLeapRS_NotConnected;
+}
+
+eLeapRS LEAP_CALL LeapSetPause(LEAP_CONNECTION /* hConnection */, bool /* pause */)
+{
+    return eLeapRS_NotConnected;
+}
+
+eLeapRS LEAP_CALL LeapPollConnection(LEAP_CONNECTION /* hConnection */, uint32_t /* timeout */, LEAP_CONNECTION_MESSAGE* /* evt */)
+{
+    return eLeapRS_NotConnected;
+}
+
+eLeapRS LEAP_CALL LeapGetDeviceList(LEAP_CONNECTION /* hConnection */, LEAP_DEVICE_REF* /* pArray */, uint32_t* pnArray)
+{
+    if(pnArray) *pnArray = 0U;
+    return eLeapRS_NotConnected;
+}
+
+eLeapRS LEAP_CALL LeapOpenDevice(LEAP_DEVICE_REF /* rDevice */, LEAP_DEVICE* phDevice)
+{
+    if(phDevice) *phDevice = nullptr;
+    return eLeapRS_NotConnected;
+}
+
+void LEAP_CALL LeapCloseDevice(LEAP_DEVICE /* hDevice */)
+{
+}
+
+eLeapRS LEAP_CALL LeapGetFrameSize(LEAP_CONNECTION /* hConnection */, int64_t /* timestamp */, uint64_t* /* pncbEvent */)
+{
+    return eLeapRS_NotConnected;
+}
+
+eLeapRS LEAP_CALL LeapInterpolateFrame(LEAP_CONNECTION /* hConnection */, int64_t /* timestamp */, LEAP_TRACKING_EVENT* /* pEvent */, uint64_t /* ncbEvent */)
+{
+    return eLeapRS_NotConnected;
+}
+
+eLeapRS LEAP_CALL LeapInterpolateFrameFromTime(LEAP_CONNECTION /* hConnection */, int64_t /* timestamp */, int64_t /* sourceTimestamp */, LEAP_TRACKING_EVENT* /* pEvent */, uint64_t /* ncbEvent */)
+{
+    return eLeapRS_NotConnected;
+}
+
+// Both clocks are steady clock, rebasing is identity
+eLeapRS LEAP_CALL LeapCreateClockRebaser(LEAP_CLOCK_REBASER* phClockRebaser)
+{
+    if(phClockRebaser) *phClockRebaser = nullptr;
+    return eLeapRS_Success;
+}
+
+eLeapRS LEAP_CALL LeapUpdateRebase(LEAP_CLOCK_REBASER /* hClockRebaser */, int64_t /* userClock */, int64_t /* leapClock */)
+{
+    return eLeapRS_Success;
+}
+
+eLeapRS LEAP_CALL LeapRebaseClock(LEAP_CLOCK_REBASER /* hClockRebaser */, int64_t userClock, int64_t* pLeapClock)
+{
+    if(pLeapClock) *pLeapClock = userClock;
+    return eLeapRS_Success;
+}
+
+void LEAP_CALL LeapDestroyClockRebaser(LEAP_CLOCK_REBASER /* hClockRebaser */)
+{
+}
+
+// LeapC recording format is private to runtime, .lmt files can't be opened
+eLeapRS LEAP_CALL LeapRecordingOpen(LEAP_RECORDING* ppRecording, const char* /* filePath */, LEAP_RECORDING_PARAMETERS /* params */)
+{
+    if(ppRecording) *ppRecording = nullptr;
+    return eLeapRS_NotAvailable;
+}
+
+eLeapRS LEAP_CALL LeapRecordingClose(LEAP_RECORDING* ppRecording)
+{
+    if(ppRecording) *ppRecording = nullptr;
+    return eLeapRS_Success;
+}
+
+eLeapRS LEAP_CALL LeapRecordingGetStatus(LEAP_RECORDING /* pRecording */, LEAP_RECORDING_STATUS* pstatus)
+{
+    if(pstatus) pstatus->mode = eLeapRecordingFlags_Error;
+    return eLeapRS_NotAvailable;
+}
+
+eLeapRS LEAP_CALL LeapRecordingReadSize(LEAP_RECORDING /* pRecording */, uint64_t* pncbEvent)
+{
+    if(pncbEvent) *pncbEvent = 0U;
+    return eLeapRS_NotAvailable;
+}
+
+eLeapRS LEAP_CALL LeapRecordingRead(LEAP_RECORDING /* pRecording */, LEAP_TRACKING_EVENT* /* pEvent */, uint64_t /* ncbEvent */)
+{
+    return eLeapRS_NotAvailable;
+}
+
+eLeapRS LEAP_CALL LeapRecordingWrite(LEAP_RECORDING /* pRecording */, LEAP_TRACKING_EVENT* /* pEvent */, uint64_t* pnBytesWritten)
+{
+    if(pnBytesWritten) *pnBytesWritten = 0U;
+    return eLeapRS_NotAvailable;
+}
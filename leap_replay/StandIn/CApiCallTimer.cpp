@@ -0,0 +1,26 @@
+#include "stdafx.h"
+
+#include "StandIn/CApiCallTimer.h"
+#include "StandIn/CApiStatistics.h"
+
+CApiCallTimer::CApiCallTimer(CApiStatistics *f_statistics, size_t f_call, size_t f_payload)
+{
+    m_statistics = f_statistics;
+    m_call = f_call;
+    m_statistics->AddCall(m_call, f_payload);
+    m_start = std::chrono::steady_clock::now();
+}
+
+CApiCallTimer::~CApiCallTimer()
+{
+    // Busy wait, sleep resolution is far above latency of single call
+    const std::chrono::nanoseconds l_latency(m_statistics->GetLatency(m_call));
+    std::chrono::steady_clock::time_point l_end = std::chrono::steady_clock::now();
+    while((l_end - m_start) < l_latency) l_end = std::chrono::steady_clock::now();
+    m_statistics->AddTime(m_call, std::chrono::duration_cast<std::chrono::nanoseconds>(l_end - m_start).count());
+}
+
+void CApiCallTimer::AddPayload(size_t f_payload)
+{
+    m_statistics->AddPayload(m_call, f_payload);
+}
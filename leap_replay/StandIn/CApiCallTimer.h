@@ -0,0 +1,20 @@
+#pragma once
+
+class CApiStatistics;
+
+// Records call of stand-in interface on construction, holds scope for synthetic latency and adds time spent in it on destruction
+class CApiCallTimer final
+{
+    CApiStatistics *m_statistics;
+    size_t m_call;
+    std::chrono::steady_clock::time_point m_start;
+
+    CApiCallTimer(const CApiCallTimer &that) = delete;
+    CApiCallTimer& operator=(const CApiCallTimer &that) = delete;
+public:
+    CApiCallTimer(CApiStatistics *f_statistics, size_t f_call, size_t f_payload);
+    ~CApiCallTimer();
+
+    // For payload known only after call processing
+    void AddPayload(size_t f_payload);
+};
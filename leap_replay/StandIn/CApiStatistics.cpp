@@ -0,0 +1,91 @@
+#include "stdafx.h"
+
+#include "StandIn/CApiStatistics.h"
+
+const char* const g_callNames[]
+{
+    "GetGenericInterface", "GetDriverHandle",
+    "TrackedDeviceAdded", "TrackedDevicePoseUpdated", "VsyncEvent", "VendorSpecificEvent", "IsExiting", "PollNextEvent", "GetRawTrackedDevicePoses",
+    "TrackedDeviceDisplayTransformUpdated", "RequestRestart", "GetFrameTimings", "SetDisplayEyeToHead", "SetDisplayProjectionRaw", "SetRecommendedRenderTargetSize",
+    "ReadPropertyBatch", "WritePropertyBatch", "GetPropErrorNameFromEnum", "TrackedDeviceToPropertyContainer",
+    "CreateBooleanComponent", "UpdateBooleanComponent", "CreateScalarComponent", "UpdateScalarComponent", "CreateHapticComponent", "CreateSkeletonComponent", "UpdateSkeletonComponent"
+};
+
+CApiStatistics::CApiStatistics()
+{
+    for(size_t i = 0U; i < AC_Count; i++) m_latencies[i] = 0;
+    Reset();
+}
+
+CApiStatistics::~CApiStatistics()
+{
+}
+
+void CApiStatistics::SetLatency(size_t f_call, int64_t f_latency)
+{
+    if(f_call < AC_Count) m_latencies[f_call] = std::max(f_latency, static_cast<int64_t>(0));
+}
+
+void CApiStatistics::SetLatency(int64_t f_latency)
+{
+    for(size_t i = 0U; i < AC_Count; i++) SetLatency(i, f_latency);
+}
+
+int64_t CApiStatistics::GetLatency(size_t f_call) const
+{
+    return ((f_call < AC_Count) ? m_latencies[f_call] : 0);
+}
+
+void CApiStatistics::AddCall(size_t f_call, size_t f_payload)
+{
+    if(f_call < AC_Count)
+    {
+        m_counts[f_call]++;
+        m_payloads[f_call] += f_payload;
+    }
+}
+
+void CApiStatistics::AddPayload(size_t f_call, size_t f_payload)
+{
+    if(f_call < AC_Count) m_payloads[f_call] += f_payload;
+}
+
+void CApiStatistics::AddTime(size_t f_call, int64_t f_time)
+{
+    if(f_call < AC_Count) m_times[f_call] += f_time;
+}
+
+void CApiStatistics::Reset()
+{
+    for(size_t i = 0U; i < AC_Count; i++)
+    {
+        m_counts[i] = 0U;
+        m_payloads[i] = 0U;
+        m_times[i] = 0;
+    }
+}
+
+uint64_t CApiStatistics::GetCallsCount(size_t f_call) const
+{
+    return ((f_call < AC_Count) ? m_counts[f_call] : 0U);
+}
+
+uint64_t CApiStatistics::GetPayloadSize(size_t f_call) const
+{
+    return ((f_call < AC_Count) ? m_payloads[f_call] : 0U);
+}
+
+int64_t CApiStatistics::GetCallsTime(size_t f_call) const
+{
+    return ((f_call < AC_Count) ? m_times[f_call] : 0);
+}
+
+const char* CApiStatistics::GetCallName(size_t f_call)
+{
+    return ((f_call < AC_Count) ? g_callNames[f_call] : "unknown");
+}
+
+size_t CApiStatistics::GetStringSize(const char *f_string)
+{
+    return (f_string ? (std::strlen(f_string) + 1U) : 0U);
+}
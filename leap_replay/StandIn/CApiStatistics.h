@@ -0,0 +1,77 @@
+#pragma once
+
+// Calls of OpenVR driver interfaces made by driver to stand-in interfaces: count, argument payload and time spent in call.
+// Calls can be delayed by synthetic latency to model cost of vrserver side. Accessed from driver frame thread only.
+class CApiStatistics final
+{
+public:
+    enum ApiCall : size_t
+    {
+        // vr::IVRDriverContext
+        AC_GetGenericInterface = 0U,
+        AC_GetDriverHandle,
+
+        // vr::IVRServerDriverHost
+        AC_TrackedDeviceAdded,
+        AC_TrackedDevicePoseUpdated,
+        AC_VsyncEvent,
+        AC_VendorSpecificEvent,
+        AC_IsExiting,
+        AC_PollNextEvent,
+        AC_GetRawTrackedDevicePoses,
+        AC_TrackedDeviceDisplayTransformUpdated,
+        AC_RequestRestart,
+        AC_GetFrameTimings,
+        AC_SetDisplayEyeToHead,
+        AC_SetDisplayProjectionRaw,
+        AC_SetRecommendedRenderTargetSize,
+
+        // vr::IVRProperties
+        AC_ReadPropertyBatch,
+        AC_WritePropertyBatch,
+        AC_GetPropErrorNameFromEnum,
+        AC_TrackedDeviceToPropertyContainer,
+
+        // vr::IVRDriverInput
+        AC_CreateBooleanComponent,
+        AC_UpdateBooleanComponent,
+        AC_CreateScalarComponent,
+        AC_UpdateScalarComponent,
+        AC_CreateHapticComponent,
+        AC_CreateSkeletonComponent,
+        AC_UpdateSkeletonComponent,
+
+        AC_Count
+    };
+private:
+    uint64_t m_counts[AC_Count];
+    uint64_t m_payloads[AC_Count];
+    int64_t m_times[AC_Count];
+    int64_t m_latencies[AC_Count];
+
+    CApiStatistics(const CApiStatistics &that) = delete;
+    CApiStatistics& operator=(const CApiStatistics &that) = delete;
+public:
+    CApiStatistics();
+    ~CApiStatistics();
+
+    // Latency is in nanoseconds, it's applied to call and isn't reset
+    void SetLatency(size_t f_call, int64_t f_latency);
+    void SetLatency(int64_t f_latency);
+    int64_t GetLatency(size_t f_call) const;
+
+    void AddCall(size_t f_call, size_t f_payload);
+    void AddPayload(size_t f_call, size_t f_payload);
+    void AddTime(size_t f_call, int64_t f_time);
+    void Reset();
+
+    uint64_t GetCallsCount(size_t f_call) const;
+    // Bytes of data passed by value or pointer, handles and indices excluded
+    uint64_t GetPayloadSize(size_t f_call) const;
+    // Nanoseconds spent in calls, including latency and nested calls of driver
+    int64_t GetCallsTime(size_t f_call) const;
+
+    static const char* GetCallName(size_t f_call);
+    // Length with terminator, zero for nullptr
+    static size_t GetStringSize(const char *f_string);
+};
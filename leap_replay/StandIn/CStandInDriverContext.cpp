@@ -0,0 +1,75 @@
+#include "stdafx.h"
+
+#include "StandIn/CStandInDriverContext.h"
+#include "StandIn/CApiCallTimer.h"
+#include "StandIn/CApiStatistics.h"
+#include "StandIn/CStandInDriverInput.h"
+#include "StandIn/CStandInProperties.h"
+#include "StandIn/CStandInServerDriverHost.h"
+
+CStandInDriverContext::CStandInDriverContext()
+{
+    m_statistics = new CApiStatistics();
+    m_serverDriverHost = new CStandInServerDriverHost(m_statistics);
+    m_driverInput = new CStandInDriverInput(m_statistics);
+    m_properties = new CStandInProperties(m_statistics);
+
+    // HMD display timing read by driver
+    const vr::PropertyContainerHandle_t l_hmdContainer = m_properties->TrackedDeviceToPropertyContainer(vr::k_unTrackedDeviceIndex_Hmd);
+    m_properties->SetFloat(l_hmdContainer, vr::Prop_DisplayFrequency_Float, 90.f);
+    m_properties->SetFloat(l_hmdContainer, vr::Prop_SecondsFromVsyncToPhotons_Float, 0.011f);
+    m_statistics->Reset();
+}
+
+CStandInDriverContext::~CStandInDriverContext()
+{
+    delete m_serverDriverHost;
+    delete m_driverInput;
+    delete m_properties;
+    delete m_statistics;
+}
+
+void CStandInDriverContext::SetOutput(std::ostream *f_output)
+{
+    m_serverDriverHost->SetOutput(f_output);
+    m_driverInput->SetOutput(f_output);
+    m_properties->SetOutput(f_output);
+}
+
+CStandInServerDriverHost* CStandInDriverContext::GetServerDriverHost() const
+{
+    return m_serverDriverHost;
+}
+
+CStandInDriverInput* CStandInDriverContext::GetDriverInput() const
+{
+    return m_driverInput;
+}
+
+CStandInProperties* CStandInDriverContext::GetProperties() const
+{
+    return m_properties;
+}
+
+CApiStatistics* CStandInDriverContext::GetStatistics() const
+{
+    return m_statistics;
+}
+
+void* CStandInDriverContext::GetGenericInterface(const char *pchInterfaceVersion, vr::EVRInitError *peError)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_GetGenericInterface, CApiStatistics::GetStringSize(pchInterfaceVersion));
+    void *l_result = nullptr;
+    if(!strcmp(pchInterfaceVersion, vr::IVRServerDriverHost_Version)) l_result = dynamic_cast<vr::IVRServerDriverHost*>(m_serverDriverHost);
+    else if(!strcmp(pchInterfaceVersion, vr::IVRDriverInput_Version)) l_result = dynamic_cast<vr::IVRDriverInput*>(m_driverInput);
+    else if(!strcmp(pchInterfaceVersion, vr::IVRProperties_Version)) l_result = dynamic_cast<vr::IVRProperties*>(m_properties);
+
+    if(peError) *peError = (l_result ? vr::VRInitError_None : vr::VRInitError_Init_InterfaceNotFound);
+    return l_result;
+}
+
+vr::DriverHandle_t CStandInDriverContext::GetDriverHandle()
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_GetDriverHandle, 0U);
+    return 1U;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+class CApiStatistics;
+class CStandInDriverInput;
+class CStandInProperties;
+class CStandInServerDriverHost;
+
+// Driver context that hands out stand-in server interfaces in place of vrserver
+class CStandInDriverContext final : public vr::IVRDriverContext
+{
+    CStandInServerDriverHost *m_serverDriverHost;
+    CStandInDriverInput *m_driverInput;
+    CStandInProperties *m_properties;
+    CApiStatistics *m_statistics;
+
+    CStandInDriverContext(const CStandInDriverContext &that) = delete;
+    CStandInDriverContext& operator=(const CStandInDriverContext &that) = delete;
+public:
+    CStandInDriverContext();
+    ~CStandInDriverContext();
+
+    // Captures all device, pose, input and property output of driver
+    void SetOutput(std::ostream *f_output);
+
+    CStandInServerDriverHost* GetServerDriverHost() const;
+    CStandInDriverInput* GetDriverInput() const;
+    CStandInProperties* GetProperties() const;
+    // Calls of all stand-in interfaces made since creation or last reset
+    CApiStatistics* GetStatistics() const;
+
+    // vr::IVRDriverContext
+    void* GetGenericInterface(const char *pchInterfaceVersion, vr::EVRInitError *peError);
+    vr::DriverHandle_t GetDriverHandle();
+};
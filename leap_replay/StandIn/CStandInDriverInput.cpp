@@ -0,0 +1,132 @@
+#include "stdafx.h"
+
+#include "StandIn/CStandInDriverInput.h"
+#include "StandIn/CApiCallTimer.h"
+#include "StandIn/CApiStatistics.h"
+
+CStandInDriverInput::CStandInDriverInput(CApiStatistics *f_statistics)
+{
+    m_output = nullptr;
+    m_statistics = f_statistics;
+}
+
+CStandInDriverInput::~CStandInDriverInput()
+{
+}
+
+void CStandInDriverInput::SetOutput(std::ostream *f_output)
+{
+    m_output = f_output;
+}
+
+size_t CStandInDriverInput::GetComponentsCount() const
+{
+    return m_components.size();
+}
+
+vr::PropertyContainerHandle_t CStandInDriverInput::GetComponentContainer(size_t f_index) const
+{
+    return m_components[f_index].m_container;
+}
+
+const std::string& CStandInDriverInput::GetComponentPath(size_t f_index) const
+{
+    return m_components[f_index].m_path;
+}
+
+unsigned char CStandInDriverInput::GetComponentType(size_t f_index) const
+{
+    return m_components[f_index].m_type;
+}
+
+float CStandInDriverInput::GetComponentValue(size_t f_index) const
+{
+    return m_components[f_index].m_value;
+}
+
+vr::EVRInputError CStandInDriverInput::CreateBooleanComponent(vr::PropertyContainerHandle_t ulContainer, const char *pchName, vr::VRInputComponentHandle_t *pHandle)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_CreateBooleanComponent, CApiStatistics::GetStringSize(pchName));
+    *pHandle = AddComponent(ulContainer, pchName, CT_Boolean);
+    return vr::VRInputError_None;
+}
+
+vr::EVRInputError CStandInDriverInput::UpdateBooleanComponent(vr::VRInputComponentHandle_t ulComponent, bool bNewValue, double /* fTimeOffset */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_UpdateBooleanComponent, sizeof(bool) + sizeof(double));
+    SetComponentValue(ulComponent, bNewValue ? 1.f : 0.f);
+    if(m_output) *m_output << "boolean " << GetComponentName(ulComponent) << ' ' << bNewValue << '\n';
+    return vr::VRInputError_None;
+}
+
+vr::EVRInputError CStandInDriverInput::CreateScalarComponent(vr::PropertyContainerHandle_t ulContainer, const char *pchName, vr::VRInputComponentHandle_t *pHandle, vr::EVRScalarType /* eType */, vr::EVRScalarUnits /* eUnits */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_CreateScalarComponent, CApiStatistics::GetStringSize(pchName) + sizeof(vr::EVRScalarType) + sizeof(vr::EVRScalarUnits));
+    *pHandle = AddComponent(ulContainer, pchName, CT_Scalar);
+    return vr::VRInputError_None;
+}
+
+vr::EVRInputError CStandInDriverInput::UpdateScalarComponent(vr::VRInputComponentHandle_t ulComponent, float fNewValue, double /* fTimeOffset */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_UpdateScalarComponent, sizeof(float) + sizeof(double));
+    SetComponentValue(ulComponent, fNewValue);
+    if(m_output) *m_output << "scalar " << GetComponentName(ulComponent) << ' ' << fNewValue << '\n';
+    return vr::VRInputError_None;
+}
+
+vr::EVRInputError CStandInDriverInput::CreateHapticComponent(vr::PropertyContainerHandle_t ulContainer, const char *pchName, vr::VRInputComponentHandle_t *pHandle)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_CreateHapticComponent, CApiStatistics::GetStringSize(pchName));
+    *pHandle = AddComponent(ulContainer, pchName, CT_Haptic);
+    return vr::VRInputError_None;
+}
+
+vr::EVRInputError CStandInDriverInput::CreateSkeletonComponent(vr::PropertyContainerHandle_t ulContainer, const char *pchName, const char *pchSkeletonPath, const char *pchBasePosePath, vr::EVRSkeletalTrackingLevel /* eSkeletalTrackingLevel */, const vr::VRBoneTransform_t* /* pGripLimitTransforms */, uint32_t unGripLimitTransformCount, vr::VRInputComponentHandle_t *pHandle)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_CreateSkeletonComponent, CApiStatistics::GetStringSize(pchName) + CApiStatistics::GetStringSize(pchSkeletonPath) + CApiStatistics::GetStringSize(pchBasePosePath) + sizeof(vr::EVRSkeletalTrackingLevel) + unGripLimitTransformCount * sizeof(vr::VRBoneTransform_t));
+    *pHandle = AddComponent(ulContainer, pchName, CT_Skeleton);
+    return vr::VRInputError_None;
+}
+
+vr::EVRInputError CStandInDriverInput::UpdateSkeletonComponent(vr::VRInputComponentHandle_t ulComponent, vr::EVRSkeletalMotionRange eMotionRange, const vr::VRBoneTransform_t *pTransforms, uint32_t unTransformCount)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_UpdateSkeletonComponent, sizeof(vr::EVRSkeletalMotionRange) + unTransformCount * sizeof(vr::VRBoneTransform_t));
+    if(m_output)
+    {
+        std::ostream &l_output = *m_output;
+        l_output << "skeleton " << GetComponentName(ulComponent) << ' ' << static_cast<int>(eMotionRange);
+        for(uint32_t i = 0U; i < unTransformCount; i++)
+        {
+            const vr::VRBoneTransform_t &l_bone = pTransforms[i];
+            l_output << ' ' << l_bone.position.v[0] << ' ' << l_bone.position.v[1] << ' ' << l_bone.position.v[2];
+            l_output << ' ' << l_bone.orientation.w << ' ' << l_bone.orientation.x << ' ' << l_bone.orientation.y << ' ' << l_bone.orientation.z;
+        }
+        l_output << '\n';
+    }
+    return vr::VRInputError_None;
+}
+
+vr::VRInputComponentHandle_t CStandInDriverInput::AddComponent(vr::PropertyContainerHandle_t f_container, const char *f_name, unsigned char f_type)
+{
+    Component l_component;
+    l_component.m_container = f_container;
+    l_component.m_path.assign(f_name);
+    l_component.m_name.assign(std::to_string(f_container));
+    l_component.m_name.push_back(':');
+    l_component.m_name.append(f_name);
+    l_component.m_type = f_type;
+    l_component.m_value = 0.f;
+    m_components.push_back(l_component);
+    return static_cast<vr::VRInputComponentHandle_t>(m_components.size());
+}
+
+const std::string& CStandInDriverInput::GetComponentName(vr::VRInputComponentHandle_t f_handle) const
+{
+    static const std::string ls_invalid("invalid");
+    return (((f_handle > 0U) && (f_handle <= m_components.size())) ? m_components[static_cast<size_t>(f_handle - 1U)].m_name : ls_invalid);
+}
+
+void CStandInDriverInput::SetComponentValue(vr::VRInputComponentHandle_t f_handle, float f_value)
+{
+    if((f_handle > 0U) && (f_handle <= m_components.size())) m_components[static_cast<size_t>(f_handle - 1U)].m_value = f_value;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+class CApiStatistics;
+
+// Input components of stand-in server, every update is captured by component name and last values are kept
+class CStandInDriverInput final : public vr::IVRDriverInput
+{
+public:
+    enum ComponentType : unsigned char
+    {
+        CT_Boolean = 0U,
+        CT_Scalar,
+        CT_Haptic,
+        CT_Skeleton
+    };
+private:
+    struct Component
+    {
+        vr::PropertyContainerHandle_t m_container;
+        std::string m_path;
+        std::string m_name; // Container and path
+        unsigned char m_type;
+        float m_value;
+    };
+
+    std::vector<Component> m_components; // Handle is index plus one
+    std::ostream *m_output;
+    CApiStatistics *m_statistics;
+
+    CStandInDriverInput(const CStandInDriverInput &that) = delete;
+    CStandInDriverInput& operator=(const CStandInDriverInput &that) = delete;
+
+    vr::VRInputComponentHandle_t AddComponent(vr::PropertyContainerHandle_t f_container, const char *f_name, unsigned char f_type);
+    const std::string& GetComponentName(vr::VRInputComponentHandle_t f_handle) const;
+    void SetComponentValue(vr::VRInputComponentHandle_t f_handle, float f_value);
+public:
+    explicit CStandInDriverInput(CApiStatistics *f_statistics);
+    ~CStandInDriverInput();
+
+    void SetOutput(std::ostream *f_output);
+    size_t GetComponentsCount() const;
+
+    // Components are accessed by index in order of creation
+    vr::PropertyContainerHandle_t GetComponentContainer(size_t f_index) const;
+    const std::string& GetComponentPath(size_t f_index) const;
+    unsigned char GetComponentType(size_t f_index) const;
+    // Last value of boolean or scalar component, zero before first update
+    float GetComponentValue(size_t f_index) const;
+
+    // vr::IVRDriverInput
+    vr::EVRInputError CreateBooleanComponent(vr::PropertyContainerHandle_t ulContainer, const char *pchName, vr::VRInputComponentHandle_t *pHandle);
+    vr::EVRInputError UpdateBooleanComponent(vr::VRInputComponentHandle_t ulComponent, bool bNewValue, double fTimeOffset);
+    vr::EVRInputError CreateScalarComponent(vr::PropertyContainerHandle_t ulContainer, const char *pchName, vr::VRInputComponentHandle_t *pHandle, vr::EVRScalarType eType, vr::EVRScalarUnits eUnits);
+    vr::EVRInputError UpdateScalarComponent(vr::VRInputComponentHandle_t ulComponent, float fNewValue, double fTimeOffset);
+    vr::EVRInputError CreateHapticComponent(vr::PropertyContainerHandle_t ulContainer, const char *pchName, vr::VRInputComponentHandle_t *pHandle);
+    vr::EVRInputError CreateSkeletonComponent(vr::PropertyContainerHandle_t ulContainer, const char *pchName, const char *pchSkeletonPath, const char *pchBasePosePath, vr::EVRSkeletalTrackingLevel eSkeletalTrackingLevel, const vr::VRBoneTransform_t *pGripLimitTransforms, uint32_t unGripLimitTransformCount, vr::VRInputComponentHandle_t *pHandle);
+    vr::EVRInputError UpdateSkeletonComponent(vr::VRInputComponentHandle_t ulComponent, vr::EVRSkeletalMotionRange eMotionRange, const vr::VRBoneTransform_t *pTransforms, uint32_t unTransformCount);
+};
@@ -0,0 +1,129 @@
+#include "stdafx.h"
+
+#include "StandIn/CStandInProperties.h"
+#include "StandIn/CApiCallTimer.h"
+#include "StandIn/CApiStatistics.h"
+
+CStandInProperties::CStandInProperties(CApiStatistics *f_statistics)
+{
+    m_output = nullptr;
+    m_statistics = f_statistics;
+}
+
+CStandInProperties::~CStandInProperties()
+{
+}
+
+void CStandInProperties::SetOutput(std::ostream *f_output)
+{
+    m_output = f_output;
+}
+
+void CStandInProperties::SetFloat(vr::PropertyContainerHandle_t f_container, vr::ETrackedDeviceProperty f_property, float f_value)
+{
+    PropertyValue &l_value = m_values[std::make_pair(f_container, static_cast<int>(f_property))];
+    l_value.m_tag = vr::k_unFloatPropertyTag;
+    l_value.m_data.resize(sizeof(float));
+    std::memcpy(l_value.m_data.data(), &f_value, sizeof(float));
+}
+
+vr::ETrackedPropertyError CStandInProperties::ReadPropertyBatch(vr::PropertyContainerHandle_t ulContainerHandle, vr::PropertyRead_t *pBatch, uint32_t unBatchEntryCount)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_ReadPropertyBatch, unBatchEntryCount * sizeof(vr::PropertyRead_t));
+    for(uint32_t i = 0U; i < unBatchEntryCount; i++)
+    {
+        vr::PropertyRead_t &l_read = pBatch[i];
+        l_timer.AddPayload(l_read.unBufferSize);
+        auto l_iter = m_values.find(std::make_pair(ulContainerHandle, static_cast<int>(l_read.prop)));
+        if(l_iter != m_values.end())
+        {
+            const PropertyValue &l_value = l_iter->second;
+            l_read.unTag = l_value.m_tag;
+            l_read.unRequiredBufferSize = static_cast<uint32_t>(l_value.m_data.size());
+            if(l_read.unBufferSize >= l_read.unRequiredBufferSize)
+            {
+                if(!l_value.m_data.empty()) std::memcpy(l_read.pvBuffer, l_value.m_data.data(), l_value.m_data.size());
+                l_read.eError = vr::TrackedProp_Success;
+            }
+            else l_read.eError = vr::TrackedProp_BufferTooSmall;
+        }
+        else
+        {
+            l_read.unTag = vr::k_unInvalidPropertyTag;
+            l_read.unRequiredBufferSize = 0U;
+            l_read.eError = vr::TrackedProp_UnknownProperty;
+        }
+    }
+    return vr::TrackedProp_Success;
+}
+
+vr::ETrackedPropertyError CStandInProperties::WritePropertyBatch(vr::PropertyContainerHandle_t ulContainerHandle, vr::PropertyWrite_t *pBatch, uint32_t unBatchEntryCount)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_WritePropertyBatch, unBatchEntryCount * sizeof(vr::PropertyWrite_t));
+    for(uint32_t i = 0U; i < unBatchEntryCount; i++)
+    {
+        vr::PropertyWrite_t &l_write = pBatch[i];
+        l_timer.AddPayload(l_write.unBufferSize);
+        const auto l_key = std::make_pair(ulContainerHandle, static_cast<int>(l_write.prop));
+        switch(l_write.writeType)
+        {
+            case vr::PropertyWrite_Set:
+            {
+                PropertyValue &l_value = m_values[l_key];
+                l_value.m_tag = l_write.unTag;
+                l_value.m_data.assign(reinterpret_cast<const uint8_t*>(l_write.pvBuffer), reinterpret_cast<const uint8_t*>(l_write.pvBuffer) + l_write.unBufferSize);
+                WriteValue(ulContainerHandle, l_write);
+            } break;
+            case vr::PropertyWrite_Erase:
+                m_values.erase(l_key);
+                break;
+            default:
+                break;
+        }
+        l_write.eError = vr::TrackedProp_Success;
+    }
+    return vr::TrackedProp_Success;
+}
+
+const char* CStandInProperties::GetPropErrorNameFromEnum(vr::ETrackedPropertyError error)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_GetPropErrorNameFromEnum, sizeof(vr::ETrackedPropertyError));
+    return ((error == vr::TrackedProp_Success) ? "TrackedProp_Success" : "TrackedProp_Error");
+}
+
+vr::PropertyContainerHandle_t CStandInProperties::TrackedDeviceToPropertyContainer(vr::TrackedDeviceIndex_t nDevice)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_TrackedDeviceToPropertyContainer, 0U);
+    return (static_cast<vr::PropertyContainerHandle_t>(nDevice) + 1U);
+}
+
+void CStandInProperties::WriteValue(vr::PropertyContainerHandle_t f_container, const vr::PropertyWrite_t &f_write)
+{
+    if(m_output)
+    {
+        std::ostream &l_output = *m_output;
+        l_output << "property " << f_container << ' ' << static_cast<int>(f_write.prop) << ' ';
+        switch(f_write.unTag)
+        {
+            case vr::k_unFloatPropertyTag:
+                l_output << *reinterpret_cast<const float*>(f_write.pvBuffer);
+                break;
+            case vr::k_unInt32PropertyTag:
+                l_output << *reinterpret_cast<const int32_t*>(f_write.pvBuffer);
+                break;
+            case vr::k_unUint64PropertyTag:
+                l_output << *reinterpret_cast<const uint64_t*>(f_write.pvBuffer);
+                break;
+            case vr::k_unBoolPropertyTag:
+                l_output << *reinterpret_cast<const bool*>(f_write.pvBuffer);
+                break;
+            case vr::k_unStringPropertyTag:
+                l_output << std::string(reinterpret_cast<const char*>(f_write.pvBuffer), strnlen(reinterpret_cast<const char*>(f_write.pvBuffer), f_write.unBufferSize));
+                break;
+            default:
+                l_output << "tag" << f_write.unTag << ' ' << f_write.unBufferSize;
+                break;
+        }
+        l_output << '\n';
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+class CApiStatistics;
+
+// Property store of stand-in server, device containers are device index plus one
+class CStandInProperties final : public vr::IVRProperties
+{
+    struct PropertyValue
+    {
+        vr::PropertyTypeTag_t m_tag;
+        std::vector<uint8_t> m_data;
+    };
+
+    std::map<std::pair<vr::PropertyContainerHandle_t, int>, PropertyValue> m_values;
+    std::ostream *m_output;
+    CApiStatistics *m_statistics;
+
+    CStandInProperties(const CStandInProperties &that) = delete;
+    CStandInProperties& operator=(const CStandInProperties &that) = delete;
+
+    void WriteValue(vr::PropertyContainerHandle_t f_container, const vr::PropertyWrite_t &f_write);
+public:
+    explicit CStandInProperties(CApiStatistics *f_statistics);
+    ~CStandInProperties();
+
+    // Captured writes are printed if output is set
+    void SetOutput(std::ostream *f_output);
+    void SetFloat(vr::PropertyContainerHandle_t f_container, vr::ETrackedDeviceProperty f_property, float f_value);
+
+    // vr::IVRProperties
+    vr::ETrackedPropertyError ReadPropertyBatch(vr::PropertyContainerHandle_t ulContainerHandle, vr::PropertyRead_t *pBatch, uint32_t unBatchEntryCount);
+    vr::ETrackedPropertyError WritePropertyBatch(vr::PropertyContainerHandle_t ulContainerHandle, vr::PropertyWrite_t *pBatch, uint32_t unBatchEntryCount);
+    const char* GetPropErrorNameFromEnum(vr::ETrackedPropertyError error);
+    vr::PropertyContainerHandle_t TrackedDeviceToPropertyContainer(vr::TrackedDeviceIndex_t nDevice);
+};
@@ -0,0 +1,176 @@
+#include "stdafx.h"
+
+#include "StandIn/CStandInServerDriverHost.h"
+#include "StandIn/CApiCallTimer.h"
+#include "StandIn/CApiStatistics.h"
+
+CStandInServerDriverHost::CStandInServerDriverHost(CApiStatistics *f_statistics)
+{
+    m_devices.push_back(nullptr);
+    m_serials.push_back("hmd");
+    m_classes.push_back(vr::TrackedDeviceClass_HMD);
+    m_poses.push_back(vr::DriverPose_t());
+    std::memset(&m_poses.back(), 0, sizeof(vr::DriverPose_t));
+
+    // Identity HMD at standing height
+    std::memset(&m_hmdPose, 0, sizeof(vr::TrackedDevicePose_t));
+    for(size_t i = 0U; i < 3U; i++) m_hmdPose.mDeviceToAbsoluteTracking.m[i][i] = 1.f;
+    m_hmdPose.mDeviceToAbsoluteTracking.m[1U][3U] = 1.7f;
+    m_hmdPose.eTrackingResult = vr::TrackingResult_Running_OK;
+    m_hmdPose.bPoseIsValid = true;
+    m_hmdPose.bDeviceIsConnected = true;
+
+    m_output = nullptr;
+    m_statistics = f_statistics;
+}
+
+CStandInServerDriverHost::~CStandInServerDriverHost()
+{
+}
+
+void CStandInServerDriverHost::SetOutput(std::ostream *f_output)
+{
+    m_output = f_output;
+}
+
+void CStandInServerDriverHost::SetHmdPose(const vr::HmdMatrix34_t &f_matrix)
+{
+    m_hmdPose.mDeviceToAbsoluteTracking = f_matrix;
+}
+
+uint32_t CStandInServerDriverHost::FindDevice(vr::ETrackedDeviceClass f_class) const
+{
+    uint32_t l_result = vr::k_unTrackedDeviceIndexInvalid;
+    for(size_t i = 1U; i < m_devices.size(); i++)
+    {
+        if(m_classes[i] == f_class)
+        {
+            l_result = static_cast<uint32_t>(i);
+            break;
+        }
+    }
+    return l_result;
+}
+
+vr::ITrackedDeviceServerDriver* CStandInServerDriverHost::GetDevice(uint32_t f_index) const
+{
+    return ((f_index < m_devices.size()) ? m_devices[f_index] : nullptr);
+}
+
+uint32_t CStandInServerDriverHost::GetDevicesCount() const
+{
+    return static_cast<uint32_t>(m_devices.size());
+}
+
+const vr::DriverPose_t* CStandInServerDriverHost::GetDevicePose(uint32_t f_index) const
+{
+    return ((f_index < m_poses.size()) ? &m_poses[f_index] : nullptr);
+}
+
+void CStandInServerDriverHost::DeactivateDevices()
+{
+    for(size_t i = 1U; i < m_devices.size(); i++)
+    {
+        if(m_devices[i]) m_devices[i]->Deactivate();
+    }
+    m_devices.resize(1U);
+    m_serials.resize(1U);
+    m_classes.resize(1U);
+    m_poses.resize(1U);
+}
+
+bool CStandInServerDriverHost::TrackedDeviceAdded(const char *pchDeviceSerialNumber, vr::ETrackedDeviceClass eDeviceClass, vr::ITrackedDeviceServerDriver *pDriver)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_TrackedDeviceAdded, CApiStatistics::GetStringSize(pchDeviceSerialNumber) + sizeof(vr::ETrackedDeviceClass));
+    bool l_result = false;
+    if(pDriver && (m_devices.size() < vr::k_unMaxTrackedDeviceCount))
+    {
+        const uint32_t l_index = static_cast<uint32_t>(m_devices.size());
+        m_devices.push_back(pDriver);
+        m_serials.push_back(pchDeviceSerialNumber);
+        m_classes.push_back(eDeviceClass);
+        m_poses.push_back(vr::DriverPose_t());
+        std::memset(&m_poses.back(), 0, sizeof(vr::DriverPose_t));
+        pDriver->Activate(l_index);
+        if(m_output) *m_output << "device " << l_index << ' ' << pchDeviceSerialNumber << ' ' << static_cast<int>(eDeviceClass) << '\n';
+        l_result = true;
+    }
+    return l_result;
+}
+
+void CStandInServerDriverHost::TrackedDevicePoseUpdated(uint32_t unWhichDevice, const vr::DriverPose_t &newPose, uint32_t unPoseStructSize)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_TrackedDevicePoseUpdated, unPoseStructSize);
+    if(unWhichDevice < m_poses.size()) m_poses[unWhichDevice] = newPose;
+    if(m_output)
+    {
+        std::ostream &l_output = *m_output;
+        l_output << "pose " << unWhichDevice << ' ' << newPose.poseIsValid << ' ' << static_cast<int>(newPose.result);
+        l_output << ' ' << newPose.vecPosition[0U] << ' ' << newPose.vecPosition[1U] << ' ' << newPose.vecPosition[2U];
+        l_output << ' ' << newPose.qRotation.w << ' ' << newPose.qRotation.x << ' ' << newPose.qRotation.y << ' ' << newPose.qRotation.z;
+        l_output << ' ' << newPose.vecVelocity[0U] << ' ' << newPose.vecVelocity[1U] << ' ' << newPose.vecVelocity[2U] << '\n';
+    }
+}
+
+void CStandInServerDriverHost::VsyncEvent(double /* vsyncTimeOffsetSeconds */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_VsyncEvent, sizeof(double));
+}
+
+void CStandInServerDriverHost::VendorSpecificEvent(uint32_t /* unWhichDevice */, vr::EVREventType /* eventType */, const vr::VREvent_Data_t& /* eventData */, double /* eventTimeOffset */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_VendorSpecificEvent, sizeof(vr::EVREventType) + sizeof(vr::VREvent_Data_t) + sizeof(double));
+}
+
+bool CStandInServerDriverHost::IsExiting()
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_IsExiting, 0U);
+    return false;
+}
+
+bool CStandInServerDriverHost::PollNextEvent(vr::VREvent_t* /* pEvent */, uint32_t uncbVREvent)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_PollNextEvent, uncbVREvent);
+    return false;
+}
+
+void CStandInServerDriverHost::GetRawTrackedDevicePoses(float /* fPredictedSecondsFromNow */, vr::TrackedDevicePose_t *pTrackedDevicePoseArray, uint32_t unTrackedDevicePoseArrayCount)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_GetRawTrackedDevicePoses, sizeof(float) + unTrackedDevicePoseArrayCount * sizeof(vr::TrackedDevicePose_t));
+    for(uint32_t i = 0U; i < unTrackedDevicePoseArrayCount; i++)
+    {
+        if(i == vr::k_unTrackedDeviceIndex_Hmd) pTrackedDevicePoseArray[i] = m_hmdPose;
+        else std::memset(&pTrackedDevicePoseArray[i], 0, sizeof(vr::TrackedDevicePose_t));
+    }
+}
+
+void CStandInServerDriverHost::TrackedDeviceDisplayTransformUpdated(uint32_t /* unWhichDevice */, vr::HmdMatrix34_t /* eyeToHeadLeft */, vr::HmdMatrix34_t /* eyeToHeadRight */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_TrackedDeviceDisplayTransformUpdated, 2U * sizeof(vr::HmdMatrix34_t));
+}
+
+void CStandInServerDriverHost::RequestRestart(const char *pchLocalizedReason, const char *pchExecutableToStart, const char *pchArguments, const char *pchWorkingDirectory)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_RequestRestart, CApiStatistics::GetStringSize(pchLocalizedReason) + CApiStatistics::GetStringSize(pchExecutableToStart) + CApiStatistics::GetStringSize(pchArguments) + CApiStatistics::GetStringSize(pchWorkingDirectory));
+}
+
+uint32_t CStandInServerDriverHost::GetFrameTimings(vr::Compositor_FrameTiming* /* pTiming */, uint32_t nFrames)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_GetFrameTimings, nFrames * sizeof(vr::Compositor_FrameTiming));
+    return 0U;
+}
+
+void CStandInServerDriverHost::SetDisplayEyeToHead(uint32_t /* unWhichDevice */, const vr::HmdMatrix34_t& /* eyeToHeadLeft */, const vr::HmdMatrix34_t& /* eyeToHeadRight */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_SetDisplayEyeToHead, 2U * sizeof(vr::HmdMatrix34_t));
+}
+
+void CStandInServerDriverHost::SetDisplayProjectionRaw(uint32_t /* unWhichDevice */, const vr::HmdRect2_t& /* eyeLeft */, const vr::HmdRect2_t& /* eyeRight */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_SetDisplayProjectionRaw, 2U * sizeof(vr::HmdRect2_t));
+}
+
+void CStandInServerDriverHost::SetRecommendedRenderTargetSize(uint32_t /* unWhichDevice */, uint32_t /* nWidth */, uint32_t /* nHeight */)
+{
+    CApiCallTimer l_timer(m_statistics, CApiStatistics::AC_SetRecommendedRenderTargetSize, 2U * sizeof(uint32_t));
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+class CApiStatistics;
+
+// Device host of stand-in server, devices are activated on addition and index 0 is reserved for HMD
+class CStandInServerDriverHost final : public vr::IVRServerDriverHost
+{
+    std::vector<vr::ITrackedDeviceServerDriver*> m_devices;
+    std::vector<std::string> m_serials;
+    std::vector<vr::ETrackedDeviceClass> m_classes;
+    std::vector<vr::DriverPose_t> m_poses; // Last pose of each device
+    vr::TrackedDevicePose_t m_hmdPose;
+    std::ostream *m_output;
+    CApiStatistics *m_statistics;
+
+    CStandInServerDriverHost(const CStandInServerDriverHost &that) = delete;
+    CStandInServerDriverHost& operator=(const CStandInServerDriverHost &that) = delete;
+public:
+    explicit CStandInServerDriverHost(CApiStatistics *f_statistics);
+    ~CStandInServerDriverHost();
+
+    void SetOutput(std::ostream *f_output);
+    void SetHmdPose(const vr::HmdMatrix34_t &f_matrix);
+
+    // Index of first added device of class or invalid index
+    uint32_t FindDevice(vr::ETrackedDeviceClass f_class) const;
+    vr::ITrackedDeviceServerDriver* GetDevice(uint32_t f_index) const;
+    // Index of next added device
+    uint32_t GetDevicesCount() const;
+    // Last pose of device updated by driver, nullptr for invalid index
+    const vr::DriverPose_t* GetDevicePose(uint32_t f_index) const;
+    void DeactivateDevices();
+
+    // vr::IVRServerDriverHost
+    bool TrackedDeviceAdded(const char *pchDeviceSerialNumber, vr::ETrackedDeviceClass eDeviceClass, vr::ITrackedDeviceServerDriver *pDriver);
+    void TrackedDevicePoseUpdated(uint32_t unWhichDevice, const vr::DriverPose_t &newPose, uint32_t unPoseStructSize);
+    void VsyncEvent(double vsyncTimeOffsetSeconds);
+    void VendorSpecificEvent(uint32_t unWhichDevice, vr::EVREventType eventType, const vr::VREvent_Data_t &eventData, double eventTimeOffset);
+    bool IsExiting();
+    bool PollNextEvent(vr::VREvent_t *pEvent, uint32_t uncbVREvent);
+    void GetRawTrackedDevicePoses(float fPredictedSecondsFromNow, vr::TrackedDevicePose_t *pTrackedDevicePoseArray, uint32_t unTrackedDevicePoseArrayCount);
+    // Methods below exist only in some interface revisions
+    void TrackedDeviceDisplayTransformUpdated(uint32_t unWhichDevice, vr::HmdMatrix34_t eyeToHeadLeft, vr::HmdMatrix34_t eyeToHeadRight);
+    void RequestRestart(const char *pchLocalizedReason, const char *pchExecutableToStart, const char *pchArguments, const char *pchWorkingDirectory);
+    uint32_t GetFrameTimings(vr::Compositor_FrameTiming *pTiming, uint32_t nFrames);
+    void SetDisplayEyeToHead(uint32_t unWhichDevice, const vr::HmdMatrix34_t &eyeToHeadLeft, const vr::HmdMatrix34_t &eyeToHeadRight);
+    void SetDisplayProjectionRaw(uint32_t unWhichDevice, const vr::HmdRect2_t &eyeLeft, const vr::HmdRect2_t &eyeRight);
+    void SetRecommendedRenderTargetSize(uint32_t unWhichDevice, uint32_t nWidth, uint32_t nHeight);
+};
@@ -0,0 +1,26 @@
+#include "stdafx.h"
+
+#include "CDriverBenchmark.h"
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: leap_benchmark <synthetic|recording> [90|120|144|0] [frames] [latency_ns]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const uint32_t l_rate = (argc > 2) ? static_cast<uint32_t>(std::max(std::atoi(argv[2]), 0)) : 90U;
+    const uint64_t l_frames = (argc > 3) ? static_cast<uint64_t>(std::max(std::atoll(argv[3]), 1LL)) : 10000U;
+    const int64_t l_latency = (argc > 4) ? std::max(std::atoll(argv[4]), 0LL) : 0;
+
+    int l_result = EXIT_FAILURE;
+    CDriverBenchmark *l_benchmark = new CDriverBenchmark();
+    if(l_benchmark->Run(argv[1], l_rate, l_frames, l_latency))
+    {
+        l_benchmark->WriteSummary(std::cout);
+        l_result = EXIT_SUCCESS;
+    }
+    delete l_benchmark;
+    return l_result;
+}
@@ -0,0 +1,52 @@
+#include "stdafx.h"
+
+#include "CKernelBenchmark.h"
+
+// Allocations of whole process, benchmark runs single thread
+uint64_t g_allocationsCount = 0U;
+
+void* operator new(size_t f_size)
+{
+    g_allocationsCount++;
+    void *l_result = std::malloc((f_size > 0U) ? f_size : 1U);
+    if(!l_result) throw std::bad_alloc();
+    return l_result;
+}
+
+void operator delete(void *f_pointer) noexcept
+{
+    std::free(f_pointer);
+}
+
+void operator delete(void *f_pointer, size_t /* f_size */) noexcept
+{
+    std::free(f_pointer);
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string l_source((argc > 1) ? argv[1] : "synthetic");
+    const uint64_t l_iterations = (argc > 2) ? static_cast<uint64_t>(std::max(std::atoll(argv[2]), 1LL)) : 200000U;
+
+    std::ofstream l_output;
+    if(argc > 3)
+    {
+        l_output.open(argv[3]);
+        if(!l_output.is_open())
+        {
+            std::cerr << "Unable to open " << argv[3] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    int l_result = EXIT_FAILURE;
+    CKernelBenchmark *l_benchmark = new CKernelBenchmark();
+    if(l_benchmark->Run(l_source, l_iterations))
+    {
+        l_benchmark->WriteJson(l_output.is_open() ? l_output : std::cout);
+        l_result = EXIT_SUCCESS;
+    }
+    else std::cerr << "Usage: leap_kernels [synthetic|recording] [iterations] [output]" << std::endl;
+    delete l_benchmark;
+    return l_result;
+}
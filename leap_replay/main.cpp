@@ -0,0 +1,132 @@
+#include "stdafx.h"
+
+#include "CLeapReplay.h"
+#include "CCodecBenchmark.h"
+#include "CColumnExporter.h"
+#include "CIndexCheck.h"
+#include "CPredictionBenchmark.h"
+#include "CSegmentBenchmark.h"
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: leap_replay <recording> [realtime|fast|step] [output]" << std::endl;
+        std::cerr << "       leap_replay <recording> codec [compressed_output]" << std::endl;
+        std::cerr << "       leap_replay <recording> segments [count]" << std::endl;
+        std::cerr << "       leap_replay <recording> export <output> [chunk_rows]" << std::endl;
+        std::cerr << "       leap_replay <recording|synthetic> predict [horizon_ms...]" << std::endl;
+        std::cerr << "       leap_replay <recording> index_check" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if((argc > 2) && !strcmp(argv[2], "codec"))
+    {
+        int l_result = EXIT_FAILURE;
+        CCodecBenchmark *l_benchmark = new CCodecBenchmark();
+        if(l_benchmark->Run(argv[1], (argc > 3) ? argv[3] : ""))
+        {
+            l_benchmark->WriteSummary(std::cout);
+            l_result = EXIT_SUCCESS;
+        }
+        else std::cerr << "Unable to process " << argv[1] << std::endl;
+        delete l_benchmark;
+        return l_result;
+    }
+
+    if((argc > 2) && !strcmp(argv[2], "segments"))
+    {
+        int l_result = EXIT_FAILURE;
+        const size_t l_count = (argc > 3) ? static_cast<size_t>(std::max(std::atoi(argv[3]), 1)) : std::max(std::thread::hardware_concurrency(), 1U);
+        CSegmentBenchmark *l_benchmark = new CSegmentBenchmark();
+        if(l_benchmark->Run(argv[1], l_count))
+        {
+            l_benchmark->WriteSummary(std::cout);
+            l_result = EXIT_SUCCESS;
+        }
+        else std::cerr << "Unable to open " << argv[1] << std::endl;
+        delete l_benchmark;
+        return l_result;
+    }
+
+    if((argc > 3) && !strcmp(argv[2], "export"))
+    {
+        int l_result = EXIT_FAILURE;
+        const uint32_t l_chunkRows = (argc > 4) ? static_cast<uint32_t>(std::max(std::atoi(argv[4]), 1)) : 65536U;
+        CColumnExporter *l_exporter = new CColumnExporter();
+        if(l_exporter->Run(argv[1], argv[3], l_chunkRows))
+        {
+            l_exporter->WriteSummary(std::cout);
+            l_result = EXIT_SUCCESS;
+        }
+        delete l_exporter;
+        return l_result;
+    }
+
+    if((argc > 2) && !strcmp(argv[2], "index_check"))
+    {
+        int l_result = EXIT_FAILURE;
+        CIndexCheck *l_check = new CIndexCheck();
+        if(l_check->Run(argv[1]))
+        {
+            l_check->WriteSummary(std::cout);
+            if(l_check->IsPassed()) l_result = EXIT_SUCCESS;
+        }
+        delete l_check;
+        return l_result;
+    }
+
+    if((argc > 2) && !strcmp(argv[2], "predict"))
+    {
+        int l_result = EXIT_FAILURE;
+        std::vector<int64_t> l_horizons;
+        for(int i = 3; i < argc; i++) l_horizons.push_back(static_cast<int64_t>(std::max(std::atoi(argv[i]), 0)) * 1000);
+        if(l_horizons.empty()) l_horizons = { 10000, 20000, 30000 };
+        CPredictionBenchmark *l_benchmark = new CPredictionBenchmark();
+        if(l_benchmark->Run(argv[1], l_horizons))
+        {
+            l_benchmark->WriteSummary(std::cout);
+            l_result = EXIT_SUCCESS;
+        }
+        delete l_benchmark;
+        return l_result;
+    }
+
+    unsigned char l_mode = CLeapReplay::RM_Fast;
+    if(argc > 2)
+    {
+        const std::string l_modeName(argv[2]);
+        if(l_modeName == "realtime") l_mode = CLeapReplay::RM_Realtime;
+        else if(l_modeName == "fast") l_mode = CLeapReplay::RM_Fast;
+        else if(l_modeName == "step") l_mode = CLeapReplay::RM_Step;
+        else
+        {
+            std::cerr << "Unknown mode " << l_modeName << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ofstream l_output;
+    if(argc > 3)
+    {
+        l_output.open(argv[3]);
+        if(!l_output.is_open())
+        {
+            std::cerr << "Unable to open " << argv[3] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    int l_result = EXIT_FAILURE;
+    CLeapReplay *l_replay = new CLeapReplay();
+    if(l_replay->Initialize(argv[1], l_mode, l_output.is_open() ? &l_output : nullptr))
+    {
+        while(l_replay->DoPulse());
+        l_replay->Terminate();
+        l_replay->WriteSummary(std::cout);
+        l_result = EXIT_SUCCESS;
+    }
+    delete l_replay;
+
+    return l_result;
+}
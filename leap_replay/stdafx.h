@@ -0,0 +1,43 @@
+#pragma once
+
+// Shared by driver sources built into replay host
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <chrono>
+#include <numeric>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <cstring>
+#include <cstdio>
+#include <iterator>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+
+#include "openvr_driver.h"
+#include "LeapC.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include "glm/gtx/norm.hpp"
+#include "glm/gtx/intersect.hpp"
+
+#include "pugixml.hpp"